@@ -0,0 +1,47 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/type/src/DataStream.cpp" "type/CMakeFiles/WorkflowType.dir/src/DataStream.cpp.o" "gcc" "type/CMakeFiles/WorkflowType.dir/src/DataStream.cpp.o.d"
+  "/root/repo/type/src/DataTypeView.cpp" "type/CMakeFiles/WorkflowType.dir/src/DataTypeView.cpp.o" "gcc" "type/CMakeFiles/WorkflowType.dir/src/DataTypeView.cpp.o.d"
+  "/root/repo/type/src/DecodeError.cpp" "type/CMakeFiles/WorkflowType.dir/src/DecodeError.cpp.o" "gcc" "type/CMakeFiles/WorkflowType.dir/src/DecodeError.cpp.o.d"
+  "/root/repo/type/src/IDataStream.cpp" "type/CMakeFiles/WorkflowType.dir/src/IDataStream.cpp.o" "gcc" "type/CMakeFiles/WorkflowType.dir/src/IDataStream.cpp.o.d"
+  "/root/repo/type/src/IDataType.cpp" "type/CMakeFiles/WorkflowType.dir/src/IDataType.cpp.o" "gcc" "type/CMakeFiles/WorkflowType.dir/src/IDataType.cpp.o.d"
+  "/root/repo/type/src/IDataTypeVisitor.cpp" "type/CMakeFiles/WorkflowType.dir/src/IDataTypeVisitor.cpp.o" "gcc" "type/CMakeFiles/WorkflowType.dir/src/IDataTypeVisitor.cpp.o.d"
+  "/root/repo/type/src/IVariantMethods.cpp" "type/CMakeFiles/WorkflowType.dir/src/IVariantMethods.cpp.o" "gcc" "type/CMakeFiles/WorkflowType.dir/src/IVariantMethods.cpp.o.d"
+  "/root/repo/type/src/JsonReader.cpp" "type/CMakeFiles/WorkflowType.dir/src/JsonReader.cpp.o" "gcc" "type/CMakeFiles/WorkflowType.dir/src/JsonReader.cpp.o.d"
+  "/root/repo/type/src/JsonScan.cpp" "type/CMakeFiles/WorkflowType.dir/src/JsonScan.cpp.o" "gcc" "type/CMakeFiles/WorkflowType.dir/src/JsonScan.cpp.o.d"
+  "/root/repo/type/src/JsonWriter.cpp" "type/CMakeFiles/WorkflowType.dir/src/JsonWriter.cpp.o" "gcc" "type/CMakeFiles/WorkflowType.dir/src/JsonWriter.cpp.o.d"
+  "/root/repo/type/src/ParallelDecoder.cpp" "type/CMakeFiles/WorkflowType.dir/src/ParallelDecoder.cpp.o" "gcc" "type/CMakeFiles/WorkflowType.dir/src/ParallelDecoder.cpp.o.d"
+  "/root/repo/type/src/ParallelEncoder.cpp" "type/CMakeFiles/WorkflowType.dir/src/ParallelEncoder.cpp.o" "gcc" "type/CMakeFiles/WorkflowType.dir/src/ParallelEncoder.cpp.o.d"
+  "/root/repo/type/src/ParallelFor.cpp" "type/CMakeFiles/WorkflowType.dir/src/ParallelFor.cpp.o" "gcc" "type/CMakeFiles/WorkflowType.dir/src/ParallelFor.cpp.o.d"
+  "/root/repo/type/src/Patch.cpp" "type/CMakeFiles/WorkflowType.dir/src/Patch.cpp.o" "gcc" "type/CMakeFiles/WorkflowType.dir/src/Patch.cpp.o.d"
+  "/root/repo/type/src/PersistentStruct.cpp" "type/CMakeFiles/WorkflowType.dir/src/PersistentStruct.cpp.o" "gcc" "type/CMakeFiles/WorkflowType.dir/src/PersistentStruct.cpp.o.d"
+  "/root/repo/type/src/Projection.cpp" "type/CMakeFiles/WorkflowType.dir/src/Projection.cpp.o" "gcc" "type/CMakeFiles/WorkflowType.dir/src/Projection.cpp.o.d"
+  "/root/repo/type/src/SchemaDictionary.cpp" "type/CMakeFiles/WorkflowType.dir/src/SchemaDictionary.cpp.o" "gcc" "type/CMakeFiles/WorkflowType.dir/src/SchemaDictionary.cpp.o.d"
+  "/root/repo/type/src/Skip.cpp" "type/CMakeFiles/WorkflowType.dir/src/Skip.cpp.o" "gcc" "type/CMakeFiles/WorkflowType.dir/src/Skip.cpp.o.d"
+  "/root/repo/type/src/StructDataType.cpp" "type/CMakeFiles/WorkflowType.dir/src/StructDataType.cpp.o" "gcc" "type/CMakeFiles/WorkflowType.dir/src/StructDataType.cpp.o.d"
+  "/root/repo/type/src/StructPlan.cpp" "type/CMakeFiles/WorkflowType.dir/src/StructPlan.cpp.o" "gcc" "type/CMakeFiles/WorkflowType.dir/src/StructPlan.cpp.o.d"
+  "/root/repo/type/src/StructSchema.cpp" "type/CMakeFiles/WorkflowType.dir/src/StructSchema.cpp.o" "gcc" "type/CMakeFiles/WorkflowType.dir/src/StructSchema.cpp.o.d"
+  "/root/repo/type/src/TextFormatter.cpp" "type/CMakeFiles/WorkflowType.dir/src/TextFormatter.cpp.o" "gcc" "type/CMakeFiles/WorkflowType.dir/src/TextFormatter.cpp.o.d"
+  "/root/repo/type/src/TreeEngine.cpp" "type/CMakeFiles/WorkflowType.dir/src/TreeEngine.cpp.o" "gcc" "type/CMakeFiles/WorkflowType.dir/src/TreeEngine.cpp.o.d"
+  "/root/repo/type/src/Variant.cpp" "type/CMakeFiles/WorkflowType.dir/src/Variant.cpp.o" "gcc" "type/CMakeFiles/WorkflowType.dir/src/Variant.cpp.o.d"
+  "/root/repo/type/src/VariantDataType.cpp" "type/CMakeFiles/WorkflowType.dir/src/VariantDataType.cpp.o" "gcc" "type/CMakeFiles/WorkflowType.dir/src/VariantDataType.cpp.o.d"
+  "/root/repo/type/src/VariantMethodsManager.cpp" "type/CMakeFiles/WorkflowType.dir/src/VariantMethodsManager.cpp.o" "gcc" "type/CMakeFiles/WorkflowType.dir/src/VariantMethodsManager.cpp.o.d"
+  "/root/repo/type/src/VectorDataType.cpp" "type/CMakeFiles/WorkflowType.dir/src/VectorDataType.cpp.o" "gcc" "type/CMakeFiles/WorkflowType.dir/src/VectorDataType.cpp.o.d"
+  "/root/repo/type/src/VectorMath.cpp" "type/CMakeFiles/WorkflowType.dir/src/VectorMath.cpp.o" "gcc" "type/CMakeFiles/WorkflowType.dir/src/VectorMath.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_asan_build/utils/CMakeFiles/WorkflowUtils.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
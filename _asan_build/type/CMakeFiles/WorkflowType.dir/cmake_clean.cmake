@@ -0,0 +1,65 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/WorkflowType.dir/src/DataStream.cpp.o"
+  "CMakeFiles/WorkflowType.dir/src/DataStream.cpp.o.d"
+  "CMakeFiles/WorkflowType.dir/src/DataTypeView.cpp.o"
+  "CMakeFiles/WorkflowType.dir/src/DataTypeView.cpp.o.d"
+  "CMakeFiles/WorkflowType.dir/src/DecodeError.cpp.o"
+  "CMakeFiles/WorkflowType.dir/src/DecodeError.cpp.o.d"
+  "CMakeFiles/WorkflowType.dir/src/IDataStream.cpp.o"
+  "CMakeFiles/WorkflowType.dir/src/IDataStream.cpp.o.d"
+  "CMakeFiles/WorkflowType.dir/src/IDataType.cpp.o"
+  "CMakeFiles/WorkflowType.dir/src/IDataType.cpp.o.d"
+  "CMakeFiles/WorkflowType.dir/src/IDataTypeVisitor.cpp.o"
+  "CMakeFiles/WorkflowType.dir/src/IDataTypeVisitor.cpp.o.d"
+  "CMakeFiles/WorkflowType.dir/src/IVariantMethods.cpp.o"
+  "CMakeFiles/WorkflowType.dir/src/IVariantMethods.cpp.o.d"
+  "CMakeFiles/WorkflowType.dir/src/JsonReader.cpp.o"
+  "CMakeFiles/WorkflowType.dir/src/JsonReader.cpp.o.d"
+  "CMakeFiles/WorkflowType.dir/src/JsonScan.cpp.o"
+  "CMakeFiles/WorkflowType.dir/src/JsonScan.cpp.o.d"
+  "CMakeFiles/WorkflowType.dir/src/JsonWriter.cpp.o"
+  "CMakeFiles/WorkflowType.dir/src/JsonWriter.cpp.o.d"
+  "CMakeFiles/WorkflowType.dir/src/ParallelDecoder.cpp.o"
+  "CMakeFiles/WorkflowType.dir/src/ParallelDecoder.cpp.o.d"
+  "CMakeFiles/WorkflowType.dir/src/ParallelEncoder.cpp.o"
+  "CMakeFiles/WorkflowType.dir/src/ParallelEncoder.cpp.o.d"
+  "CMakeFiles/WorkflowType.dir/src/ParallelFor.cpp.o"
+  "CMakeFiles/WorkflowType.dir/src/ParallelFor.cpp.o.d"
+  "CMakeFiles/WorkflowType.dir/src/Patch.cpp.o"
+  "CMakeFiles/WorkflowType.dir/src/Patch.cpp.o.d"
+  "CMakeFiles/WorkflowType.dir/src/PersistentStruct.cpp.o"
+  "CMakeFiles/WorkflowType.dir/src/PersistentStruct.cpp.o.d"
+  "CMakeFiles/WorkflowType.dir/src/Projection.cpp.o"
+  "CMakeFiles/WorkflowType.dir/src/Projection.cpp.o.d"
+  "CMakeFiles/WorkflowType.dir/src/SchemaDictionary.cpp.o"
+  "CMakeFiles/WorkflowType.dir/src/SchemaDictionary.cpp.o.d"
+  "CMakeFiles/WorkflowType.dir/src/Skip.cpp.o"
+  "CMakeFiles/WorkflowType.dir/src/Skip.cpp.o.d"
+  "CMakeFiles/WorkflowType.dir/src/StructDataType.cpp.o"
+  "CMakeFiles/WorkflowType.dir/src/StructDataType.cpp.o.d"
+  "CMakeFiles/WorkflowType.dir/src/StructPlan.cpp.o"
+  "CMakeFiles/WorkflowType.dir/src/StructPlan.cpp.o.d"
+  "CMakeFiles/WorkflowType.dir/src/StructSchema.cpp.o"
+  "CMakeFiles/WorkflowType.dir/src/StructSchema.cpp.o.d"
+  "CMakeFiles/WorkflowType.dir/src/TextFormatter.cpp.o"
+  "CMakeFiles/WorkflowType.dir/src/TextFormatter.cpp.o.d"
+  "CMakeFiles/WorkflowType.dir/src/TreeEngine.cpp.o"
+  "CMakeFiles/WorkflowType.dir/src/TreeEngine.cpp.o.d"
+  "CMakeFiles/WorkflowType.dir/src/Variant.cpp.o"
+  "CMakeFiles/WorkflowType.dir/src/Variant.cpp.o.d"
+  "CMakeFiles/WorkflowType.dir/src/VariantDataType.cpp.o"
+  "CMakeFiles/WorkflowType.dir/src/VariantDataType.cpp.o.d"
+  "CMakeFiles/WorkflowType.dir/src/VariantMethodsManager.cpp.o"
+  "CMakeFiles/WorkflowType.dir/src/VariantMethodsManager.cpp.o.d"
+  "CMakeFiles/WorkflowType.dir/src/VectorDataType.cpp.o"
+  "CMakeFiles/WorkflowType.dir/src/VectorDataType.cpp.o.d"
+  "CMakeFiles/WorkflowType.dir/src/VectorMath.cpp.o"
+  "CMakeFiles/WorkflowType.dir/src/VectorMath.cpp.o.d"
+  "libWorkflowType.pdb"
+  "libWorkflowType.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/WorkflowType.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
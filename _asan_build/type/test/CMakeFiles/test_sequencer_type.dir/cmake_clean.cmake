@@ -0,0 +1,45 @@
+file(REMOVE_RECURSE
+  "../../build/bin/test_sequencer_type"
+  "../../build/bin/test_sequencer_type.pdb"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_DataTypeView.cpp.o"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_DataTypeView.cpp.o.d"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_Demangle.cpp.o"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_Demangle.cpp.o.d"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_Error.cpp.o"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_Error.cpp.o.d"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_JsonReader.cpp.o"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_JsonReader.cpp.o.d"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_JsonWriter.cpp.o"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_JsonWriter.cpp.o.d"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_ParallelDecoder.cpp.o"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_ParallelDecoder.cpp.o.d"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_ParallelEncoder.cpp.o"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_ParallelEncoder.cpp.o.d"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_Patch.cpp.o"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_Patch.cpp.o.d"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_PersistentStruct.cpp.o"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_PersistentStruct.cpp.o.d"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_StructDataType.cpp.o"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_StructDataType.cpp.o.d"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_TextFormatter.cpp.o"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_TextFormatter.cpp.o.d"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_TreeEngine.cpp.o"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_TreeEngine.cpp.o.d"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_Variant.cpp.o"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_Variant.cpp.o.d"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_VariantDataType.cpp.o"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_VariantDataType.cpp.o.d"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_VariantMethodsManager.cpp.o"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_VariantMethodsManager.cpp.o.d"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_VectorDataType.cpp.o"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_VectorDataType.cpp.o.d"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_VectorMath.cpp.o"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_VectorMath.cpp.o.d"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_Visit.cpp.o"
+  "CMakeFiles/test_sequencer_type.dir/test_sequencer_type_Visit.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_sequencer_type.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
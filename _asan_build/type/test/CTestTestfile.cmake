@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/type/test
+# Build directory: /root/repo/_asan_build/type/test
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(test_sequencer_type "/root/repo/_asan_build/build/bin/test_sequencer_type")
+set_tests_properties(test_sequencer_type PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/type/test/CMakeLists.txt;28;add_test;/root/repo/type/test/CMakeLists.txt;0;")
@@ -0,0 +1,19 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/WorkflowUtils.dir/src/Demangle.cpp.o"
+  "CMakeFiles/WorkflowUtils.dir/src/Demangle.cpp.o.d"
+  "CMakeFiles/WorkflowUtils.dir/src/Error.cpp.o"
+  "CMakeFiles/WorkflowUtils.dir/src/Error.cpp.o.d"
+  "CMakeFiles/WorkflowUtils.dir/src/ErrorCode.cpp.o"
+  "CMakeFiles/WorkflowUtils.dir/src/ErrorCode.cpp.o.d"
+  "CMakeFiles/WorkflowUtils.dir/src/Hash.cpp.o"
+  "CMakeFiles/WorkflowUtils.dir/src/Hash.cpp.o.d"
+  "CMakeFiles/WorkflowUtils.dir/src/InternedString.cpp.o"
+  "CMakeFiles/WorkflowUtils.dir/src/InternedString.cpp.o.d"
+  "libWorkflowUtils.pdb"
+  "libWorkflowUtils.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/WorkflowUtils.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
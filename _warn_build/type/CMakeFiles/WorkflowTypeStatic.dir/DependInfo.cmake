@@ -0,0 +1,47 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/type/src/DataStream.cpp" "type/CMakeFiles/WorkflowTypeStatic.dir/src/DataStream.cpp.o" "gcc" "type/CMakeFiles/WorkflowTypeStatic.dir/src/DataStream.cpp.o.d"
+  "/root/repo/type/src/DataTypeView.cpp" "type/CMakeFiles/WorkflowTypeStatic.dir/src/DataTypeView.cpp.o" "gcc" "type/CMakeFiles/WorkflowTypeStatic.dir/src/DataTypeView.cpp.o.d"
+  "/root/repo/type/src/DecodeError.cpp" "type/CMakeFiles/WorkflowTypeStatic.dir/src/DecodeError.cpp.o" "gcc" "type/CMakeFiles/WorkflowTypeStatic.dir/src/DecodeError.cpp.o.d"
+  "/root/repo/type/src/IDataStream.cpp" "type/CMakeFiles/WorkflowTypeStatic.dir/src/IDataStream.cpp.o" "gcc" "type/CMakeFiles/WorkflowTypeStatic.dir/src/IDataStream.cpp.o.d"
+  "/root/repo/type/src/IDataType.cpp" "type/CMakeFiles/WorkflowTypeStatic.dir/src/IDataType.cpp.o" "gcc" "type/CMakeFiles/WorkflowTypeStatic.dir/src/IDataType.cpp.o.d"
+  "/root/repo/type/src/IDataTypeVisitor.cpp" "type/CMakeFiles/WorkflowTypeStatic.dir/src/IDataTypeVisitor.cpp.o" "gcc" "type/CMakeFiles/WorkflowTypeStatic.dir/src/IDataTypeVisitor.cpp.o.d"
+  "/root/repo/type/src/IVariantMethods.cpp" "type/CMakeFiles/WorkflowTypeStatic.dir/src/IVariantMethods.cpp.o" "gcc" "type/CMakeFiles/WorkflowTypeStatic.dir/src/IVariantMethods.cpp.o.d"
+  "/root/repo/type/src/JsonReader.cpp" "type/CMakeFiles/WorkflowTypeStatic.dir/src/JsonReader.cpp.o" "gcc" "type/CMakeFiles/WorkflowTypeStatic.dir/src/JsonReader.cpp.o.d"
+  "/root/repo/type/src/JsonScan.cpp" "type/CMakeFiles/WorkflowTypeStatic.dir/src/JsonScan.cpp.o" "gcc" "type/CMakeFiles/WorkflowTypeStatic.dir/src/JsonScan.cpp.o.d"
+  "/root/repo/type/src/JsonWriter.cpp" "type/CMakeFiles/WorkflowTypeStatic.dir/src/JsonWriter.cpp.o" "gcc" "type/CMakeFiles/WorkflowTypeStatic.dir/src/JsonWriter.cpp.o.d"
+  "/root/repo/type/src/ParallelDecoder.cpp" "type/CMakeFiles/WorkflowTypeStatic.dir/src/ParallelDecoder.cpp.o" "gcc" "type/CMakeFiles/WorkflowTypeStatic.dir/src/ParallelDecoder.cpp.o.d"
+  "/root/repo/type/src/ParallelEncoder.cpp" "type/CMakeFiles/WorkflowTypeStatic.dir/src/ParallelEncoder.cpp.o" "gcc" "type/CMakeFiles/WorkflowTypeStatic.dir/src/ParallelEncoder.cpp.o.d"
+  "/root/repo/type/src/ParallelFor.cpp" "type/CMakeFiles/WorkflowTypeStatic.dir/src/ParallelFor.cpp.o" "gcc" "type/CMakeFiles/WorkflowTypeStatic.dir/src/ParallelFor.cpp.o.d"
+  "/root/repo/type/src/Patch.cpp" "type/CMakeFiles/WorkflowTypeStatic.dir/src/Patch.cpp.o" "gcc" "type/CMakeFiles/WorkflowTypeStatic.dir/src/Patch.cpp.o.d"
+  "/root/repo/type/src/PersistentStruct.cpp" "type/CMakeFiles/WorkflowTypeStatic.dir/src/PersistentStruct.cpp.o" "gcc" "type/CMakeFiles/WorkflowTypeStatic.dir/src/PersistentStruct.cpp.o.d"
+  "/root/repo/type/src/Projection.cpp" "type/CMakeFiles/WorkflowTypeStatic.dir/src/Projection.cpp.o" "gcc" "type/CMakeFiles/WorkflowTypeStatic.dir/src/Projection.cpp.o.d"
+  "/root/repo/type/src/SchemaDictionary.cpp" "type/CMakeFiles/WorkflowTypeStatic.dir/src/SchemaDictionary.cpp.o" "gcc" "type/CMakeFiles/WorkflowTypeStatic.dir/src/SchemaDictionary.cpp.o.d"
+  "/root/repo/type/src/Skip.cpp" "type/CMakeFiles/WorkflowTypeStatic.dir/src/Skip.cpp.o" "gcc" "type/CMakeFiles/WorkflowTypeStatic.dir/src/Skip.cpp.o.d"
+  "/root/repo/type/src/StructDataType.cpp" "type/CMakeFiles/WorkflowTypeStatic.dir/src/StructDataType.cpp.o" "gcc" "type/CMakeFiles/WorkflowTypeStatic.dir/src/StructDataType.cpp.o.d"
+  "/root/repo/type/src/StructPlan.cpp" "type/CMakeFiles/WorkflowTypeStatic.dir/src/StructPlan.cpp.o" "gcc" "type/CMakeFiles/WorkflowTypeStatic.dir/src/StructPlan.cpp.o.d"
+  "/root/repo/type/src/StructSchema.cpp" "type/CMakeFiles/WorkflowTypeStatic.dir/src/StructSchema.cpp.o" "gcc" "type/CMakeFiles/WorkflowTypeStatic.dir/src/StructSchema.cpp.o.d"
+  "/root/repo/type/src/TextFormatter.cpp" "type/CMakeFiles/WorkflowTypeStatic.dir/src/TextFormatter.cpp.o" "gcc" "type/CMakeFiles/WorkflowTypeStatic.dir/src/TextFormatter.cpp.o.d"
+  "/root/repo/type/src/TreeEngine.cpp" "type/CMakeFiles/WorkflowTypeStatic.dir/src/TreeEngine.cpp.o" "gcc" "type/CMakeFiles/WorkflowTypeStatic.dir/src/TreeEngine.cpp.o.d"
+  "/root/repo/type/src/Variant.cpp" "type/CMakeFiles/WorkflowTypeStatic.dir/src/Variant.cpp.o" "gcc" "type/CMakeFiles/WorkflowTypeStatic.dir/src/Variant.cpp.o.d"
+  "/root/repo/type/src/VariantDataType.cpp" "type/CMakeFiles/WorkflowTypeStatic.dir/src/VariantDataType.cpp.o" "gcc" "type/CMakeFiles/WorkflowTypeStatic.dir/src/VariantDataType.cpp.o.d"
+  "/root/repo/type/src/VariantMethodsManager.cpp" "type/CMakeFiles/WorkflowTypeStatic.dir/src/VariantMethodsManager.cpp.o" "gcc" "type/CMakeFiles/WorkflowTypeStatic.dir/src/VariantMethodsManager.cpp.o.d"
+  "/root/repo/type/src/VectorDataType.cpp" "type/CMakeFiles/WorkflowTypeStatic.dir/src/VectorDataType.cpp.o" "gcc" "type/CMakeFiles/WorkflowTypeStatic.dir/src/VectorDataType.cpp.o.d"
+  "/root/repo/type/src/VectorMath.cpp" "type/CMakeFiles/WorkflowTypeStatic.dir/src/VectorMath.cpp.o" "gcc" "type/CMakeFiles/WorkflowTypeStatic.dir/src/VectorMath.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_warn_build/utils/CMakeFiles/WorkflowUtilsStatic.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,65 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/WorkflowTypeStatic.dir/src/DataStream.cpp.o"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/DataStream.cpp.o.d"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/DataTypeView.cpp.o"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/DataTypeView.cpp.o.d"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/DecodeError.cpp.o"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/DecodeError.cpp.o.d"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/IDataStream.cpp.o"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/IDataStream.cpp.o.d"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/IDataType.cpp.o"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/IDataType.cpp.o.d"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/IDataTypeVisitor.cpp.o"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/IDataTypeVisitor.cpp.o.d"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/IVariantMethods.cpp.o"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/IVariantMethods.cpp.o.d"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/JsonReader.cpp.o"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/JsonReader.cpp.o.d"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/JsonScan.cpp.o"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/JsonScan.cpp.o.d"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/JsonWriter.cpp.o"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/JsonWriter.cpp.o.d"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/ParallelDecoder.cpp.o"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/ParallelDecoder.cpp.o.d"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/ParallelEncoder.cpp.o"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/ParallelEncoder.cpp.o.d"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/ParallelFor.cpp.o"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/ParallelFor.cpp.o.d"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/Patch.cpp.o"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/Patch.cpp.o.d"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/PersistentStruct.cpp.o"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/PersistentStruct.cpp.o.d"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/Projection.cpp.o"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/Projection.cpp.o.d"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/SchemaDictionary.cpp.o"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/SchemaDictionary.cpp.o.d"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/Skip.cpp.o"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/Skip.cpp.o.d"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/StructDataType.cpp.o"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/StructDataType.cpp.o.d"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/StructPlan.cpp.o"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/StructPlan.cpp.o.d"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/StructSchema.cpp.o"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/StructSchema.cpp.o.d"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/TextFormatter.cpp.o"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/TextFormatter.cpp.o.d"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/TreeEngine.cpp.o"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/TreeEngine.cpp.o.d"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/Variant.cpp.o"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/Variant.cpp.o.d"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/VariantDataType.cpp.o"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/VariantDataType.cpp.o.d"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/VariantMethodsManager.cpp.o"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/VariantMethodsManager.cpp.o.d"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/VectorDataType.cpp.o"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/VectorDataType.cpp.o.d"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/VectorMath.cpp.o"
+  "CMakeFiles/WorkflowTypeStatic.dir/src/VectorMath.cpp.o.d"
+  "libWorkflowTypeStatic.a"
+  "libWorkflowTypeStatic.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/WorkflowTypeStatic.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,38 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/type/test/test_sequencer_type_DataTypeView.cpp" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_DataTypeView.cpp.o" "gcc" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_DataTypeView.cpp.o.d"
+  "/root/repo/type/test/test_sequencer_type_Demangle.cpp" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_Demangle.cpp.o" "gcc" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_Demangle.cpp.o.d"
+  "/root/repo/type/test/test_sequencer_type_Error.cpp" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_Error.cpp.o" "gcc" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_Error.cpp.o.d"
+  "/root/repo/type/test/test_sequencer_type_JsonReader.cpp" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_JsonReader.cpp.o" "gcc" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_JsonReader.cpp.o.d"
+  "/root/repo/type/test/test_sequencer_type_JsonWriter.cpp" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_JsonWriter.cpp.o" "gcc" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_JsonWriter.cpp.o.d"
+  "/root/repo/type/test/test_sequencer_type_ParallelDecoder.cpp" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_ParallelDecoder.cpp.o" "gcc" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_ParallelDecoder.cpp.o.d"
+  "/root/repo/type/test/test_sequencer_type_ParallelEncoder.cpp" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_ParallelEncoder.cpp.o" "gcc" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_ParallelEncoder.cpp.o.d"
+  "/root/repo/type/test/test_sequencer_type_Patch.cpp" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_Patch.cpp.o" "gcc" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_Patch.cpp.o.d"
+  "/root/repo/type/test/test_sequencer_type_PersistentStruct.cpp" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_PersistentStruct.cpp.o" "gcc" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_PersistentStruct.cpp.o.d"
+  "/root/repo/type/test/test_sequencer_type_StructDataType.cpp" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_StructDataType.cpp.o" "gcc" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_StructDataType.cpp.o.d"
+  "/root/repo/type/test/test_sequencer_type_TextFormatter.cpp" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_TextFormatter.cpp.o" "gcc" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_TextFormatter.cpp.o.d"
+  "/root/repo/type/test/test_sequencer_type_TreeEngine.cpp" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_TreeEngine.cpp.o" "gcc" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_TreeEngine.cpp.o.d"
+  "/root/repo/type/test/test_sequencer_type_Variant.cpp" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_Variant.cpp.o" "gcc" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_Variant.cpp.o.d"
+  "/root/repo/type/test/test_sequencer_type_VariantDataType.cpp" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_VariantDataType.cpp.o" "gcc" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_VariantDataType.cpp.o.d"
+  "/root/repo/type/test/test_sequencer_type_VariantMethodsManager.cpp" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_VariantMethodsManager.cpp.o" "gcc" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_VariantMethodsManager.cpp.o.d"
+  "/root/repo/type/test/test_sequencer_type_VectorDataType.cpp" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_VectorDataType.cpp.o" "gcc" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_VectorDataType.cpp.o.d"
+  "/root/repo/type/test/test_sequencer_type_VectorMath.cpp" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_VectorMath.cpp.o" "gcc" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_VectorMath.cpp.o.d"
+  "/root/repo/type/test/test_sequencer_type_Visit.cpp" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_Visit.cpp.o" "gcc" "type/test/CMakeFiles/test_sequencer_type.dir/test_sequencer_type_Visit.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_warn_build/type/CMakeFiles/WorkflowType.dir/DependInfo.cmake"
+  "/root/repo/_warn_build/utils/CMakeFiles/WorkflowUtils.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
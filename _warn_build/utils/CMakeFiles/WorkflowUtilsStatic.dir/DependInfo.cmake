@@ -0,0 +1,23 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/utils/src/Demangle.cpp" "utils/CMakeFiles/WorkflowUtilsStatic.dir/src/Demangle.cpp.o" "gcc" "utils/CMakeFiles/WorkflowUtilsStatic.dir/src/Demangle.cpp.o.d"
+  "/root/repo/utils/src/Error.cpp" "utils/CMakeFiles/WorkflowUtilsStatic.dir/src/Error.cpp.o" "gcc" "utils/CMakeFiles/WorkflowUtilsStatic.dir/src/Error.cpp.o.d"
+  "/root/repo/utils/src/ErrorCode.cpp" "utils/CMakeFiles/WorkflowUtilsStatic.dir/src/ErrorCode.cpp.o" "gcc" "utils/CMakeFiles/WorkflowUtilsStatic.dir/src/ErrorCode.cpp.o.d"
+  "/root/repo/utils/src/Hash.cpp" "utils/CMakeFiles/WorkflowUtilsStatic.dir/src/Hash.cpp.o" "gcc" "utils/CMakeFiles/WorkflowUtilsStatic.dir/src/Hash.cpp.o.d"
+  "/root/repo/utils/src/InternedString.cpp" "utils/CMakeFiles/WorkflowUtilsStatic.dir/src/InternedString.cpp.o" "gcc" "utils/CMakeFiles/WorkflowUtilsStatic.dir/src/InternedString.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
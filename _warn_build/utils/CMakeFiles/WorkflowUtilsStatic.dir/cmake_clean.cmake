@@ -0,0 +1,19 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/WorkflowUtilsStatic.dir/src/Demangle.cpp.o"
+  "CMakeFiles/WorkflowUtilsStatic.dir/src/Demangle.cpp.o.d"
+  "CMakeFiles/WorkflowUtilsStatic.dir/src/Error.cpp.o"
+  "CMakeFiles/WorkflowUtilsStatic.dir/src/Error.cpp.o.d"
+  "CMakeFiles/WorkflowUtilsStatic.dir/src/ErrorCode.cpp.o"
+  "CMakeFiles/WorkflowUtilsStatic.dir/src/ErrorCode.cpp.o.d"
+  "CMakeFiles/WorkflowUtilsStatic.dir/src/Hash.cpp.o"
+  "CMakeFiles/WorkflowUtilsStatic.dir/src/Hash.cpp.o.d"
+  "CMakeFiles/WorkflowUtilsStatic.dir/src/InternedString.cpp.o"
+  "CMakeFiles/WorkflowUtilsStatic.dir/src/InternedString.cpp.o.d"
+  "libWorkflowUtilsStatic.a"
+  "libWorkflowUtilsStatic.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/WorkflowUtilsStatic.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,51 @@
+include(CheckIPOSupported)
+
+option( WORKFLOW_BUILD_STATIC
+        "Additionally build static libraries. Applications linking them can inline the hot paths across library boundaries."
+        ON )
+
+check_ipo_supported( RESULT WORKFLOW_IPO_SUPPORTED OUTPUT WORKFLOW_IPO_OUTPUT LANGUAGES CXX )
+
+# workflow_add_library( <name>
+#                       SOURCES <sources...>
+#                       INCLUDES <public include dirs...>
+#                       LINK <public link libraries...> )
+#
+# Creates the shared library <name>, which is the ABI stable variant used by
+# plugins. If WORKFLOW_BUILD_STATIC is set, the static library <name>Static is
+# created from the same sources. It links the static variants of other
+# workflow libraries and is built with link time optimization if available.
+# It defines WORKFLOW_STATIC for itself and its users, which inlines the hot
+# paths that the shared library exports out of line.
+function( workflow_add_library name )
+    cmake_parse_arguments( ARG "" "" "SOURCES;INCLUDES;LINK" ${ARGN} )
+
+    add_library( ${name} SHARED ${ARG_SOURCES} )
+    target_include_directories( ${name} PUBLIC ${ARG_INCLUDES} )
+    target_link_libraries( ${name} PUBLIC ${ARG_LINK} )
+    if ( CMAKE_CXX_COMPILER_ID MATCHES "GNU|Clang" )
+        # Calls inside the library must not go through the PLT
+        target_compile_options( ${name} PRIVATE -fno-semantic-interposition )
+    endif()
+
+    if ( WORKFLOW_BUILD_STATIC )
+        set( staticLink )
+        foreach( lib ${ARG_LINK} )
+            if ( TARGET ${lib}Static )
+                list( APPEND staticLink ${lib}Static )
+            else()
+                list( APPEND staticLink ${lib} )
+            endif()
+        endforeach()
+
+        add_library( ${name}Static STATIC ${ARG_SOURCES} )
+        target_include_directories( ${name}Static PUBLIC ${ARG_INCLUDES} )
+        target_link_libraries( ${name}Static PUBLIC ${staticLink} )
+        # Inlines the hot paths defined in the headers into the library and its users
+        target_compile_definitions( ${name}Static PUBLIC WORKFLOW_STATIC )
+        set_target_properties( ${name}Static PROPERTIES POSITION_INDEPENDENT_CODE ON )
+        if ( WORKFLOW_IPO_SUPPORTED )
+            set_target_properties( ${name}Static PROPERTIES INTERPROCEDURAL_OPTIMIZATION ON )
+        endif()
+    endif()
+endfunction()
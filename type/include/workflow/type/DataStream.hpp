@@ -1,14 +1,100 @@
 #pragma once
 
+#include <cstring>
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+
+#ifdef __MINGW32__
+#include <sys/param.h>
+#endif
+
+#include <workflow/utils/InternedString.hpp>
+#include <workflow/utils/Macros.hpp>
+
 #include <workflow/type/IDataStream.hpp>
+#include <workflow/type/DecodeError.hpp>
+#include <workflow/type/DecodeLimits.hpp>
 
 namespace workflow::type {
 
+namespace internal {
+class SchemaDictionary;
+} // end namespace internal
+
 class DataStream : public IDataStream
 {
 public:
     DataStream( IDataStreamUniquePtr backend );
 
+    ~DataStream();
+
+    /**
+     * Enable or disable the schema dictionary. If enabled, a struct writes its
+     * schema only on first use in the stream and afterwards just a schema id
+     * followed by the attribute values. Reader and writer must use the same
+     * setting, change it only before any struct was written or read.
+     *
+     * @param [in]  enabled     True to enable, false to disable
+     */
+    void
+    setSchemaDictionary( bool enabled );
+
+    /**
+     * Test if the schema dictionary is enabled
+     */
+    bool
+    hasSchemaDictionary() const noexcept;
+
+    /**
+     * Set the limits applied while reading from the stream
+     *
+     * @param [in]  limits      The limits
+     */
+    void
+    setLimits( const DecodeLimits& limits );
+
+    /**
+     * Get the limits applied while reading from the stream
+     */
+    const DecodeLimits&
+    getLimits() const;
+
+    /**
+     * Get the number of bytes read so far
+     */
+    uint64_t
+    getBytesRead() const;
+
+    /**
+     * Bound an untrusted element count by the data that is left in the
+     * stream. Use it to reserve memory before reading the elements.
+     *
+     * @param [in]  count           The element count read from the stream
+     * @param [in]  minElementSize  Minimum encoded size of a single element
+     *
+     * @return Number of elements it is safe to reserve memory for
+     */
+    size_t
+    getReserveHint( uint64_t count,
+                    size_t minElementSize ) const;
+
+    /**
+     * Enter a nested data type while reading. Must be paired with leaveNested()
+     * on success.
+     *
+     * @return DecodeError::None on success, DecodeError::NestingTooDeep if
+     *         DecodeLimits::maxDepth is exceeded
+     */
+    DecodeError
+    enterNested();
+
+    /**
+     * Leave a nested data type entered by enterNested()
+     */
+    void
+    leaveNested();
+
     /**
      * Write boolean value
      *
@@ -105,6 +191,14 @@ public:
     void
     write( const std::string& value );
 
+    /**
+     * Write interned string value. Encoded like std::string.
+     *
+     * @param [in]  value       Value to write
+     */
+    void
+    write( const utils::InternedString& value );
+
     /**
      * Read boolean value
      *
@@ -201,6 +295,175 @@ public:
     void
     read( std::string& value );
 
+    /**
+     * Read and intern string value. Reuses an internal buffer, so strings
+     * already interned are read without allocation.
+     *
+     * @param [out] value       Value to read
+     */
+    void
+    read( utils::InternedString& value );
+
+    /**
+     * Try to read boolean value. Does not throw on malformed data.
+     *
+     * @param [out] value       Value to read
+     *
+     * @return DecodeError::None on success, else the reason of the failure
+     */
+    DecodeError
+    tryRead( bool& value );
+
+    /**
+     * Try to read uint8_t value. Does not throw on malformed data.
+     *
+     * @param [out] value       Value to read
+     *
+     * @return DecodeError::None on success, else the reason of the failure
+     */
+    DecodeError
+    tryRead( uint8_t& value );
+
+    /**
+     * Try to read uint16_t value. Does not throw on malformed data.
+     *
+     * @param [out] value       Value to read
+     *
+     * @return DecodeError::None on success, else the reason of the failure
+     */
+    DecodeError
+    tryRead( uint16_t& value );
+
+    /**
+     * Try to read uint32_t value. Does not throw on malformed data.
+     *
+     * @param [out] value       Value to read
+     *
+     * @return DecodeError::None on success, else the reason of the failure
+     */
+    DecodeError
+    tryRead( uint32_t& value );
+
+    /**
+     * Try to read uint64_t value. Does not throw on malformed data.
+     *
+     * @param [out] value       Value to read
+     *
+     * @return DecodeError::None on success, else the reason of the failure
+     */
+    DecodeError
+    tryRead( uint64_t& value );
+
+    /**
+     * Try to read int8_t value. Does not throw on malformed data.
+     *
+     * @param [out] value       Value to read
+     *
+     * @return DecodeError::None on success, else the reason of the failure
+     */
+    DecodeError
+    tryRead( int8_t& value );
+
+    /**
+     * Try to read int16_t value. Does not throw on malformed data.
+     *
+     * @param [out] value       Value to read
+     *
+     * @return DecodeError::None on success, else the reason of the failure
+     */
+    DecodeError
+    tryRead( int16_t& value );
+
+    /**
+     * Try to read int32_t value. Does not throw on malformed data.
+     *
+     * @param [out] value       Value to read
+     *
+     * @return DecodeError::None on success, else the reason of the failure
+     */
+    DecodeError
+    tryRead( int32_t& value );
+
+    /**
+     * Try to read int64_t value. Does not throw on malformed data.
+     *
+     * @param [out] value       Value to read
+     *
+     * @return DecodeError::None on success, else the reason of the failure
+     */
+    DecodeError
+    tryRead( int64_t& value );
+
+    /**
+     * Try to read float value. Does not throw on malformed data.
+     *
+     * @param [out] value       Value to read
+     *
+     * @return DecodeError::None on success, else the reason of the failure
+     */
+    DecodeError
+    tryRead( float& value );
+
+    /**
+     * Try to read double value. Does not throw on malformed data.
+     *
+     * @param [out] value       Value to read
+     *
+     * @return DecodeError::None on success, else the reason of the failure
+     */
+    DecodeError
+    tryRead( double& value );
+
+    /**
+     * Try to read string value. Does not throw on malformed data.
+     *
+     * @param [out] value       Value to read
+     *
+     * @return DecodeError::None on success, else the reason of the failure
+     */
+    DecodeError
+    tryRead( std::string& value );
+
+    /**
+     * Try to read and intern string value. Does not throw on malformed data.
+     * Reuses an internal buffer, so strings already interned are read without
+     * allocation.
+     *
+     * @param [out] value       Value to read
+     *
+     * @return DecodeError::None on success, else the reason of the failure
+     */
+    DecodeError
+    tryRead( utils::InternedString& value );
+
+    /**
+     * Write an array of numeric values. The encoding is the same as writing
+     * every value on its own, but it is done with only a few backend calls.
+     *
+     * @tparam T                One of the fixed size integer types, float or double
+     * @param [in]  values      Pointer to the first value
+     * @param [in]  count       Number of values
+     */
+    template<typename T>
+    void
+    writeArray( const T* values,
+                size_t count );
+
+    /**
+     * Read an array of numeric values written by writeArray() or by writing
+     * every value on its own. Does not throw on malformed data.
+     *
+     * @tparam T                One of the fixed size integer types, float or double
+     * @param [out] values      Pointer to the first value
+     * @param [in]  count       Number of values
+     *
+     * @return DecodeError::None on success, else the reason of the failure
+     */
+    template<typename T>
+    DecodeError
+    tryReadArray( T* values,
+                  size_t count );
+
     /**************************************************************************
      * IDataStream pure virtual overrides
      *************************************************************************/
@@ -212,8 +475,534 @@ public:
     read( const size_t length,
           void* data ) override;
 
+    virtual bool
+    tryRead( const size_t length,
+             void* data ) override;
+
+    virtual bool
+    trySkip( const size_t length ) override;
+
+    virtual size_t
+    available() const override;
+
+    virtual void
+    writeGather( utils::Span<const utils::Span<const uint8_t>> buffers ) override;
+
 private:
+    friend class StructDataType;
+    friend class TreeEngine;
+
+    /**
+     * Type tags put in front of every primitive value
+     */
+    enum class SerializerTypes : uint8_t
+    {
+        Invalid     = 255,
+        Bool        = 0,
+        UInt8,
+        UInt16,
+        UInt32,
+        UInt64,
+        SInt8,
+        SInt16,
+        SInt32,
+        SInt64,
+        IEEE32,     // float
+        IEEE64      // double
+    };
+
+#ifdef __MINGW32__
+    static constexpr bool HOST_IS_LITTLE_ENDIAN = (BYTE_ORDER == LITTLE_ENDIAN);
+#elif defined(__BYTE_ORDER__)
+    static constexpr bool HOST_IS_LITTLE_ENDIAN = (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__);
+#else
+#   error Add compiler support
+#endif
+
+    // Size of the stack buffer used to encode and decode arrays
+    static constexpr size_t ARRAY_BUFFER_SIZE = 4096;
+
+    /**
+     * Get the type tag of a numeric type
+     */
+    template<typename T>
+    static constexpr SerializerTypes
+    getSerializerType();
+
+    /**
+     * Convert between host and network (little endian) byte order
+     *
+     * @param [in]  value       The value to convert in place
+     */
+    template<typename T>
+    static void
+    swapBytes( T& value );
+
+    /**
+     * Write tagged primitive value with a single backend call
+     *
+     * @param [in]  value       Value to write
+     */
+    template<SerializerTypes S, typename T>
+    void
+    doWrite( T value );
+
+    /**
+     * Read tagged primitive value. The tag is checked before the value is
+     * read, so a mismatch reports DecodeError::TypeMismatch without consuming
+     * the value, even if the stream is too short for the requested type.
+     *
+     * @param [out] value       Value to read
+     *
+     * @return DecodeError::None on success, else the reason of the failure
+     */
+    template<SerializerTypes S, typename T>
+    DecodeError
+    doTryRead( T& value );
+
+    /**
+     * Read raw data, respecting the total size limit
+     *
+     * @param [in]  length      Number of bytes to read
+     * @param [in]  data        Buffer to copy the data to
+     *
+     * @return True on success, else false
+     */
+    bool
+    readRaw( const size_t length,
+             void* data );
+
+    /**
+     * Throw utils::Error for a failed read. Kept out of line to keep the
+     * inlined read paths small.
+     *
+     * @param [in]  error       The decode error
+     */
+    [[noreturn]] static void
+    throwDecodeError( DecodeError error );
+
+    /**
+     * Test if length bytes can be read without exceeding the total size limit
+     *
+     * @param [in]  length      The number of bytes
+     */
+    bool
+    withinTotalLimit( const size_t length ) const;
+
     IDataStreamUniquePtr mBackend;
+    DecodeLimits         mLimits;
+    uint64_t             mBytesRead;
+    uint32_t             mDepth;
+    std::string          mScratch;
+
+    std::unique_ptr<internal::SchemaDictionary> mSchemaDictionary;
 };
 
+/******************************************************************************
+ * Inlined implementations
+ *
+ * The primitive encode and decode paths are defined here, so callers of the
+ * static library can inline them into their serialization loops instead of
+ * calling into the library for every value.
+ *****************************************************************************/
+template<typename T>
+inline void
+DataStream::swapBytes( T& value )
+{
+    if constexpr ( !HOST_IS_LITTLE_ENDIAN )
+    {
+        uint8_t* begin = reinterpret_cast<uint8_t*>( &value );
+        std::reverse( begin, begin + sizeof(T) );
+    }
+}
+
+template<DataStream::SerializerTypes S, typename T>
+inline void
+DataStream::doWrite( T value )
+{
+    uint8_t buffer[1 + sizeof(T)];
+    buffer[0] = static_cast<uint8_t>(S);
+    swapBytes( value );
+    std::memcpy( buffer + 1, &value, sizeof(T) );
+    mBackend->write( sizeof(buffer), buffer );
+}
+
+template<DataStream::SerializerTypes S, typename T>
+inline DecodeError
+DataStream::doTryRead( T& value )
+{
+    uint8_t tag;
+    if ( !readRaw( sizeof(tag), &tag ) )
+    {
+        return DecodeError::EndOfStream;
+    }
+    if ( tag != static_cast<uint8_t>(S) )
+    {
+        return DecodeError::TypeMismatch;
+    }
+    if ( !readRaw( sizeof(T), &value ) )
+    {
+        return DecodeError::EndOfStream;
+    }
+    swapBytes( value );
+    return DecodeError::None;
+}
+
+template<typename T>
+constexpr DataStream::SerializerTypes
+DataStream::getSerializerType()
+{
+    if constexpr ( std::is_same_v<T, uint8_t> )         return SerializerTypes::UInt8;
+    else if constexpr ( std::is_same_v<T, uint16_t> )   return SerializerTypes::UInt16;
+    else if constexpr ( std::is_same_v<T, uint32_t> )   return SerializerTypes::UInt32;
+    else if constexpr ( std::is_same_v<T, uint64_t> )   return SerializerTypes::UInt64;
+    else if constexpr ( std::is_same_v<T, int8_t> )     return SerializerTypes::SInt8;
+    else if constexpr ( std::is_same_v<T, int16_t> )    return SerializerTypes::SInt16;
+    else if constexpr ( std::is_same_v<T, int32_t> )    return SerializerTypes::SInt32;
+    else if constexpr ( std::is_same_v<T, int64_t> )    return SerializerTypes::SInt64;
+    else if constexpr ( std::is_same_v<T, float> )      return SerializerTypes::IEEE32;
+    else if constexpr ( std::is_same_v<T, double> )     return SerializerTypes::IEEE64;
+    else
+    {
+        static_assert( !sizeof(T), "Unsupported array type" );
+        return SerializerTypes::Invalid;
+    }
+}
+
+template<typename T>
+inline void
+DataStream::writeArray( const T* values,
+                        size_t count )
+{
+    constexpr size_t ENCODED_SIZE = 1 + sizeof(T);
+    constexpr size_t PER_BUFFER = ARRAY_BUFFER_SIZE / ENCODED_SIZE;
+    constexpr uint8_t TYPE = static_cast<uint8_t>( getSerializerType<T>() );
+
+    uint8_t buffer[PER_BUFFER * ENCODED_SIZE];
+    while ( count )
+    {
+        const size_t num = std::min( count, PER_BUFFER );
+        uint8_t* pos = buffer;
+        for ( size_t i = 0; i < num; ++i, pos += ENCODED_SIZE )
+        {
+            T value = values[i];
+            swapBytes( value );
+            pos[0] = TYPE;
+            std::memcpy( pos + 1, &value, sizeof(T) );
+        }
+        mBackend->write( num * ENCODED_SIZE, buffer );
+        values += num;
+        count -= num;
+    }
+}
+
+template<typename T>
+inline DecodeError
+DataStream::tryReadArray( T* values,
+                          size_t count )
+{
+    constexpr size_t ENCODED_SIZE = 1 + sizeof(T);
+    constexpr size_t PER_BUFFER = ARRAY_BUFFER_SIZE / ENCODED_SIZE;
+    constexpr uint8_t TYPE = static_cast<uint8_t>( getSerializerType<T>() );
+
+    uint8_t buffer[PER_BUFFER * ENCODED_SIZE];
+    while ( count )
+    {
+        const size_t num = std::min( count, PER_BUFFER );
+        if ( !readRaw( num * ENCODED_SIZE, buffer ) )
+        {
+            return DecodeError::EndOfStream;
+        }
+
+        const uint8_t* pos = buffer;
+        for ( size_t i = 0; i < num; ++i, pos += ENCODED_SIZE )
+        {
+            if ( pos[0] != TYPE )
+            {
+                return DecodeError::TypeMismatch;
+            }
+            std::memcpy( &values[i], pos + 1, sizeof(T) );
+            swapBytes( values[i] );
+        }
+        values += num;
+        count -= num;
+    }
+    return DecodeError::None;
+}
+
+#if defined( WORKFLOW_STATIC ) || defined( SEQ_DEFINE_DATASTREAM_HOT_PATH )
+SEQ_HOT_PATH bool
+DataStream::readRaw( const size_t length,
+                     void* data )
+{
+    if ( !withinTotalLimit( length ) || !mBackend->tryRead( length, data ) )
+    {
+        return false;
+    }
+    mBytesRead += length;
+    return true;
+}
+
+SEQ_HOT_PATH bool
+DataStream::withinTotalLimit( const size_t length ) const
+{
+    // The limit may have been lowered below the bytes already read
+    return mBytesRead <= mLimits.maxTotalBytes && length <= mLimits.maxTotalBytes - mBytesRead;
+}
+
+SEQ_HOT_PATH void
+DataStream::write( bool value )
+{
+    const uint8_t VALUE = value ? 1 : 0;
+    doWrite<SerializerTypes::Bool>( VALUE );
+}
+
+SEQ_HOT_PATH void
+DataStream::write( uint8_t value )
+{
+    doWrite<SerializerTypes::UInt8>( value );
+}
+
+SEQ_HOT_PATH void
+DataStream::write( uint16_t value )
+{
+    doWrite<SerializerTypes::UInt16>( value );
+}
+
+SEQ_HOT_PATH void
+DataStream::write( uint32_t value )
+{
+    doWrite<SerializerTypes::UInt32>( value );
+}
+
+SEQ_HOT_PATH void
+DataStream::write( uint64_t value )
+{
+    doWrite<SerializerTypes::UInt64>( value );
+}
+
+SEQ_HOT_PATH void
+DataStream::write( int8_t value )
+{
+    doWrite<SerializerTypes::SInt8>( value );
+}
+
+SEQ_HOT_PATH void
+DataStream::write( int16_t value )
+{
+    doWrite<SerializerTypes::SInt16>( value );
+}
+
+SEQ_HOT_PATH void
+DataStream::write( int32_t value )
+{
+    doWrite<SerializerTypes::SInt32>( value );
+}
+
+SEQ_HOT_PATH void
+DataStream::write( int64_t value )
+{
+    doWrite<SerializerTypes::SInt64>( value );
+}
+
+SEQ_HOT_PATH void
+DataStream::write( float value )
+{
+    doWrite<SerializerTypes::IEEE32>( value );
+}
+
+SEQ_HOT_PATH void
+DataStream::write( double value )
+{
+    doWrite<SerializerTypes::IEEE64>( value );
+}
+
+SEQ_HOT_PATH DecodeError
+DataStream::tryRead( bool& value )
+{
+    uint8_t tmp = 0;
+    auto error = doTryRead<SerializerTypes::Bool>( tmp );
+    if ( DecodeError::None != error )
+    {
+        return error;
+    }
+    if ( tmp != 0 && tmp != 1 )
+    {
+        return DecodeError::InvalidValue;
+    }
+    value = !!tmp;
+    return DecodeError::None;
+}
+
+SEQ_HOT_PATH DecodeError
+DataStream::tryRead( uint8_t& value )
+{
+    return doTryRead<SerializerTypes::UInt8>( value );
+}
+
+SEQ_HOT_PATH DecodeError
+DataStream::tryRead( uint16_t& value )
+{
+    return doTryRead<SerializerTypes::UInt16>( value );
+}
+
+SEQ_HOT_PATH DecodeError
+DataStream::tryRead( uint32_t& value )
+{
+    return doTryRead<SerializerTypes::UInt32>( value );
+}
+
+SEQ_HOT_PATH DecodeError
+DataStream::tryRead( uint64_t& value )
+{
+    return doTryRead<SerializerTypes::UInt64>( value );
+}
+
+SEQ_HOT_PATH DecodeError
+DataStream::tryRead( int8_t& value )
+{
+    return doTryRead<SerializerTypes::SInt8>( value );
+}
+
+SEQ_HOT_PATH DecodeError
+DataStream::tryRead( int16_t& value )
+{
+    return doTryRead<SerializerTypes::SInt16>( value );
+}
+
+SEQ_HOT_PATH DecodeError
+DataStream::tryRead( int32_t& value )
+{
+    return doTryRead<SerializerTypes::SInt32>( value );
+}
+
+SEQ_HOT_PATH DecodeError
+DataStream::tryRead( int64_t& value )
+{
+    return doTryRead<SerializerTypes::SInt64>( value );
+}
+
+SEQ_HOT_PATH DecodeError
+DataStream::tryRead( float& value )
+{
+    return doTryRead<SerializerTypes::IEEE32>( value );
+}
+
+SEQ_HOT_PATH DecodeError
+DataStream::tryRead( double& value )
+{
+    return doTryRead<SerializerTypes::IEEE64>( value );
+}
+
+SEQ_HOT_PATH void
+DataStream::read( bool& value )
+{
+    auto error = tryRead( value );
+    if ( DecodeError::None != error )
+    {
+        throwDecodeError( error );
+    }
+}
+
+SEQ_HOT_PATH void
+DataStream::read( uint8_t& value )
+{
+    auto error = tryRead( value );
+    if ( DecodeError::None != error )
+    {
+        throwDecodeError( error );
+    }
+}
+
+SEQ_HOT_PATH void
+DataStream::read( uint16_t& value )
+{
+    auto error = tryRead( value );
+    if ( DecodeError::None != error )
+    {
+        throwDecodeError( error );
+    }
+}
+
+SEQ_HOT_PATH void
+DataStream::read( uint32_t& value )
+{
+    auto error = tryRead( value );
+    if ( DecodeError::None != error )
+    {
+        throwDecodeError( error );
+    }
+}
+
+SEQ_HOT_PATH void
+DataStream::read( uint64_t& value )
+{
+    auto error = tryRead( value );
+    if ( DecodeError::None != error )
+    {
+        throwDecodeError( error );
+    }
+}
+
+SEQ_HOT_PATH void
+DataStream::read( int8_t& value )
+{
+    auto error = tryRead( value );
+    if ( DecodeError::None != error )
+    {
+        throwDecodeError( error );
+    }
+}
+
+SEQ_HOT_PATH void
+DataStream::read( int16_t& value )
+{
+    auto error = tryRead( value );
+    if ( DecodeError::None != error )
+    {
+        throwDecodeError( error );
+    }
+}
+
+SEQ_HOT_PATH void
+DataStream::read( int32_t& value )
+{
+    auto error = tryRead( value );
+    if ( DecodeError::None != error )
+    {
+        throwDecodeError( error );
+    }
+}
+
+SEQ_HOT_PATH void
+DataStream::read( int64_t& value )
+{
+    auto error = tryRead( value );
+    if ( DecodeError::None != error )
+    {
+        throwDecodeError( error );
+    }
+}
+
+SEQ_HOT_PATH void
+DataStream::read( float& value )
+{
+    auto error = tryRead( value );
+    if ( DecodeError::None != error )
+    {
+        throwDecodeError( error );
+    }
+}
+
+SEQ_HOT_PATH void
+DataStream::read( double& value )
+{
+    auto error = tryRead( value );
+    if ( DecodeError::None != error )
+    {
+        throwDecodeError( error );
+    }
+}
+#endif
+
 } // end namespace workflow::type
\ No newline at end of file
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <typeindex>
+
+#include <workflow/utils/Span.hpp>
+
+#include <workflow/type/IDataType.hpp>
+#include <workflow/type/DecodeLimits.hpp>
+#include <workflow/type/Variant.hpp>
+
+namespace workflow::type {
+
+/**
+ * Read only view of a data type serialized by IDataType::serialize() into a
+ * contiguous buffer. Nothing is decoded up front: the first access to a view
+ * builds a small table of the offsets of its attributes or elements, values
+ * are only decoded when they are accessed. Attributes not accessed are skipped
+ * without being decoded.
+ * Copies of a view share the offset table, building it is thread safe. Views
+ * of attributes are kept by their struct, so accessing an attribute again
+ * reuses its offset table. The buffer must outlive the view and all views
+ * derived from it. Malformed data throws on the access that detects it.
+ */
+class DataTypeView
+{
+public:
+    using Data = utils::Span<const uint8_t>;
+
+    /**
+     * Create view
+     *
+     * @param [in]  data        The serialized data type, starting with the
+     *                          data type id
+     * @param [in]  limits      The limits applied while decoding
+     */
+    explicit
+    DataTypeView( Data data,
+                  const DecodeLimits& limits = DecodeLimits() );
+
+    /**
+     * Get the serialized data of the viewed data type
+     */
+    Data
+    getData() const noexcept;
+
+    /**
+     * Get the data type
+     */
+    IDataType::Type
+    getType() const;
+
+    /**
+     * Get the name, like IDataType::getName()
+     */
+    std::string
+    getName() const;
+
+    /**
+     * Get the number of attributes of a struct or elements of a vector.
+     * Throws for variants.
+     */
+    size_t
+    size() const;
+
+    /**
+     * Test if a struct has an attribute. Throws if not a struct.
+     *
+     * @param [in]  name        The attribute name
+     */
+    bool
+    has( std::string_view name ) const;
+
+    /**
+     * Get the name of a struct attribute. Attributes are ordered by name like
+     * in StructSchema. Throws if not a struct.
+     *
+     * @param [in]  index       The attribute index
+     *
+     * @return The name, pointing into the buffer
+     */
+    std::string_view
+    getAttributeName( size_t index ) const;
+
+    /**
+     * Get a struct attribute. Throws if not a struct or there is no such
+     * attribute.
+     *
+     * @param [in]  name        The attribute name
+     */
+    DataTypeView
+    get( std::string_view name ) const;
+
+    /**
+     * Get a struct attribute by index. Throws if not a struct.
+     *
+     * @param [in]  index       The attribute index
+     */
+    DataTypeView
+    get( size_t index ) const;
+
+    /**
+     * Get the variant type of a variant or the element type of a vector.
+     * Throws for structs.
+     */
+    std::type_index
+    getValueType() const;
+
+    /**
+     * Decode the value of a variant. Throws if not a variant.
+     */
+    Variant
+    getValue() const;
+
+    /**
+     * Decode a vector element. Throws if not a vector.
+     *
+     * @param [in]  index       The element index
+     */
+    Variant
+    getElement( size_t index ) const;
+
+    /**
+     * Decode the complete data type
+     */
+    IDataTypeUniquePtr
+    materialize() const;
+
+private:
+    struct Node;
+    struct Index;
+
+    explicit
+    DataTypeView( std::shared_ptr<const Node> node ) noexcept;
+
+    /**
+     * Get the offset table, built on first use
+     */
+    const Index&
+    getIndex() const;
+
+    /**
+     * Get the offset table. Throws if the data type differs.
+     *
+     * @param [in]  type        The expected data type
+     */
+    const Index&
+    getIndex( IDataType::Type type ) const;
+
+    std::shared_ptr<const Node> mNode;
+};
+
+} // end namespace workflow::type
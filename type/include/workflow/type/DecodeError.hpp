@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+
+namespace workflow::type {
+
+/**
+ * Reasons why decoding data from a DataStream or text failed. Returned by the
+ * non throwing try* APIs.
+ */
+enum class DecodeError : uint8_t
+{
+    None = 0,               ///< No error
+    EndOfStream,            ///< Not enough data available
+    TypeMismatch,           ///< The stream contains a different serializer type
+    InvalidValue,           ///< A value is out of its valid range
+    UnknownDataType,        ///< Unknown IDataType discriminator
+    UnknownVariantType,     ///< No IVariantMethods registered for the hash
+    InvalidName,            ///< Empty struct or attribute name
+    DuplicateAttribute,     ///< The attribute name was already read
+    StringTooLong,          ///< DecodeLimits::maxStringLength exceeded
+    TooManyElements,        ///< DecodeLimits::maxElementCount exceeded
+    NestingTooDeep,         ///< DecodeLimits::maxDepth exceeded
+    TotalSizeExceeded,      ///< DecodeLimits::maxTotalBytes exceeded
+    SyntaxError,            ///< Malformed text
+    UnknownAttribute,       ///< The attribute is not part of the schema
+    MissingAttribute,       ///< An attribute of the schema or struct is missing
+};
+
+/**
+ * Get a static, human readable description of a decode error
+ *
+ * @param [in]  error       The error
+ *
+ * @return The description
+ */
+const char*
+toString( DecodeError error ) noexcept;
+
+/**
+ * Write decode error to output stream
+ *
+ * @param [in]  os          The stream
+ * @param [in]  error       The error
+ *
+ * @return The stream
+ */
+std::ostream&
+operator<<( std::ostream& os,
+            DecodeError error );
+
+} // end namespace workflow::type
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace workflow::type {
+
+/**
+ * Per stream limits applied while decoding. They protect against malformed or
+ * adversarial input claiming huge sizes. All limits are disabled by default.
+ */
+struct DecodeLimits
+{
+    /// Maximum length of a single string in bytes
+    uint32_t maxStringLength = std::numeric_limits<uint32_t>::max();
+
+    /// Maximum number of vector elements or struct attributes
+    uint32_t maxElementCount = std::numeric_limits<uint32_t>::max();
+
+    /// Maximum nesting depth of data types
+    uint32_t maxDepth = std::numeric_limits<uint32_t>::max();
+
+    /// Maximum number of bytes read from the stream in total
+    uint64_t maxTotalBytes = std::numeric_limits<uint64_t>::max();
+};
+
+} // end namespace workflow::type
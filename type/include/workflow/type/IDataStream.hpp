@@ -1,9 +1,11 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <memory>
 
 #include <workflow/utils/Macros.hpp>
+#include <workflow/utils/Span.hpp>
 
 namespace workflow::type {
 
@@ -38,6 +40,50 @@ public:
     read( const size_t length,
           void* data ) = 0;
 
+    /**
+     * Read data without throwing. The default implementation is only a
+     * fallback catching the exception thrown by read(), so the non throwing
+     * guarantee of the decoders requires backends to override it. All
+     * backends bundled with the library do.
+     *
+     * @param [in]  length      Number of bytes to read
+     * @param [in]  data        User supplied buffer to copy the data to
+     *
+     * @return True on success, false if the data could not be read
+     */
+    virtual bool
+    tryRead( const size_t length,
+             void* data );
+
+    /**
+     * Skip data without throwing. The default implementation reads the data
+     * into a temporary buffer, backends able to seek should override it.
+     *
+     * @param [in]  length      Number of bytes to skip
+     *
+     * @return True on success, false if the data could not be skipped
+     */
+    virtual bool
+    trySkip( const size_t length );
+
+    /**
+     * Get the number of bytes that can still be read. Used to bound memory
+     * allocations to the data actually present. The default implementation
+     * returns std::numeric_limits<size_t>::max() meaning unknown.
+     */
+    virtual size_t
+    available() const;
+
+    /**
+     * Write several buffers in order. The default implementation calls
+     * write() for each of them, backends able to write them at once should
+     * override it.
+     *
+     * @param [in]  buffers     The buffers
+     */
+    virtual void
+    writeGather( utils::Span<const utils::Span<const uint8_t>> buffers );
+
     SEQ_INTERFACE_DECL( IDataStream );
 };
 
@@ -5,6 +5,9 @@
 #include <iosfwd>
 
 #include <workflow/utils/Macros.hpp>
+#include <workflow/utils/Expected.hpp>
+
+#include <workflow/type/DecodeError.hpp>
 
 namespace workflow::type {
 
@@ -30,6 +33,11 @@ public:
         Vector,     ///< Of type VectorDataType
     };
 
+    /**
+     * Result of the non throwing deserialization
+     */
+    using DecodeResult = utils::Expected<IDataTypeUniquePtr, DecodeError>;
+
     /**
      * Get the name of the data type.
      */
@@ -76,6 +84,18 @@ public:
     virtual bool
     equals( const IDataType& other ) const = 0;
 
+    /**
+     * Get a structural hash of the type and the content. Equal data types
+     * have equal hashes, a struct combines the hashes of its attributes. The
+     * hash is computed on first use and cached until the data type is changed.
+     * Mutable references, iterators or spans obtained before the hash was
+     * computed must not be used to change the data type afterwards.
+     *
+     * @return The content hash
+     */
+    virtual uint64_t
+    getContentHash() const = 0;
+
     /**
      * Write to output stream
      *
@@ -105,6 +125,18 @@ public:
     static IDataTypeUniquePtr
     deserialize( DataStream& stream );
 
+    /**
+     * Non throwing deserialization helper. Malformed data is reported by an
+     * error code instead of an exception, which makes it suitable for
+     * untrusted input with a high rate of rejected messages.
+     *
+     * @param [in]  stream      The stream
+     *
+     * @return The data type or the reason of the failure
+     */
+    static DecodeResult
+    tryDeserialize( DataStream& stream );
+
     /**
      * Test for equality
      *
@@ -5,6 +5,7 @@
 #include <workflow/utils/Macros.hpp>
 
 #include <workflow/type/Variant.hpp>
+#include <workflow/type/DecodeError.hpp>
 
 namespace workflow::type {
 
@@ -69,6 +70,22 @@ public:
     deserialize( DataStream& stream,
                  Variant& value ) const = 0;
 
+    /**
+     * Deserialize variant from data stream without throwing on malformed data.
+     * The default implementation is only a fallback catching the exception
+     * thrown by deserialize(), so the non throwing guarantee of the decoders
+     * requires implementations to override it. The methods registered for
+     * the built in types do.
+     *
+     * @param [in]  stream      The data stream
+     * @param [out] value       The deserialized variant
+     *
+     * @return DecodeError::None on success, else the reason of the failure
+     */
+    virtual DecodeError
+    tryDeserialize( DataStream& stream,
+                    Variant& value ) const;
+
     SEQ_INTERFACE_DECL( IVariantMethods );
 };
 
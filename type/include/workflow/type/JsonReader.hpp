@@ -0,0 +1,241 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <typeindex>
+#include <vector>
+
+#include <workflow/type/DecodeError.hpp>
+#include <workflow/type/DecodeLimits.hpp>
+#include <workflow/type/IDataType.hpp>
+#include <workflow/type/StructSchema.hpp>
+
+namespace workflow::type {
+
+class Variant;
+class VectorDataType;
+
+/**
+ * Parser of JSON text into data types, reading the text written by
+ * JsonWriter. The text is parsed in a single pass without building a document
+ * first, values are decoded straight into the typed storage of the data
+ * types. Runs of string characters without escapes are found by testing eight
+ * characters at once. Nested objects are parsed iteratively.
+ *
+ * With a schema the text must be an object holding exactly the attributes of
+ * the schema, in any order. Values are converted to the types of the
+ * attributes and rejected if out of range. null reads as NaN for floating
+ * point numbers. Values of other variant types are read from strings by
+ * IVariantMethods::fromString().
+ *
+ * Without schema the types are inferred:
+ *   - Objects become structs named OBJECT_NAME. Empty objects are rejected.
+ *   - Arrays become vectors. Arrays of arrays or objects are rejected.
+ *   - true and false become bool, strings become std::string.
+ *   - Integers become int64_t, or uint64_t if too large for it. All other
+ *     numbers become double, as do the elements of arrays holding them.
+ *     Empty arrays become vectors of double.
+ *   - null is rejected.
+ *
+ * The limits apply as for decoding a stream. A reader is not thread safe.
+ */
+class JsonReader
+{
+public:
+    /// Name of the structs read from objects without schema
+    static constexpr std::string_view OBJECT_NAME = "Object";
+
+    /**
+     * Create reader
+     */
+    JsonReader();
+
+    ~JsonReader();
+
+    /**
+     * Parse a data type. Throws on malformed text.
+     *
+     * @param [in]  text        The JSON text
+     * @param [in]  schema      The schema of the object, null to infer the
+     *                          types
+     * @param [in]  limits      The limits applied while parsing
+     *
+     * @return The data type
+     */
+    IDataTypeUniquePtr
+    parse( std::string_view text,
+           const StructSchemaSharedPtr& schema = nullptr,
+           const DecodeLimits& limits = DecodeLimits() );
+
+    /**
+     * Parse a data type without throwing on malformed text
+     *
+     * @param [in]  text        The JSON text
+     * @param [in]  schema      The schema of the object, null to infer the
+     *                          types
+     * @param [in]  limits      The limits applied while parsing
+     *
+     * @return The data type or the reason of the failure
+     */
+    IDataType::DecodeResult
+    tryParse( std::string_view text,
+              const StructSchemaSharedPtr& schema = nullptr,
+              const DecodeLimits& limits = DecodeLimits() );
+
+    /**
+     * Get the offset in the text at which the last parse failed
+     */
+    size_t
+    getErrorOffset() const noexcept;
+
+private:
+    struct Frame;
+
+    /**
+     * Parse the whole text
+     */
+    DecodeError
+    parseDocument( const StructSchemaSharedPtr& schema,
+                   IDataTypeUniquePtr& result );
+
+    /**
+     * Open an object, the opening brace is consumed
+     */
+    DecodeError
+    openObject( const StructSchemaSharedPtr& schema );
+
+    /**
+     * Create the struct of the innermost object
+     */
+    DecodeError
+    closeObject( IDataTypeUniquePtr& result );
+
+    /**
+     * Parse a value that is not an object
+     *
+     * @param [in]  attribute   The attribute of the schema, null to infer the
+     *                          type
+     * @param [out] value       The value
+     */
+    DecodeError
+    parseValue( const StructSchema::Attribute* attribute,
+                IDataTypeUniquePtr& value );
+
+    /**
+     * Parse an array into a vector of the element type
+     */
+    DecodeError
+    parseVector( std::type_index elementType,
+                 IDataTypeUniquePtr& value );
+
+    /**
+     * Parse the elements of an array into the typed storage of a vector
+     */
+    template<typename T>
+    DecodeError
+    parseElements( VectorDataType& vector );
+
+    /**
+     * Parse a scalar into a variant of a type
+     */
+    DecodeError
+    parseVariant( std::type_index type,
+                  Variant& value );
+
+    /**
+     * Parse an array inferring the element type
+     */
+    DecodeError
+    inferVector( IDataTypeUniquePtr& value );
+
+    /**
+     * Parse a scalar inferring its type
+     */
+    DecodeError
+    inferVariant( Variant& value );
+
+    /**
+     * Parse an array. The element callback parses a single element.
+     */
+    template<typename F>
+    DecodeError
+    parseArray( F&& element );
+
+    /**
+     * Parse a value of one of the built in types
+     */
+    template<typename T>
+    DecodeError
+    parseScalar( T& value );
+
+    /**
+     * Parse a string. The view refers to the text or to an internal buffer
+     * valid until the next string is parsed.
+     */
+    DecodeError
+    parseString( std::string_view& value );
+
+    /**
+     * Parse the escape sequence following a backslash
+     */
+    DecodeError
+    parseEscape();
+
+    /**
+     * Parse four hexadecimal digits
+     */
+    DecodeError
+    parseHex( uint32_t& value );
+
+    /**
+     * Find the end of a number
+     *
+     * @param [out] token       The number
+     * @param [out] integral    True if the number has neither fraction nor
+     *                          exponent
+     */
+    DecodeError
+    scanNumber( std::string_view& token,
+                bool& integral );
+
+    /**
+     * Consume a literal like true, false or null
+     */
+    DecodeError
+    parseLiteral( std::string_view literal );
+
+    /**
+     * Skip white space
+     *
+     * @return False if the end of the text is reached
+     */
+    bool
+    skipWhitespace() noexcept;
+
+    /**
+     * Get the error for the character at a position of the text
+     *
+     * @return DecodeError::EndOfStream at the end, else DecodeError::SyntaxError
+     */
+    DecodeError
+    syntaxError( const char* position ) noexcept;
+
+    const char*         mBegin = nullptr;
+    const char*         mPosition = nullptr;
+    const char*         mEnd = nullptr;
+    DecodeLimits        mLimits;
+    size_t              mErrorOffset = 0;
+    std::string         mScratch;
+    std::vector<Frame>  mStack;
+};
+
+/******************************************************************************
+ * Inlined implementations
+ *****************************************************************************/
+inline size_t
+JsonReader::getErrorOffset() const noexcept
+{
+    return mErrorOffset;
+}
+
+} // end namespace workflow::type
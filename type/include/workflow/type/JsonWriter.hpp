@@ -0,0 +1,138 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <workflow/type/IDataType.hpp>
+
+namespace workflow::type {
+
+class StructDataType;
+class Variant;
+class VectorDataType;
+
+/**
+ * Writer of data types as JSON, for exchanging data with other tools. The
+ * text is written to a buffer owned by the writer, which keeps its memory
+ * between calls.
+ *
+ *   - Structs are written as objects with the attributes ordered by name. The
+ *     struct name is not written.
+ *   - Vectors are written as arrays.
+ *   - bool is written as true or false, numbers by std::to_chars in the
+ *     shortest form reading back to the same value. Non finite floating point
+ *     numbers are written as null.
+ *   - Strings are written as JSON strings. Quotes, backslashes and control
+ *     characters are escaped, all other bytes are copied unchanged.
+ *   - Values of other variant types are written as strings holding the text
+ *     of IVariantMethods::toString().
+ *
+ * Nested structs are written iteratively. JsonReader reads the text back. A
+ * writer is not thread safe.
+ */
+class JsonWriter
+{
+public:
+    /**
+     * Write a data type, replacing the text of previous calls
+     *
+     * @param [in]  dataType    The data type
+     *
+     * @return The text, valid until the writer is used again
+     */
+    std::string_view
+    write( const IDataType& dataType );
+
+    /**
+     * Append a data type to the text
+     *
+     * @param [in]  dataType    The data type
+     */
+    void
+    append( const IDataType& dataType );
+
+    /**
+     * Get the text
+     *
+     * @return The text, valid until the writer is used again
+     */
+    std::string_view
+    view() const noexcept;
+
+    /**
+     * Remove the text. The memory is kept.
+     */
+    void
+    clear() noexcept;
+
+private:
+    struct Frame
+    {
+        const StructDataType*   node;
+        size_t                  index;
+    };
+
+    /**
+     * Append a variant as JSON value
+     */
+    void
+    appendVariant( const Variant& value );
+
+    /**
+     * Append a vector as JSON array
+     */
+    void
+    appendVector( const VectorDataType& vector );
+
+    /**
+     * Append the typed elements of a vector if T is the element type
+     *
+     * @return False if T is not the element type
+     */
+    template<typename T>
+    bool
+    appendElements( const VectorDataType& vector );
+
+    /**
+     * Append the value of a variant if T is its type
+     *
+     * @return False if T is not the type of the variant
+     */
+    template<typename T>
+    bool
+    appendTyped( const Variant& value );
+
+    /**
+     * Append a value of one of the built in types
+     */
+    template<typename T>
+    void
+    appendValue( const T& value );
+
+    /**
+     * Append a JSON string
+     */
+    void
+    appendString( std::string_view value );
+
+    std::string         mBuffer;
+    std::vector<Frame>  mStack;
+};
+
+/******************************************************************************
+ * Inlined implementations
+ *****************************************************************************/
+inline std::string_view
+JsonWriter::view() const noexcept
+{
+    return mBuffer;
+}
+
+inline void
+JsonWriter::clear() noexcept
+{
+    mBuffer.clear();
+}
+
+} // end namespace workflow::type
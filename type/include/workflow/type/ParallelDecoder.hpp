@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <workflow/utils/Span.hpp>
+
+#include <workflow/type/DecodeError.hpp>
+#include <workflow/type/DecodeLimits.hpp>
+#include <workflow/type/IDataType.hpp>
+
+namespace workflow::type {
+
+class Variant;
+
+/**
+ * Decode a data type serialized by IDataType::serialize() into a contiguous
+ * buffer on several threads. The calling thread first builds an offset index
+ * of the parts of the buffer by skipping them: structs larger than the grain
+ * size are split into their attributes, vectors of numbers larger than the
+ * grain size into chunks of elements. The parts are decoded in parallel by
+ * the calling thread and helper threads, afterwards the calling thread
+ * assembles the tree. The result equals the one of IDataType::tryDeserialize().
+ * The buffer must have been written without schema dictionary.
+ */
+class ParallelDecoder
+{
+public:
+    using Data = utils::Span<const uint8_t>;
+
+    /// Number of bytes below which a part is decoded as a whole
+    static constexpr size_t DEFAULT_GRAIN_SIZE = 1024 * 1024;
+
+    /**
+     * Create decoder
+     *
+     * @param [in]  threads     Number of threads decoding in parallel,
+     *                          including the calling thread. 0 uses one thread
+     *                          per hardware thread.
+     * @param [in]  grainSize   Number of bytes below which a part is not split
+     */
+    explicit
+    ParallelDecoder( size_t threads = 0,
+                     size_t grainSize = DEFAULT_GRAIN_SIZE );
+
+    /**
+     * Get the number of threads decoding in parallel
+     */
+    size_t
+    getThreads() const noexcept;
+
+    /**
+     * Get the number of bytes below which a part is not split
+     */
+    size_t
+    getGrainSize() const noexcept;
+
+    /**
+     * Decode a data type. Throws on malformed data.
+     *
+     * @param [in]  data        The serialized data type, starting with the
+     *                          data type id. Trailing data is ignored.
+     * @param [in]  limits      The limits applied while decoding
+     *
+     * @return The data type
+     */
+    IDataTypeUniquePtr
+    deserialize( Data data,
+                 const DecodeLimits& limits = DecodeLimits() ) const;
+
+    /**
+     * Decode a data type without throwing on malformed data
+     *
+     * @param [in]  data        The serialized data type, starting with the
+     *                          data type id. Trailing data is ignored.
+     * @param [in]  limits      The limits applied while decoding
+     *
+     * @return The data type or the reason of the failure
+     */
+    IDataType::DecodeResult
+    tryDeserialize( Data data,
+                    const DecodeLimits& limits = DecodeLimits() ) const;
+
+private:
+    struct Part;
+    struct Job;
+
+    using Parts = std::vector<Part>;
+    using Jobs = std::vector<Job>;
+
+    /**
+     * Split a part into its attributes or element chunks if it is larger than
+     * the grain size. New parts are appended.
+     *
+     * @param [in]  parts       All parts
+     * @param [in]  index       The index of the part to split
+     * @param [in]  limits      The limits applied while decoding
+     *
+     * @return DecodeError::None on success, else the reason of the failure
+     */
+    DecodeError
+    split( Parts& parts,
+           size_t index,
+           const DecodeLimits& limits ) const;
+
+    /**
+     * Group the parts into jobs of about the grain size
+     *
+     * @param [in]  parts       All parts
+     */
+    Jobs
+    schedule( const Parts& parts ) const;
+
+    /**
+     * Decode the parts of a job
+     *
+     * @param [in]  parts       All parts
+     * @param [in]  job         The job
+     * @param [in]  limits      The limits applied while decoding
+     *
+     * @return DecodeError::None on success, else the reason of the failure
+     */
+    static DecodeError
+    decode( Parts& parts,
+            const Job& job,
+            const DecodeLimits& limits );
+
+    /**
+     * Create the structs of the split parts from their decoded attributes
+     *
+     * @param [in]  parts       All parts, the root first
+     *
+     * @return DecodeError::None on success, else the reason of the failure
+     */
+    static DecodeError
+    assemble( Parts& parts );
+
+    /**
+     * Allocate the elements of a vector part if T is its element type
+     *
+     * @param [in]  part        The vector part
+     * @param [in]  type        A value of the element type
+     * @param [in]  count       The number of elements
+     *
+     * @return True if T is the element type
+     */
+    template<typename T>
+    static bool
+    allocate( Part& part,
+              const Variant& type,
+              uint32_t count );
+
+    size_t  mThreads;
+    size_t  mGrainSize;
+};
+
+/******************************************************************************
+ * Inlined implementations
+ *****************************************************************************/
+inline size_t
+ParallelDecoder::getThreads() const noexcept
+{
+    return mThreads;
+}
+
+inline size_t
+ParallelDecoder::getGrainSize() const noexcept
+{
+    return mGrainSize;
+}
+
+} // end namespace workflow::type
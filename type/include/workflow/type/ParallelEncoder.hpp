@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <workflow/type/IDataType.hpp>
+
+namespace workflow::type {
+
+class DataStream;
+
+/**
+ * Serialize a data type on several threads. Structs larger than the grain
+ * size are split into their attributes, vectors of numbers larger than the
+ * grain size into chunks of elements. Neighbouring parts are grouped into
+ * jobs of about the grain size, each job is written to a memory buffer of its
+ * own by the calling thread or a helper thread. The buffers are then written
+ * to the stream in order with a single IDataStream::writeGather() call. The
+ * bytes are the same as written by IDataType::serialize().
+ * The buffers hold the complete encoding until they are written. Streams with
+ * schema dictionary are written sequentially, the dictionary depends on the
+ * order of the structs.
+ */
+class ParallelEncoder
+{
+public:
+    /// Number of bytes below which a part is encoded as a whole
+    static constexpr size_t DEFAULT_GRAIN_SIZE = 1024 * 1024;
+
+    /**
+     * Create encoder
+     *
+     * @param [in]  threads     Number of threads encoding in parallel,
+     *                          including the calling thread. 0 uses one thread
+     *                          per hardware thread.
+     * @param [in]  grainSize   Number of bytes below which a part is not split
+     */
+    explicit
+    ParallelEncoder( size_t threads = 0,
+                     size_t grainSize = DEFAULT_GRAIN_SIZE );
+
+    /**
+     * Get the number of threads encoding in parallel
+     */
+    size_t
+    getThreads() const noexcept;
+
+    /**
+     * Get the number of bytes below which a part is not split
+     */
+    size_t
+    getGrainSize() const noexcept;
+
+    /**
+     * Write a data type like IDataType::serialize( stream, dataType )
+     *
+     * @param [in]  stream      The data stream
+     * @param [in]  dataType    The data type
+     */
+    void
+    serialize( DataStream& stream,
+               const IDataType& dataType ) const;
+
+private:
+    struct Piece;
+    struct Job;
+
+    using Pieces = std::vector<Piece>;
+    using Jobs = std::vector<Job>;
+
+    /**
+     * Estimate the encoded size of a data type. Stops counting above the
+     * grain size.
+     *
+     * @param [in]  dataType    The data type
+     */
+    size_t
+    estimate( const IDataType& dataType ) const;
+
+    /**
+     * Split a data type into pieces
+     *
+     * @param [in]  dataType    The data type
+     * @param [out] literals    The headers of the split structs and vectors,
+     *                          referenced by the pieces
+     *
+     * @return The pieces in stream order
+     */
+    Pieces
+    split( const IDataType& dataType,
+           std::vector<uint8_t>& literals ) const;
+
+    /**
+     * Group the pieces into jobs of about the grain size
+     *
+     * @param [in]  pieces      The pieces
+     */
+    Jobs
+    schedule( const Pieces& pieces ) const;
+
+    /**
+     * Write the pieces of a job
+     *
+     * @param [in]  stream      The stream
+     * @param [in]  pieces      The pieces
+     * @param [in]  job         The job
+     * @param [in]  literals    The headers referenced by the pieces
+     */
+    static void
+    encode( DataStream& stream,
+            const Pieces& pieces,
+            const Job& job,
+            const std::vector<uint8_t>& literals );
+
+    size_t  mThreads;
+    size_t  mGrainSize;
+};
+
+/******************************************************************************
+ * Inlined implementations
+ *****************************************************************************/
+inline size_t
+ParallelEncoder::getThreads() const noexcept
+{
+    return mThreads;
+}
+
+inline size_t
+ParallelEncoder::getGrainSize() const noexcept
+{
+    return mGrainSize;
+}
+
+} // end namespace workflow::type
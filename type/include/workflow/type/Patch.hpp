@@ -0,0 +1,194 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <workflow/utils/Expected.hpp>
+
+#include <workflow/type/DecodeError.hpp>
+#include <workflow/type/IDataType.hpp>
+
+namespace workflow::type {
+
+class StructDataType;
+class VectorDataType;
+
+/**
+ * Difference between two data type trees. Applying it to the tree it was
+ * created from produces the target tree. Equal subtrees are not descended
+ * into, the patch only holds:
+ *  - the values of changed variants and of attributes with a different type
+ *  - added and removed struct attributes
+ *  - one changed range per vector, its common prefix and suffix are kept
+ *
+ * The patch records the content hashes of both trees, applying it to another
+ * tree throws.
+ */
+class Patch
+{
+public:
+    /**
+     * Kind of a change
+     */
+    enum class Operation : uint32_t
+    {
+        Set = 1,        ///< Set the data type at the path, add a missing attribute
+        Remove = 2,     ///< Remove the struct attribute at the path
+        Splice = 3      ///< Replace a range of the vector at the path
+    };
+
+    /**
+     * A change of the data type at a path
+     */
+    struct Change
+    {
+        Operation                       operation = Operation::Set;
+
+        /// Attribute names from the root, empty for the root itself
+        std::vector<std::string>        path;
+
+        /// The new data type, or the new elements of a splice
+        std::shared_ptr<const IDataType> value;
+
+        /// First replaced element of a splice
+        uint32_t                        offset = 0;
+
+        /// Number of replaced elements of a splice
+        uint32_t                        removed = 0;
+    };
+
+    using Changes = std::vector<Change>;
+
+    /**
+     * Compute the difference of two trees. The patch shares the changed
+     * subtrees of the target, they must not be modified while it is used.
+     *
+     * @param [in]  from        The tree the patch is applied to
+     * @param [in]  to          The tree the patch produces
+     *
+     * @return The patch
+     */
+    static Patch
+    create( const std::shared_ptr<const IDataType>& from,
+            const std::shared_ptr<const IDataType>& to );
+
+    /**
+     * Apply the patch. The tree is not modified, the result shares all
+     * unchanged subtrees with it. Throws if the patch was created for a
+     * different tree or does not match its structure.
+     *
+     * @param [in]  root        The tree the patch was created from
+     *
+     * @return The patched tree
+     */
+    std::shared_ptr<const IDataType>
+    apply( const std::shared_ptr<const IDataType>& root ) const;
+
+    /**
+     * Get the changes, in depth first order
+     */
+    const Changes&
+    getChanges() const noexcept;
+
+    /**
+     * Test if the trees were equal
+     */
+    bool
+    empty() const noexcept;
+
+    /**
+     * Write to data stream
+     *
+     * @param [in]  stream      The data stream
+     */
+    void
+    serialize( DataStream& stream ) const;
+
+    /**
+     * Read from data stream without throwing on malformed data
+     *
+     * @param [in]  stream      The data stream
+     *
+     * @return The patch or the reason of the failure
+     */
+    static utils::Expected<Patch, DecodeError>
+    tryDeserialize( DataStream& stream );
+
+private:
+    using Path = std::vector<std::string>;
+
+    Patch() = default;
+
+    /**
+     * Append the changes turning a data type into another one
+     *
+     * @param [in]      from    The original data type
+     * @param [in]      to      The target data type
+     * @param [in,out]  path    The path of both data types
+     * @param [in,out]  changes The changes
+     */
+    static void
+    diff( const IDataType& from,
+          const std::shared_ptr<const IDataType>& to,
+          Path& path,
+          Changes& changes );
+
+    /**
+     * Append the changes of the attributes of two structs of the same name
+     */
+    static void
+    diffStruct( const StructDataType& from,
+                const StructDataType& to,
+                Path& path,
+                Changes& changes );
+
+    /**
+     * Append the splice of two vectors of the same element type
+     */
+    static void
+    diffVector( const VectorDataType& from,
+                const VectorDataType& to,
+                Path& path,
+                Changes& changes );
+
+    /**
+     * Apply a change below a data type, copying the structs on its path
+     *
+     * @param [in]  node        The data type at the depth
+     * @param [in]  change      The change
+     * @param [in]  depth       The number of path elements already resolved
+     *
+     * @return The changed copy of the data type
+     */
+    static IDataTypeSharedPtr
+    applyChange( const IDataTypeSharedPtr& node,
+                 const Change& change,
+                 size_t depth );
+
+    /// Content hash of the tree the patch applies to
+    uint64_t    mFrom = 0;
+
+    /// Content hash of the patched tree
+    uint64_t    mTo = 0;
+
+    Changes     mChanges;
+};
+
+/******************************************************************************
+ * Inlined implementations
+ *****************************************************************************/
+inline const Patch::Changes&
+Patch::getChanges() const noexcept
+{
+    return mChanges;
+}
+
+inline bool
+Patch::empty() const noexcept
+{
+    return mChanges.empty();
+}
+
+} // end namespace workflow::type
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <memory>
+#include <string_view>
+
+#include <workflow/type/StructDataType.hpp>
+#include <workflow/type/Variant.hpp>
+
+namespace workflow::type {
+
+/**
+ * Copy-on-write holder of a struct tree. Copies, see snapshot(), share the
+ * whole tree and cost a reference count. A mutation copies only the structs
+ * on the path from the root to the changed attribute, all other subtrees
+ * stay shared with the snapshots. Nodes owned by a single holder are changed
+ * in place.
+ * The tree is only accessible read only, values passed to set() must not be
+ * modified afterwards. A holder is not thread safe, but snapshots may be used
+ * concurrently with each other.
+ */
+class PersistentStruct
+{
+public:
+    /**
+     * Create holder sharing a struct. The struct is copied on first mutation.
+     *
+     * @param [in]  root        The root struct
+     */
+    explicit
+    PersistentStruct( std::shared_ptr<const StructDataType> root );
+
+    /**
+     * Take a snapshot in O(1). Later mutations of either holder are not
+     * visible in the other one.
+     */
+    PersistentStruct
+    snapshot() const noexcept;
+
+    /**
+     * Get the root struct
+     */
+    const StructDataType&
+    get() const noexcept;
+
+    /**
+     * Get an attribute. Throws if there is no such attribute.
+     *
+     * @param [in]  path        Attribute names separated by '.'
+     */
+    const IDataType&
+    get( std::string_view path ) const;
+
+    /**
+     * Share the root struct, e.g. to hand it to another thread
+     */
+    std::shared_ptr<const StructDataType>
+    share() const noexcept;
+
+    /**
+     * Replace an attribute. Throws if there is no such attribute or the value
+     * has a different type, the schemas are immutable.
+     *
+     * @param [in]  path        Attribute names separated by '.'
+     * @param [in]  value       The new value
+     */
+    void
+    set( std::string_view path,
+         IDataTypeSharedPtr value );
+
+    /**
+     * Replace the value of a variant attribute. Throws if there is no such
+     * attribute or the value has a different type.
+     *
+     * @param [in]  path        Attribute names separated by '.'
+     * @param [in]  value       The new value
+     */
+    void
+    set( std::string_view path,
+         Variant value );
+
+private:
+    /**
+     * Make a struct exclusively owned by copying it if it is shared. The copy
+     * shares the attribute values.
+     *
+     * @param [in,out]  node    The struct
+     *
+     * @return The exclusively owned struct
+     */
+    template<typename T>
+    static StructDataType&
+    makeUnique( std::shared_ptr<T>& node );
+
+    std::shared_ptr<StructDataType> mRoot;
+};
+
+/******************************************************************************
+ * Inlined implementations
+ *****************************************************************************/
+inline PersistentStruct
+PersistentStruct::snapshot() const noexcept
+{
+    return *this;
+}
+
+inline const StructDataType&
+PersistentStruct::get() const noexcept
+{
+    return *mRoot;
+}
+
+inline std::shared_ptr<const StructDataType>
+PersistentStruct::share() const noexcept
+{
+    return mRoot;
+}
+
+} // end namespace workflow::type
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace workflow::type {
+
+/**
+ * Selection of struct attributes to decode. Attributes are selected by paths
+ * of attribute names separated by '.', like "position.x". Selecting an
+ * attribute selects its complete value, paths into attributes that are not
+ * structs select nothing.
+ */
+class Projection
+{
+public:
+    /**
+     * Create empty projection, selecting nothing
+     */
+    Projection() = default;
+
+    /**
+     * Create projection
+     *
+     * @param [in]  paths       The attribute paths to select
+     */
+    Projection( std::initializer_list<std::string_view> paths );
+
+    /**
+     * Select an attribute. Throws if the path has an empty name.
+     *
+     * @param [in]  path        The attribute path
+     *
+     * @return This projection
+     */
+    Projection&
+    add( std::string_view path );
+
+    /**
+     * Test if the complete value is selected
+     */
+    bool
+    selectsAll() const noexcept;
+
+    /**
+     * Test if nothing is selected
+     */
+    bool
+    empty() const noexcept;
+
+    /**
+     * Get the projection of an attribute
+     *
+     * @param [in]  name        The attribute name
+     *
+     * @return The projection or nullptr if nothing of the attribute is
+     *         selected
+     */
+    const Projection*
+    find( std::string_view name ) const noexcept;
+
+private:
+    using Child = std::pair<std::string, Projection>;
+
+    // Ordered by name
+    std::vector<Child>  mChildren;
+    bool                mAll = false;
+};
+
+/******************************************************************************
+ * Inlined implementations
+ *****************************************************************************/
+inline bool
+Projection::selectsAll() const noexcept
+{
+    return mAll;
+}
+
+inline bool
+Projection::empty() const noexcept
+{
+    return !mAll && mChildren.empty();
+}
+
+} // end namespace workflow::type
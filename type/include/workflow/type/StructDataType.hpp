@@ -3,18 +3,64 @@
 #include <map>
 #include <vector>
 #include <string>
+#include <string_view>
+
+#include <workflow/utils/Hash.hpp>
 
 #include <workflow/type/IDataType.hpp>
+#include <workflow/type/Projection.hpp>
+#include <workflow/type/StructSchema.hpp>
 
 namespace workflow::type {
 
 /**
  * A composite data type, that contains other data types identified by its name.
+ * The layout is kept in a StructSchema shared by all instances of the same
+ * layout, an instance only stores the attribute values ordered by index.
  */
 class StructDataType : public IDataType
 {
 public:
     using NamedTypes = std::map<std::string,IDataTypeSharedPtr>;
+    using Values = std::vector<IDataTypeSharedPtr>;
+
+    /**
+     * An attribute name resolved to its index in a schema. It gives access to
+     * the attribute of every instance sharing that schema without a name
+     * lookup. Default constructed or failed handles are invalid.
+     */
+    class Handle
+    {
+    public:
+        Handle() = default;
+
+        /**
+         * Test if the attribute was resolved
+         */
+        explicit
+        operator bool() const noexcept;
+
+        /**
+         * Get the schema the handle was resolved in
+         */
+        const StructSchemaSharedPtr&
+        getSchema() const noexcept;
+
+        /**
+         * Get the attribute index
+         */
+        size_t
+        getIndex() const noexcept;
+
+    private:
+        friend class StructDataType;
+
+        Handle( StructSchemaSharedPtr schema,
+                size_t index ) noexcept;
+
+        StructSchemaSharedPtr   mSchema;
+        size_t                  mIndex = StructSchema::npos;
+    };
 
     /**
      * Create struct data type
@@ -25,6 +71,16 @@ public:
     StructDataType( const std::string& name,
                     const NamedTypes& namedTypes );
 
+    /**
+     * Create struct data type from a schema
+     *
+     * @param [in]  schema          The schema
+     * @param [in]  values          The attribute values, ordered by index.
+     *                              Must match the types of the schema.
+     */
+    StructDataType( StructSchemaSharedPtr schema,
+                    Values values );
+
     /**
      * Create struct type from data stream.
      *
@@ -33,12 +89,108 @@ public:
     explicit
     StructDataType( DataStream& stream );
 
+    /**
+     * Destroy struct. Nested structs owned by it alone are released without
+     * recursion.
+     */
+    virtual
+    ~StructDataType() override;
+
+    /**
+     * Deserialize from data stream without throwing on malformed data
+     *
+     * @param [in]  stream      The data stream
+     *
+     * @return The struct data type or the reason of the failure
+     */
+    static utils::Expected<std::unique_ptr<StructDataType>, DecodeError>
+    tryDeserialize( DataStream& stream );
+
+    /**
+     * Deserialize a struct of a known schema from data stream. Names and type
+     * ids are verified bytewise and the values decoded with the methods
+     * resolved in advance, so this is faster than the generic decoding. With
+     * a schema dictionary only the schema reference is compared.
+     *
+     * @param [in]  stream      The data stream
+     * @param [in]  schema      The expected schema
+     *
+     * @return The struct data type, DecodeError::TypeMismatch if the data
+     *         does not match the schema, else the reason of the failure
+     */
+    static utils::Expected<std::unique_ptr<StructDataType>, DecodeError>
+    tryDeserialize( DataStream& stream,
+                    const StructSchemaSharedPtr& schema );
+
+    /**
+     * Deserialize only the selected attributes from data stream. The bytes of
+     * all other attributes are skipped without decoding them where possible.
+     * The result is a struct of the same name holding only the selected
+     * attributes, nested structs are reduced the same way.
+     *
+     * @param [in]  stream      The data stream
+     * @param [in]  projection  The attributes to decode
+     *
+     * @return The struct data type or the reason of the failure
+     */
+    static utils::Expected<std::unique_ptr<StructDataType>, DecodeError>
+    tryDeserialize( DataStream& stream,
+                    const Projection& projection );
+
+    /**
+     * Get the schema
+     */
+    const StructSchemaSharedPtr&
+    getSchema() const noexcept;
+
+    /**
+     * Resolve an attribute name in a schema
+     *
+     * @param [in]  schema          The schema
+     * @param [in]  name            The attribute name
+     *
+     * @return The handle, invalid if there is no such attribute
+     */
+    static Handle
+    resolve( const StructSchemaSharedPtr& schema,
+             std::string_view name );
+
+    /**
+     * Resolve an attribute name in the schema of this instance
+     *
+     * @param [in]  name            The attribute name
+     *
+     * @return The handle, invalid if there is no such attribute
+     */
+    Handle
+    resolve( std::string_view name ) const;
+
+    /**
+     * Test if a handle was resolved in the schema of this instance
+     *
+     * @param [in]  handle          The handle
+     */
+    bool
+    matches( const Handle& handle ) const noexcept;
+
     /**
      * Get list of all attribute names
      */
     std::vector<std::string>
     getAttributes() const;
 
+    /**
+     * Get the interned struct name
+     */
+    utils::InternedString
+    getInternedName() const noexcept;
+
+    /**
+     * Get the interned attribute names, ordered by index. No copy is made.
+     */
+    const std::vector<utils::InternedString>&
+    getAttributeNames() const noexcept;
+
     /**
      * Test if a child type is available
      *
@@ -69,6 +221,68 @@ public:
     IDataType&
     get( const std::string& name );
 
+    /**
+     * Get attribute by index
+     *
+     * @param [in]  index           The attribute index in the schema
+     *
+     * @return Reference to attribute
+     */
+    const IDataType&
+    get( size_t index ) const;
+
+    /**
+     * Get attribute by index
+     *
+     * @param [in]  index           The attribute index in the schema
+     *
+     * @return Reference to attribute
+     */
+    IDataType&
+    get( size_t index );
+
+    /**
+     * Get attribute by handle. Throws if the handle was not resolved in the
+     * schema of this instance.
+     *
+     * @param [in]  handle          The handle
+     *
+     * @return Reference to attribute
+     */
+    const IDataType&
+    get( const Handle& handle ) const;
+
+    /**
+     * Get attribute by handle. Throws if the handle was not resolved in the
+     * schema of this instance.
+     *
+     * @param [in]  handle          The handle
+     *
+     * @return Reference to attribute
+     */
+    IDataType&
+    get( const Handle& handle );
+
+    /**
+     * Get attribute by handle without any check. The handle must match().
+     *
+     * @param [in]  handle          The handle
+     *
+     * @return Reference to attribute
+     */
+    const IDataType&
+    getUnchecked( const Handle& handle ) const noexcept;
+
+    /**
+     * Get attribute by handle without any check. The handle must match().
+     *
+     * @param [in]  handle          The handle
+     *
+     * @return Reference to attribute
+     */
+    IDataType&
+    getUnchecked( const Handle& handle ) noexcept;
+
     /**
      * Test for equality
      *
@@ -126,12 +340,185 @@ public:
     virtual bool
     equals( const IDataType& other ) const override;
 
+    /**
+     * Combines the name and the attribute names with the content hashes of
+     * the attributes, so unchanged attributes reuse their cached hashes.
+     * The cached hash is discarded once any data type discarded its hash
+     * since, so changing an attribute shared with other structs or through a
+     * retained reference is noticed. Mutable iterators and spans of vectors
+     * must not be used to change them after the hash was computed.
+     */
+    virtual uint64_t
+    getContentHash() const override;
+
     virtual void
     output( std::ostream& os ) const override;
 
 private:
-    std::string     mName;
-    NamedTypes      mAttributes;
+    friend class JsonReader;
+    friend class ParallelDecoder;
+    friend class Patch;
+    friend class PersistentStruct;
+    friend class TreeEngine;
+    friend class internal::StructPlan;
+
+    /**
+     * Create empty instance to be filled by decode()
+     */
+    StructDataType() = default;
+
+    /**
+     * Read the content from a data stream
+     *
+     * @param [in]  stream      The data stream
+     *
+     * @return DecodeError::None on success, else the reason of the failure
+     */
+    DecodeError
+    decode( DataStream& stream );
+
+    /**
+     * Read the selected attributes from a data stream
+     *
+     * @param [in]  stream      The data stream
+     * @param [in]  projection  The attributes to decode
+     *
+     * @return DecodeError::None on success, else the reason of the failure
+     */
+    DecodeError
+    decode( DataStream& stream,
+            const Projection& projection );
+
+    /**
+     * Create the schema for the decoded values
+     *
+     * @param [in]  name        The struct name
+     * @param [in]  attributes  The attributes of mValues, in stream order
+     *
+     * @return DecodeError::None on success, else the reason of the failure
+     */
+    DecodeError
+    finishDecode( utils::InternedString name,
+                  StructSchema::Attributes attributes );
+
+    /**
+     * Get index of an attribute. Throws if there is no such attribute.
+     *
+     * @param [in]  name            The attributes name.
+     */
+    size_t
+    indexOf( const std::string& name ) const;
+
+    /**
+     * Throw if the handle does not match
+     *
+     * @param [in]  handle          The handle
+     */
+    void
+    checkHandle( const Handle& handle ) const;
+
+    /**
+     * Throw the error of a handle not matching. Out of line to keep the
+     * checked access small.
+     *
+     * @param [in]  handle          The handle
+     */
+    [[noreturn]] void
+    throwHandleMismatch( const Handle& handle ) const;
+
+    StructSchemaSharedPtr   mSchema;
+    Values                  mValues;
+    utils::DerivedHashCache mContentHash;
 };
 
+/******************************************************************************
+ * Inlined implementations
+ *****************************************************************************/
+inline
+StructDataType::Handle::Handle( StructSchemaSharedPtr schema,
+                                size_t index ) noexcept
+    : mSchema( std::move(schema) )
+    , mIndex( index )
+{
+}
+
+inline
+StructDataType::Handle::operator bool() const noexcept
+{
+    return StructSchema::npos != mIndex;
+}
+
+inline const StructSchemaSharedPtr&
+StructDataType::Handle::getSchema() const noexcept
+{
+    return mSchema;
+}
+
+inline size_t
+StructDataType::Handle::getIndex() const noexcept
+{
+    return mIndex;
+}
+
+inline const StructSchemaSharedPtr&
+StructDataType::getSchema() const noexcept
+{
+    return mSchema;
+}
+
+inline utils::InternedString
+StructDataType::getInternedName() const noexcept
+{
+    return mSchema->getInternedName();
+}
+
+inline const std::vector<utils::InternedString>&
+StructDataType::getAttributeNames() const noexcept
+{
+    return mSchema->getAttributeNames();
+}
+
+inline bool
+StructDataType::matches( const Handle& handle ) const noexcept
+{
+    return handle && handle.mSchema == mSchema;
+}
+
+inline const IDataType&
+StructDataType::get( const Handle& handle ) const
+{
+    checkHandle( handle );
+    return *mValues[handle.mIndex];
+}
+
+inline IDataType&
+StructDataType::get( const Handle& handle )
+{
+    mContentHash.reset();
+    checkHandle( handle );
+    return *mValues[handle.mIndex];
+}
+
+inline const IDataType&
+StructDataType::getUnchecked( const Handle& handle ) const noexcept
+{
+    return *mValues[handle.mIndex];
+}
+
+inline IDataType&
+StructDataType::getUnchecked( const Handle& handle ) noexcept
+{
+    mContentHash.reset();
+    return *mValues[handle.mIndex];
+}
+
+inline void
+StructDataType::checkHandle( const Handle& handle ) const
+{
+    if ( !matches( handle ) )
+    {
+        throwHandleMismatch( handle );
+    }
+}
+
 } // end namespace workflow::type
@@ -0,0 +1,211 @@
+#pragma once
+
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <typeindex>
+#include <vector>
+
+#include <workflow/utils/InternedString.hpp>
+#include <workflow/utils/Macros.hpp>
+
+#include <workflow/type/IDataType.hpp>
+
+namespace workflow::type {
+
+SEQ_POINTER_DECL( StructSchema );
+
+namespace internal {
+class StructPlan;
+} // end namespace internal
+
+/**
+ * The immutable layout of a StructDataType: the struct name and the name and
+ * complete type of each attribute. Attributes are ordered by name, their
+ * position is the attribute index.
+ * Schemas are shared by all struct instances with the same layout. get()
+ * returns the same schema object for equal layouts as long as one instance is
+ * alive, so schemas can be compared by pointer.
+ */
+class StructSchema
+{
+public:
+    /**
+     * Description of a single attribute
+     */
+    struct Attribute
+    {
+        utils::InternedString   name;
+        IDataType::Type         type;
+        /// Variant type of a variant, element type of a vector, else void
+        std::type_index         valueType = typeid(void);
+        /// Schema of a struct, else null
+        StructSchemaSharedPtr   schema;
+
+        friend bool
+        operator==( const Attribute& lhs,
+                    const Attribute& rhs ) noexcept;
+
+        friend bool
+        operator!=( const Attribute& lhs,
+                    const Attribute& rhs ) noexcept;
+    };
+
+    using Attributes = std::vector<Attribute>;
+
+    /// Returned by find() if there is no such attribute
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    /**
+     * Get the shared schema for a layout. Thread safe.
+     *
+     * @param [in]  name        The struct name. Must not be empty.
+     * @param [in]  attributes  The attributes. The names must be unique, not
+     *                          empty and sorted.
+     *
+     * @return The schema
+     */
+    static StructSchemaSharedPtr
+    get( utils::InternedString name,
+         Attributes attributes );
+
+    /**
+     * Describe an attribute value
+     *
+     * @param [in]  name        The attribute name
+     * @param [in]  value       The attribute value
+     *
+     * @return The attribute description
+     */
+    static Attribute
+    describe( utils::InternedString name,
+              const IDataType& value );
+
+    /**
+     * Get the struct name
+     */
+    const std::string&
+    getName() const noexcept;
+
+    /**
+     * Get the interned struct name
+     */
+    utils::InternedString
+    getInternedName() const noexcept;
+
+    /**
+     * Get the interned attribute names, ordered by index
+     */
+    const std::vector<utils::InternedString>&
+    getAttributeNames() const noexcept;
+
+    /**
+     * Get the attributes, ordered by index
+     */
+    const Attributes&
+    getAttributes() const noexcept;
+
+    /**
+     * Get the number of attributes
+     */
+    size_t
+    size() const noexcept;
+
+    /**
+     * Get the index of an attribute
+     *
+     * @param [in]  name        The attribute name
+     *
+     * @return The index or npos if there is no such attribute
+     */
+    size_t
+    find( std::string_view name ) const noexcept;
+
+    /**
+     * Test if the layouts are equal
+     *
+     * @param [in]  lhs         Left operand
+     * @param [in]  rhs         Right operand
+     *
+     * @return True if equal, else false
+     */
+    friend bool
+    operator==( const StructSchema& lhs,
+                const StructSchema& rhs );
+
+    /**
+     * Test if the layouts differ
+     *
+     * @param [in]  lhs         Left operand
+     * @param [in]  rhs         Right operand
+     *
+     * @return True if not equal, else false
+     */
+    friend bool
+    operator!=( const StructSchema& lhs,
+                const StructSchema& rhs );
+
+    StructSchema( const StructSchema& ) = delete;
+    StructSchema& operator=( const StructSchema& ) = delete;
+
+    ~StructSchema();
+
+private:
+    class Registry;
+    friend class StructDataType;
+    friend class TreeEngine;
+    friend class internal::StructPlan;
+
+    StructSchema( utils::InternedString name,
+                  Attributes attributes );
+
+    /**
+     * Get the serialization plan, compiled on first use. Thread safe.
+     */
+    const internal::StructPlan&
+    getPlan() const;
+
+    utils::InternedString               mName;
+    Attributes                          mAttributes;
+    std::vector<utils::InternedString>  mAttributeNames;
+
+    mutable std::once_flag                                  mPlanFlag;
+    mutable std::unique_ptr<const internal::StructPlan>     mPlan;
+};
+
+/******************************************************************************
+ * Inlined implementations
+ *****************************************************************************/
+inline const std::string&
+StructSchema::getName() const noexcept
+{
+    return mName.str();
+}
+
+inline utils::InternedString
+StructSchema::getInternedName() const noexcept
+{
+    return mName;
+}
+
+inline const std::vector<utils::InternedString>&
+StructSchema::getAttributeNames() const noexcept
+{
+    return mAttributeNames;
+}
+
+inline const StructSchema::Attributes&
+StructSchema::getAttributes() const noexcept
+{
+    return mAttributes;
+}
+
+inline size_t
+StructSchema::size() const noexcept
+{
+    return mAttributes.size();
+}
+
+} // end namespace workflow::type
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <workflow/type/IDataType.hpp>
+
+namespace workflow::type {
+
+class StructDataType;
+class Variant;
+class VectorDataType;
+
+/**
+ * Text formatter for data types and variants, meant for logging. The text is
+ * written to a buffer owned by the formatter, which keeps its memory between
+ * calls. Numbers are written by std::to_chars, floating point numbers in the
+ * shortest form that reads back to the same value. Once the buffer has grown
+ * to the size of the largest text, formatting the built in types does not
+ * allocate. Values of other variant types are written by their output stream
+ * operator.
+ *
+ *     compact:  Point{label="a",x=1.5,y=[1,2]}
+ *     pretty:   Point{
+ *                   label="a",
+ *                   x=1.5,
+ *                   y=[1, 2]
+ *               }
+ *
+ * Nested structs are formatted iteratively, the nesting depth is not limited
+ * by the native stack. A formatter is not thread safe.
+ */
+class TextFormatter
+{
+public:
+    /**
+     * Layout of the text
+     */
+    enum class Style
+    {
+        Compact,    ///< Single line without spaces
+        Pretty      ///< One attribute per line, indented by nesting depth
+    };
+
+    /// Number of spaces per nesting level in pretty style
+    static constexpr size_t INDENT = 4;
+
+    /**
+     * Create formatter
+     *
+     * @param [in]  style       The layout of the text
+     */
+    explicit
+    TextFormatter( Style style = Style::Compact );
+
+    /**
+     * Get the layout of the text
+     */
+    Style
+    getStyle() const noexcept;
+
+    /**
+     * Format a data type, replacing the text of previous calls
+     *
+     * @param [in]  dataType    The data type
+     *
+     * @return The text, valid until the formatter is used again
+     */
+    std::string_view
+    format( const IDataType& dataType );
+
+    /**
+     * Format a variant, replacing the text of previous calls
+     *
+     * @param [in]  value       The variant
+     *
+     * @return The text, valid until the formatter is used again
+     */
+    std::string_view
+    format( const Variant& value );
+
+    /**
+     * Append a data type to the text
+     *
+     * @param [in]  dataType    The data type
+     */
+    void
+    append( const IDataType& dataType );
+
+    /**
+     * Append a variant to the text
+     *
+     * @param [in]  value       The variant
+     */
+    void
+    append( const Variant& value );
+
+    /**
+     * Get the text
+     *
+     * @return The text, valid until the formatter is used again
+     */
+    std::string_view
+    view() const noexcept;
+
+    /**
+     * Remove the text. The memory is kept.
+     */
+    void
+    clear() noexcept;
+
+private:
+    struct Frame
+    {
+        const StructDataType*   node;
+        size_t                  index;
+    };
+
+    /**
+     * Append a vector on a single line
+     */
+    void
+    appendVector( const VectorDataType& vector );
+
+    /**
+     * Append the typed elements of a vector if T is the element type
+     *
+     * @return False if T is not the element type
+     */
+    template<typename T>
+    bool
+    appendElements( const VectorDataType& vector );
+
+    /**
+     * Append the value of a variant if T is its type
+     *
+     * @return False if T is not the type of the variant
+     */
+    template<typename T>
+    bool
+    appendTyped( const Variant& value );
+
+    /**
+     * Append a value of one of the built in types
+     */
+    template<typename T>
+    void
+    appendValue( const T& value );
+
+    /**
+     * Append a quoted string. Quotes, backslashes and control characters are
+     * escaped.
+     */
+    void
+    appendString( std::string_view value );
+
+    /**
+     * Append the separator of vector elements
+     */
+    void
+    appendSeparator();
+
+    /**
+     * Start a new line indented for a nesting depth in pretty style
+     */
+    void
+    appendLine( size_t depth );
+
+    Style               mStyle;
+    std::string         mBuffer;
+    std::vector<Frame>  mStack;
+    std::ostringstream  mFallback;
+};
+
+/******************************************************************************
+ * Inlined implementations
+ *****************************************************************************/
+inline TextFormatter::Style
+TextFormatter::getStyle() const noexcept
+{
+    return mStyle;
+}
+
+inline std::string_view
+TextFormatter::view() const noexcept
+{
+    return mBuffer;
+}
+
+inline void
+TextFormatter::clear() noexcept
+{
+    mBuffer.clear();
+}
+
+} // end namespace workflow::type
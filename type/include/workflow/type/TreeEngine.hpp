@@ -0,0 +1,212 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <limits>
+#include <vector>
+
+#include <workflow/type/DecodeError.hpp>
+#include <workflow/type/IDataType.hpp>
+
+namespace workflow::type {
+
+class StructDataType;
+
+namespace internal {
+class StructPlan;
+} // end namespace internal
+
+/**
+ * Iterative traversal of data type trees. Serialization, deserialization,
+ * equality and printing of nested structs run in a loop over an explicit
+ * stack of frames instead of recursing on the native stack, so the nesting
+ * depth is only bounded by the depth limit. The stacks are preallocated and
+ * reused by every call, walking a tree does not allocate per nesting level.
+ * The data types use the unlimited engine of the calling thread, see local().
+ * An engine is not thread safe. Its calls may be nested, e.g. by a variant
+ * serializing a data type itself.
+ */
+class TreeEngine
+{
+public:
+    /// No depth limit
+    static constexpr size_t UNLIMITED = std::numeric_limits<size_t>::max();
+
+    /// Number of nesting levels preallocated by default
+    static constexpr size_t DEFAULT_RESERVE = 64;
+
+    /**
+     * Create engine
+     *
+     * @param [in]  maxDepth    Maximum nesting depth of structs, the root
+     *                          struct being at depth 1
+     * @param [in]  reserve     Number of nesting levels to preallocate
+     */
+    explicit
+    TreeEngine( size_t maxDepth = UNLIMITED,
+                size_t reserve = DEFAULT_RESERVE );
+
+    ~TreeEngine();
+
+    TreeEngine( const TreeEngine& other ) = delete;
+    TreeEngine& operator=( const TreeEngine& other ) = delete;
+
+    /**
+     * Get the engine of the calling thread. It has no depth limit.
+     */
+    static TreeEngine&
+    local();
+
+    /**
+     * Get the maximum nesting depth
+     */
+    size_t
+    getMaxDepth() const noexcept;
+
+    /**
+     * Write a data type like IDataType::serialize( stream, dataType ). Throws
+     * if it is nested too deep.
+     *
+     * @param [in]  stream      The data stream
+     * @param [in]  dataType    The data type
+     */
+    void
+    serialize( DataStream& stream,
+               const IDataType& dataType );
+
+    /**
+     * Read a data type like IDataType::tryDeserialize()
+     *
+     * @param [in]  stream      The data stream
+     *
+     * @return The data type, DecodeError::NestingTooDeep if it exceeds the
+     *         depth limit of the engine or of the stream, else the reason of
+     *         the failure
+     */
+    IDataType::DecodeResult
+    tryDeserialize( DataStream& stream );
+
+    /**
+     * Test data types for equality like operator==(). Throws if they are
+     * nested too deep.
+     *
+     * @param [in]  lhs         Left operand
+     * @param [in]  rhs         Right operand
+     */
+    bool
+    equals( const IDataType& lhs,
+            const IDataType& rhs );
+
+    /**
+     * Print a data type like operator<<(). Throws if it is nested too deep.
+     *
+     * @param [in]  os          The output stream
+     * @param [in]  dataType    The data type
+     */
+    void
+    output( std::ostream& os,
+            const IDataType& dataType );
+
+private:
+    friend class StructDataType;
+    friend class internal::StructPlan;
+
+    using Values = std::vector<IDataTypeSharedPtr>;
+
+    struct EncodeFrame;
+    struct PlanFrame;
+    struct DecodeFrame;
+    struct CompareFrame;
+    struct OutputFrame;
+
+    /**
+     * Write the body of a struct, see StructDataType::serialize()
+     */
+    void
+    serializeStruct( DataStream& stream,
+                     const StructDataType& value );
+
+    /**
+     * Write the values of a struct by its compiled plan
+     *
+     * @param [in]  stream      The data stream
+     * @param [in]  plan        The plan of the struct schema
+     * @param [in]  values      The values of the struct
+     * @param [in]  valuesOnly  Omit the names and type headers
+     */
+    void
+    encodePlan( DataStream& stream,
+                const internal::StructPlan& plan,
+                const Values& values,
+                bool valuesOnly );
+
+    /**
+     * Read the body of a struct, see StructDataType::decode()
+     */
+    DecodeError
+    decodeStruct( DataStream& stream,
+                  StructDataType& value );
+
+    /**
+     * Read the values of a struct by its compiled plan
+     *
+     * @param [in]  stream      The data stream
+     * @param [in]  plan        The plan of the struct schema
+     * @param [out] values      The values of the struct
+     * @param [in]  valuesOnly  The names and type headers were omitted
+     */
+    DecodeError
+    decodePlan( DataStream& stream,
+                const internal::StructPlan& plan,
+                Values& values,
+                bool valuesOnly );
+
+    /**
+     * Read a struct body of a schema not known in advance
+     */
+    DecodeError
+    decodeGeneric( DataStream& stream,
+                   StructDataType& value );
+
+    /**
+     * Test structs for equality, see operator==()
+     */
+    bool
+    equalsStruct( const StructDataType& lhs,
+                  const StructDataType& rhs );
+
+    /**
+     * Print a struct, see StructDataType::output()
+     */
+    void
+    outputStruct( std::ostream& os,
+                  const StructDataType& value );
+
+    /**
+     * Throw if a stack holds the maximum number of frames above a base
+     *
+     * @param [in]  size        The number of frames
+     * @param [in]  base        The number of frames of the enclosing calls
+     */
+    void
+    checkDepth( size_t size,
+                size_t base ) const;
+
+    size_t                      mMaxDepth;
+    std::vector<EncodeFrame>    mEncodeStack;
+    std::vector<PlanFrame>      mPlanStack;
+    std::vector<DecodeFrame>    mDecodeStack;
+    std::vector<CompareFrame>   mCompareStack;
+    std::vector<OutputFrame>    mOutputStack;
+};
+
+/******************************************************************************
+ * Inlined implementations
+ *****************************************************************************/
+inline size_t
+TreeEngine::getMaxDepth() const noexcept
+{
+    return mMaxDepth;
+}
+
+} // end namespace workflow::type
@@ -5,6 +5,7 @@
 #include <iosfwd>
 
 #include <workflow/utils/Error.hpp>
+#include <workflow/utils/Macros.hpp>
 #include <workflow/utils/Demangle.hpp>
 #include <workflow/utils/OutputStreamHelpers.hpp>
 
@@ -113,6 +114,13 @@ public:
     std::string
     getTypeName() const;
 
+    /**
+     * Get the demangled type name of the stored value without a copy. The
+     * name is cached, the reference stays valid for the program lifetime.
+     */
+    const std::string&
+    getCachedTypeName() const;
+
     /**
      * Test for equality
      *
@@ -150,6 +158,9 @@ public:
                 const Variant& value );
 
 private:
+    friend class JsonWriter;
+    friend class TextFormatter;
+
     class IValue;
     using IValuePtr = std::unique_ptr<IValue>;
 
@@ -224,6 +235,39 @@ private:
 /******************************************************************************
  * Inlined implementations
  *****************************************************************************/
+#if defined( WORKFLOW_STATIC ) || defined( SEQ_DEFINE_VARIANT_HOT_PATH )
+SEQ_HOT_PATH
+Variant::Variant( Variant&& other ) noexcept
+    : mValue( std::move(other.mValue) )
+{
+}
+
+SEQ_HOT_PATH Variant&
+Variant::operator=( Variant&& other ) noexcept
+{
+    std::swap(mValue, other.mValue);
+    return *this;
+}
+
+SEQ_HOT_PATH bool
+Variant::empty() const
+{
+    return nullptr == mValue;
+}
+
+SEQ_HOT_PATH void
+Variant::clear()
+{
+    mValue.reset();
+}
+
+SEQ_HOT_PATH std::type_index
+Variant::getTypeIndex() const
+{
+    return mValue ? mValue->getTypeIndex() : typeid(void);
+}
+#endif
+
 template<typename T>
 Variant::Variant( const T& value )
     : mValue( std::make_unique<Value<std::decay_t<T>>>( value ) )
@@ -237,10 +281,11 @@ Variant::get() const
     SEQ_ASSERT_INVARIANT( mValue, "Cannot access empty variant" );
     SEQ_ASSERT_ARGUMENT( mValue->getTypeIndex() == typeid(std::decay_t<T>),
                          "cannot convert variant of '"
-                         << utils::demangle(mValue->getTypeIndex().name() )
-                         << "' to type '" << utils::demangle(typeid(T).name())
+                         << utils::demangle(mValue->getTypeIndex())
+                         << "' to type '" << utils::typeName<std::decay_t<T>>()
                          << "'" );
-    const auto& value = dynamic_cast<const Value<std::decay_t<T>>&>( *mValue );
+    // The type was checked above, no need for a dynamic_cast
+    const auto& value = static_cast<const Value<std::decay_t<T>>&>( *mValue );
     return value.mValue;
 }
 
@@ -251,10 +296,10 @@ Variant::set( const T& value )
     SEQ_ASSERT_INVARIANT( mValue, "Cannot access empty variant" );
     SEQ_ASSERT_ARGUMENT( mValue->getTypeIndex() == typeid(std::decay_t<T>),
                          "cannot convert variant of '"
-                                 << utils::demangle(mValue->getTypeIndex().name() )
-                                 << "' to type '" << utils::demangle(typeid(T).name())
+                                 << utils::demangle(mValue->getTypeIndex())
+                                 << "' to type '" << utils::typeName<std::decay_t<T>>()
                                  << "'" );
-    auto& ref = dynamic_cast<Value<std::decay_t<T>>&>( *mValue );
+    auto& ref = static_cast<Value<std::decay_t<T>>&>( *mValue );
     ref.mValue = value;
 }
 
@@ -292,7 +337,7 @@ template<typename T>
 void
 Variant::Value<T>::output( std::ostream& os ) const
 {
-    os << "<" << utils::demangle(typeid(T).name()) << ">("
+    os << "<" << utils::typeName<T>() << ">("
        << utils::Printer<T>(mValue) << ")";
 }
 
@@ -1,10 +1,16 @@
 #pragma once
 
+#include <workflow/utils/Hash.hpp>
+
 #include <workflow/type/Variant.hpp>
 #include <workflow/type/IDataType.hpp>
 
 namespace workflow::type {
 
+namespace internal {
+class StructPlan;
+} // end namespace internal
+
 /**
  * A primitive type encapsulates all types that can be created with a Variant.
  * The engine will not be able to inspect these kind of types, So they must
@@ -29,12 +35,29 @@ public:
     explicit
     VariantDataType(DataStream& stream);
 
+    /**
+     * Deserialize from data stream without throwing on malformed data
+     *
+     * @param [in]  stream      The data stream
+     *
+     * @return The variant data type or the reason of the failure
+     */
+    static utils::Expected<std::unique_ptr<VariantDataType>, DecodeError>
+    tryDeserialize( DataStream& stream );
+
     /**
      * Get variant value
      */
     Variant
     get() const;
 
+    /**
+     * Get variant value without a copy. The reference is valid until the
+     * value is set or the data type is destroyed.
+     */
+    const Variant&
+    getRef() const noexcept;
+
     /**
      * Set variant value. The construction type of the variant is not allowed to
      * change.
@@ -101,15 +124,41 @@ public:
     virtual bool
     equals( const IDataType& other ) const override;
 
+    virtual uint64_t
+    getContentHash() const override;
+
     virtual void
     output( std::ostream& os ) const override;
 
 private:
-    Variant mValue;
+    friend class internal::StructPlan;
+
+    /**
+     * Create empty instance to be filled by decode()
+     */
+    VariantDataType() = default;
+
+    /**
+     * Read the content from a data stream
+     *
+     * @param [in]  stream      The data stream
+     *
+     * @return DecodeError::None on success, else the reason of the failure
+     */
+    DecodeError
+    decode( DataStream& stream );
+
+    Variant             mValue;
+    utils::HashCache    mContentHash;
 };
 
 /******************************************************************************
  * Inlined implementations
  *****************************************************************************/
+inline const Variant&
+VariantDataType::getRef() const noexcept
+{
+    return mValue;
+}
 
 } // end namespace workflow::type
\ No newline at end of file
@@ -125,6 +125,26 @@ public:
     const IVariantMethods&
     get( const Hash& hash ) const;
 
+    /**
+     * Find variant methods responsible for a Variant. Does not throw.
+     *
+     * @param [in]  type        Type index
+     *
+     * @return Variant methods or nullptr if not registered
+     */
+    const IVariantMethods*
+    find( const std::type_index& type ) const noexcept;
+
+    /**
+     * Find variant methods responsible for a Variant. Does not throw.
+     *
+     * @param [in]  hash        Type hash
+     *
+     * @return Variant methods or nullptr if not registered
+     */
+    const IVariantMethods*
+    find( const Hash& hash ) const noexcept;
+
     /**
      * Get methods to type
      *
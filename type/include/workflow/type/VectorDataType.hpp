@@ -1,23 +1,286 @@
 #pragma once
 
 #include <vector>
+#include <memory>
+#include <iterator>
+#include <typeindex>
+#include <type_traits>
+
+#include <workflow/utils/Hash.hpp>
+#include <workflow/utils/Span.hpp>
 
 #include <workflow/type/IDataType.hpp>
 #include <workflow/type/Variant.hpp>
 
 namespace workflow::type {
 
+class IVariantMethods;
+
+/**
+ * A sequence of values which all have the same variant type. The element type
+ * is fixed on construction.
+ * Values of type bool, std::string, float, double and the fixed size integer
+ * types are stored in a typed std::vector, the numeric ones contiguous. All
+ * other registered variant types are stored as Variant.
+ */
 class VectorDataType : public IDataType
 {
 public:
+    /**
+     * Create empty vector
+     *
+     * @param [in]  value       A value of the element type
+     */
     VectorDataType( const Variant& value );
 
+    /**
+     * Construct from data stream
+     *
+     * @param [in]  stream      The data stream
+     */
     VectorDataType( DataStream& stream );
 
+    /**
+     * Deserialize from data stream without throwing on malformed data
+     *
+     * @param [in]  stream      The data stream
+     *
+     * @return The vector data type or the reason of the failure
+     */
+    static utils::Expected<std::unique_ptr<VectorDataType>, DecodeError>
+    tryDeserialize( DataStream& stream );
+
     using VariantVector = std::vector<Variant>;
 
-    // WIP provide STL compatible interface. But: Do not expose in a way that
-    // variants of a different type can be set
+    /**
+     * Read only iterator over the elements, boxed into Variant. Prefer the
+     * typed iterators begin<T>() and end<T>() for the built in types.
+     */
+    class ConstIterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Variant;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Variant;
+
+        ConstIterator( const VectorDataType* vector,
+                       size_t index );
+
+        Variant
+        operator*() const;
+
+        ConstIterator&
+        operator++();
+
+        ConstIterator
+        operator++( int );
+
+        friend bool
+        operator==( const ConstIterator& lhs,
+                    const ConstIterator& rhs );
+
+        friend bool
+        operator!=( const ConstIterator& lhs,
+                    const ConstIterator& rhs );
+
+    private:
+        const VectorDataType*   mVector;
+        size_t                  mIndex;
+    };
+
+    using value_type = Variant;
+    using size_type = size_t;
+    using const_iterator = ConstIterator;
+
+    /**
+     * Get the element type
+     */
+    std::type_index
+    getElementType() const;
+
+    /**
+     * Get the number of elements
+     */
+    size_t
+    size() const;
+
+    /**
+     * Test if the vector has no elements
+     */
+    bool
+    empty() const;
+
+    /**
+     * Remove all elements
+     */
+    void
+    clear();
+
+    /**
+     * Reserve memory for elements
+     *
+     * @param [in]  capacity    The number of elements to reserve memory for
+     */
+    void
+    reserve( size_t capacity );
+
+    /**
+     * Append element. It must be of the element type.
+     *
+     * @param [in]  value       The value
+     */
+    void
+    push_back( const Variant& value );
+
+    /**
+     * Append element. T must be the element type.
+     *
+     * @tparam T                The value type
+     * @param [in]  value       The value
+     */
+    template<typename T>
+    void
+    push_back( const T& value );
+
+    /**
+     * Append element constructed in place. T must be the element type.
+     *
+     * @tparam T                The element type
+     * @param [in]  args        Constructor arguments
+     */
+    template<typename T, typename... Args>
+    void
+    emplace_back( Args&&... args );
+
+    /**
+     * Get element boxed into a Variant. The index is not checked.
+     *
+     * @param [in]  index       The element index
+     *
+     * @return The element
+     */
+    Variant
+    operator[]( size_t index ) const;
+
+    /**
+     * Get element boxed into a Variant
+     *
+     * @param [in]  index       The element index
+     *
+     * @return The element
+     */
+    Variant
+    at( size_t index ) const;
+
+    /**
+     * Get element. T must be the element type.
+     *
+     * @tparam T                The element type
+     * @param [in]  index       The element index
+     *
+     * @return The element
+     */
+    template<typename T>
+    T
+    get( size_t index ) const;
+
+    /**
+     * Replace element. It must be of the element type.
+     *
+     * @param [in]  index       The element index
+     * @param [in]  value       The value
+     */
+    void
+    set( size_t index,
+         const Variant& value );
+
+    /**
+     * Replace element. T must be the element type.
+     *
+     * @tparam T                The element type
+     * @param [in]  index       The element index
+     * @param [in]  value       The value
+     */
+    template<typename T>
+    void
+    set( size_t index,
+         const T& value );
+
+    /**
+     * Get iterator to the first element
+     */
+    ConstIterator
+    begin() const;
+
+    /**
+     * Get iterator behind the last element
+     */
+    ConstIterator
+    end() const;
+
+    /**
+     * Get typed iterator to the first element. Available for the built in
+     * types only, T must be the element type.
+     *
+     * @tparam T    The element type
+     */
+    template<typename T>
+    typename std::vector<T>::const_iterator
+    begin() const;
+
+    /**
+     * Get typed iterator behind the last element. Available for the built in
+     * types only, T must be the element type.
+     *
+     * @tparam T    The element type
+     */
+    template<typename T>
+    typename std::vector<T>::const_iterator
+    end() const;
+
+    /**
+     * Get mutable typed iterator to the first element. Available for the
+     * built in types only, T must be the element type.
+     *
+     * @tparam T    The element type
+     */
+    template<typename T>
+    typename std::vector<T>::iterator
+    begin();
+
+    /**
+     * Get mutable typed iterator behind the last element. Available for the
+     * built in types only, T must be the element type.
+     *
+     * @tparam T    The element type
+     */
+    template<typename T>
+    typename std::vector<T>::iterator
+    end();
+
+    /**
+     * Get read only access to the contiguous elements
+     *
+     * @tparam T    The element type. Must be a numeric type.
+     *
+     * @return The elements
+     */
+    template<typename T>
+    utils::Span<const T>
+    getSpan() const;
+
+    /**
+     * Get access to the contiguous elements
+     *
+     * @tparam T    The element type. Must be a numeric type.
+     *
+     * @return The elements
+     */
+    template<typename T>
+    utils::Span<T>
+    getSpan();
 
     /**
      * Test for equality
@@ -64,12 +327,399 @@ public:
     virtual bool
     equals( const IDataType& other ) const override;
 
+    /**
+     * Hash of the element type and the elements. Contiguous elements are
+     * hashed as raw bytes in a single pass.
+     */
+    virtual uint64_t
+    getContentHash() const override;
+
     virtual void
     output( std::ostream& os ) const override;
 
 private:
-    Variant         mType;
-    VariantVector   mValues;
+    friend class JsonReader;
+    friend class ParallelDecoder;
+
+    /**
+     * Interface of the element storage
+     */
+    struct IStorage
+    {
+        virtual
+        ~IStorage() = default;
+
+        /**
+         * Get number of elements
+         */
+        virtual size_t
+        size() const = 0;
+
+        /**
+         * Remove all elements
+         */
+        virtual void
+        clear() = 0;
+
+        /**
+         * Reserve memory
+         *
+         * @param [in]  capacity    Number of elements
+         */
+        virtual void
+        reserve( size_t capacity ) = 0;
+
+        /**
+         * Get element as variant
+         *
+         * @param [in]  index       The element index
+         */
+        virtual Variant
+        get( size_t index ) const = 0;
+
+        /**
+         * Replace element. The type was checked by the caller.
+         *
+         * @param [in]  index       The element index
+         * @param [in]  value       The value
+         */
+        virtual void
+        set( size_t index,
+             const Variant& value ) = 0;
+
+        /**
+         * Append element. The type was checked by the caller.
+         *
+         * @param [in]  value       The value
+         */
+        virtual void
+        push_back( const Variant& value ) = 0;
+
+        /**
+         * Write all elements to the stream
+         *
+         * @param [in]  stream      The stream
+         * @param [in]  methods     Methods of the element type
+         */
+        virtual void
+        serialize( DataStream& stream,
+                   const IVariantMethods& methods ) const = 0;
+
+        /**
+         * Read elements from the stream
+         *
+         * @param [in]  stream      The stream
+         * @param [in]  methods     Methods of the element type
+         * @param [in]  count       Number of elements to read
+         *
+         * @return DecodeError::None on success, else the reason of the failure
+         */
+        virtual DecodeError
+        deserialize( DataStream& stream,
+                     const IVariantMethods& methods,
+                     uint32_t count ) = 0;
+
+        /**
+         * Compare elements for equality
+         *
+         * @param [in]  other       The storage to compare with. Must have the
+         *                          same element type.
+         */
+        virtual bool
+        equals( const IStorage& other ) const = 0;
+
+        /**
+         * Feed all elements into a hasher
+         *
+         * @param [in]  hasher      The hasher
+         * @param [in]  methods     Methods of the element type
+         */
+        virtual void
+        hash( utils::Hasher& hasher,
+              const IVariantMethods& methods ) const = 0;
+
+        /**
+         * Write elements to output stream
+         *
+         * @param [in]  os          The stream
+         */
+        virtual void
+        output( std::ostream& os ) const = 0;
+    };
+    using IStoragePtr = std::unique_ptr<IStorage>;
+
+    /**
+     * Storage for the built in types
+     *
+     * @tparam T    The element type
+     */
+    template<typename T>
+    struct Storage : public IStorage
+    {
+        virtual size_t
+        size() const override;
+
+        virtual void
+        clear() override;
+
+        virtual void
+        reserve( size_t capacity ) override;
+
+        virtual Variant
+        get( size_t index ) const override;
+
+        virtual void
+        set( size_t index,
+             const Variant& value ) override;
+
+        virtual void
+        push_back( const Variant& value ) override;
+
+        virtual void
+        serialize( DataStream& stream,
+                   const IVariantMethods& methods ) const override;
+
+        virtual DecodeError
+        deserialize( DataStream& stream,
+                     const IVariantMethods& methods,
+                     uint32_t count ) override;
+
+        virtual bool
+        equals( const IStorage& other ) const override;
+
+        virtual void
+        hash( utils::Hasher& hasher,
+              const IVariantMethods& methods ) const override;
+
+        virtual void
+        output( std::ostream& os ) const override;
+
+        std::vector<T> mValues;
+    };
+
+    /**
+     * Storage for all other variant types
+     */
+    struct VariantStorage;
+
+    /**
+     * True for the element types stored in Storage<T>
+     */
+    template<typename T>
+    static constexpr bool IS_TYPED = std::is_same_v<T, bool>
+                                  || std::is_same_v<T, uint8_t>
+                                  || std::is_same_v<T, uint16_t>
+                                  || std::is_same_v<T, uint32_t>
+                                  || std::is_same_v<T, uint64_t>
+                                  || std::is_same_v<T, int8_t>
+                                  || std::is_same_v<T, int16_t>
+                                  || std::is_same_v<T, int32_t>
+                                  || std::is_same_v<T, int64_t>
+                                  || std::is_same_v<T, float>
+                                  || std::is_same_v<T, double>
+                                  || std::is_same_v<T, std::string>;
+
+    /**
+     * Create empty instance to be filled by decode()
+     */
+    VectorDataType() = default;
+
+    /**
+     * Read the content from a data stream
+     *
+     * @param [in]  stream      The data stream
+     *
+     * @return DecodeError::None on success, else the reason of the failure
+     */
+    DecodeError
+    decode( DataStream& stream );
+
+    /**
+     * Create the storage for an element type
+     *
+     * @param [in]  type        The element type
+     */
+    static IStoragePtr
+    createStorage( const std::type_index& type );
+
+    /**
+     * Throw if T is not the element type
+     */
+    template<typename T>
+    void
+    checkType() const;
+
+    /**
+     * Throw if the value is not of the element type
+     *
+     * @param [in]  value       The value
+     */
+    void
+    checkType( const Variant& value ) const;
+
+    /**
+     * Get typed storage. Throws if T is not the element type.
+     */
+    template<typename T>
+    const Storage<T>&
+    getStorage() const;
+
+    /**
+     * Get typed storage. Throws if T is not the element type.
+     */
+    template<typename T>
+    Storage<T>&
+    getStorage();
+
+    Variant             mType;
+    IStoragePtr         mStorage;
+    utils::HashCache    mContentHash;
 };
 
-} // end namespace workflow::type
\ No newline at end of file
+/******************************************************************************
+ * Inlined implementations
+ *****************************************************************************/
+template<typename T>
+void
+VectorDataType::checkType() const
+{
+    SEQ_ASSERT_ARGUMENT( mType.getTypeIndex() == typeid(T), "Cannot access vector of '"
+                         << mType.getTypeName() << "' as '" << utils::typeName<T>() << "'" );
+}
+
+template<typename T>
+const VectorDataType::Storage<T>&
+VectorDataType::getStorage() const
+{
+    static_assert( IS_TYPED<T>, "Typed access is available for the built in types only" );
+    checkType<T>();
+    return static_cast<const Storage<T>&>( *mStorage );
+}
+
+template<typename T>
+VectorDataType::Storage<T>&
+VectorDataType::getStorage()
+{
+    static_assert( IS_TYPED<T>, "Typed access is available for the built in types only" );
+    checkType<T>();
+    return static_cast<Storage<T>&>( *mStorage );
+}
+
+template<typename T>
+void
+VectorDataType::push_back( const T& value )
+{
+    if constexpr ( IS_TYPED<T> )
+    {
+        getStorage<T>().mValues.push_back( value );
+        mContentHash.reset();
+    }
+    else
+    {
+        push_back( Variant( value ) );
+    }
+}
+
+template<typename T, typename... Args>
+void
+VectorDataType::emplace_back( Args&&... args )
+{
+    if constexpr ( IS_TYPED<T> )
+    {
+        getStorage<T>().mValues.emplace_back( std::forward<Args>(args)... );
+        mContentHash.reset();
+    }
+    else
+    {
+        push_back( Variant( T( std::forward<Args>(args)... ) ) );
+    }
+}
+
+template<typename T>
+T
+VectorDataType::get( size_t index ) const
+{
+    if constexpr ( IS_TYPED<T> )
+    {
+        const auto& values = getStorage<T>().mValues;
+        SEQ_ASSERT_ARGUMENT( index < values.size(), "Index " << index << " out of range" );
+        return values[index];
+    }
+    else
+    {
+        return at( index ).template get<T>();
+    }
+}
+
+template<typename T>
+void
+VectorDataType::set( size_t index,
+                     const T& value )
+{
+    if constexpr ( IS_TYPED<T> )
+    {
+        auto& values = getStorage<T>().mValues;
+        SEQ_ASSERT_ARGUMENT( index < values.size(), "Index " << index << " out of range" );
+        values[index] = value;
+        mContentHash.reset();
+    }
+    else
+    {
+        set( index, Variant( value ) );
+    }
+}
+
+template<typename T>
+typename std::vector<T>::const_iterator
+VectorDataType::begin() const
+{
+    return getStorage<T>().mValues.begin();
+}
+
+template<typename T>
+typename std::vector<T>::const_iterator
+VectorDataType::end() const
+{
+    return getStorage<T>().mValues.end();
+}
+
+template<typename T>
+typename std::vector<T>::iterator
+VectorDataType::begin()
+{
+    auto& storage = getStorage<T>();
+    mContentHash.reset();
+    return storage.mValues.begin();
+}
+
+template<typename T>
+typename std::vector<T>::iterator
+VectorDataType::end()
+{
+    auto& storage = getStorage<T>();
+    mContentHash.reset();
+    return storage.mValues.end();
+}
+
+template<typename T>
+utils::Span<const T>
+VectorDataType::getSpan() const
+{
+    static_assert( std::is_arithmetic_v<T> && !std::is_same_v<T, bool>,
+                   "Only numeric types are stored contiguously" );
+    const auto& storage = getStorage<T>();
+    return { storage.mValues.data(), storage.mValues.size() };
+}
+
+template<typename T>
+utils::Span<T>
+VectorDataType::getSpan()
+{
+    static_assert( std::is_arithmetic_v<T> && !std::is_same_v<T, bool>,
+                   "Only numeric types are stored contiguously" );
+    auto& storage = getStorage<T>();
+    mContentHash.reset();
+    return { storage.mValues.data(), storage.mValues.size() };
+}
+
+} // end namespace workflow::type
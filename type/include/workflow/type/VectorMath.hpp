@@ -0,0 +1,246 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <type_traits>
+
+#include <workflow/utils/Span.hpp>
+
+#include <workflow/type/Variant.hpp>
+
+namespace workflow::type {
+
+class VectorDataType;
+
+/**
+ * Numeric kernels over contiguous elements. The kernels are vectorized with
+ * AVX2 or AVX-512, selected at runtime by the capabilities of the CPU. A scalar
+ * implementation is used on all other platforms.
+ * The kernels are available for all numeric types registered by the
+ * VariantMethodsManager: uint8_t, uint16_t, uint32_t, uint64_t, int8_t,
+ * int16_t, int32_t, int64_t, float and double. Integer arithmetic wraps around,
+ * the result for NaN values is unspecified.
+ */
+namespace math {
+
+/**
+ * Instruction set used by the kernels
+ */
+enum class SimdLevel : uint8_t
+{
+    Scalar,
+    Avx2,
+    Avx512
+};
+
+/**
+ * Comparison of the threshold compare kernel
+ */
+enum class Compare : uint8_t
+{
+    Less,
+    LessEqual,
+    Greater,
+    GreaterEqual,
+    Equal,
+    NotEqual
+};
+
+/**
+ * Type used to accumulate sums of T: double for floating point types, else
+ * the 64 bit integer type of the same signedness
+ */
+template<typename T>
+using SumType = std::conditional_t<std::is_floating_point_v<T>, double,
+                                   std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>>;
+
+/**
+ * Get the best instruction set supported by the CPU
+ */
+SimdLevel
+getSupportedSimdLevel() noexcept;
+
+/**
+ * Get the instruction set used by the kernels
+ */
+SimdLevel
+getSimdLevel() noexcept;
+
+/**
+ * Restrict the instruction set used by the kernels. Levels not supported by
+ * the CPU are lowered to the best supported one.
+ *
+ * @param [in]  level       The instruction set
+ */
+void
+setSimdLevel( SimdLevel level ) noexcept;
+
+/**
+ * Sum of all values, 0 if empty
+ *
+ * @param [in]  values      The values
+ */
+template<typename T>
+SumType<T>
+sum( utils::Span<const T> values );
+
+/**
+ * Arithmetic mean. Throws if empty.
+ *
+ * @param [in]  values      The values
+ */
+template<typename T>
+double
+mean( utils::Span<const T> values );
+
+/**
+ * Minimum and maximum value. Throws if empty.
+ *
+ * @param [in]  values      The values
+ *
+ * @return Pair of minimum and maximum
+ */
+template<typename T>
+std::pair<T, T>
+minMax( utils::Span<const T> values );
+
+/**
+ * Dot product. Throws if the sizes differ.
+ *
+ * @param [in]  lhs         Left operand
+ * @param [in]  rhs         Right operand
+ */
+template<typename T>
+SumType<T>
+dot( utils::Span<const T> lhs,
+     utils::Span<const T> rhs );
+
+/**
+ * Test if both sequences hold equal values. Integers are compared bytewise,
+ * floating point values with operator==.
+ *
+ * @param [in]  lhs         Left operand
+ * @param [in]  rhs         Right operand
+ */
+template<typename T>
+bool
+equal( utils::Span<const T> lhs,
+       utils::Span<const T> rhs );
+
+/**
+ * Replace every value x by x * scale + offset
+ *
+ * @param [in]  values      The values
+ * @param [in]  scale       The scale
+ * @param [in]  offset      The offset
+ */
+template<typename T>
+void
+scaleOffset( utils::Span<T> values,
+             T scale,
+             T offset );
+
+/**
+ * Limit every value to [low, high]. Throws if low > high.
+ *
+ * @param [in]  values      The values
+ * @param [in]  low         Lower bound
+ * @param [in]  high        Upper bound
+ */
+template<typename T>
+void
+clamp( utils::Span<T> values,
+       T low,
+       T high );
+
+/**
+ * Compare every value against a threshold
+ *
+ * @param [in]  values      The values
+ * @param [in]  op          The comparison
+ * @param [in]  threshold   The threshold, right operand of the comparison
+ *
+ * @return Bitmask, bit i % 64 of word i / 64 is set if value i matches
+ */
+template<typename T>
+std::vector<uint64_t>
+compare( utils::Span<const T> values,
+         Compare op,
+         T threshold );
+
+/**
+ * Sum of all elements, as Variant of SumType of the element type
+ *
+ * @param [in]  vector      Vector of numeric elements
+ */
+Variant
+sum( const VectorDataType& vector );
+
+/**
+ * Arithmetic mean of all elements. Throws if empty.
+ *
+ * @param [in]  vector      Vector of numeric elements
+ */
+double
+mean( const VectorDataType& vector );
+
+/**
+ * Minimum and maximum element. Throws if empty.
+ *
+ * @param [in]  vector      Vector of numeric elements
+ */
+std::pair<Variant, Variant>
+minMax( const VectorDataType& vector );
+
+/**
+ * Dot product, as Variant of SumType of the element type. Throws if the
+ * element types or the sizes differ.
+ *
+ * @param [in]  lhs         Left operand
+ * @param [in]  rhs         Right operand
+ */
+Variant
+dot( const VectorDataType& lhs,
+     const VectorDataType& rhs );
+
+/**
+ * Replace every element x by x * scale + offset
+ *
+ * @param [in]  vector      Vector of numeric elements
+ * @param [in]  scale       The scale, of the element type
+ * @param [in]  offset      The offset, of the element type
+ */
+void
+scaleOffset( VectorDataType& vector,
+             const Variant& scale,
+             const Variant& offset );
+
+/**
+ * Limit every element to [low, high]
+ *
+ * @param [in]  vector      Vector of numeric elements
+ * @param [in]  low         Lower bound, of the element type
+ * @param [in]  high        Upper bound, of the element type
+ */
+void
+clamp( VectorDataType& vector,
+       const Variant& low,
+       const Variant& high );
+
+/**
+ * Compare every element against a threshold
+ *
+ * @param [in]  vector      Vector of numeric elements
+ * @param [in]  op          The comparison
+ * @param [in]  threshold   The threshold, of the element type
+ *
+ * @return Bitmask, bit i % 64 of word i / 64 is set if element i matches
+ */
+std::vector<uint64_t>
+compare( const VectorDataType& vector,
+         Compare op,
+         const Variant& threshold );
+
+} // end namespace math
+} // end namespace workflow::type
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+#include <workflow/utils/Error.hpp>
+#include <workflow/utils/Overloaded.hpp>
+
+#include <workflow/type/IDataType.hpp>
+#include <workflow/type/VariantDataType.hpp>
+#include <workflow/type/StructDataType.hpp>
+#include <workflow/type/VectorDataType.hpp>
+
+namespace workflow::type {
+
+/**
+ * Call a function with the concrete type of a data type. Dispatches on
+ * IDataType::getType() instead of a virtual visitor, so the function can be
+ * a set of lambdas, see utils::Overloaded, which the compiler inlines. The
+ * function must return the same type for all data types.
+ *
+ *     auto size = visit( type, utils::Overloaded{
+ *         []( const VectorDataType& vector ){ return vector.size(); },
+ *         []( const auto& ){ return size_t(0); } } );
+ *
+ * @param [in]  node        The data type, constness is forwarded
+ * @param [in]  function    Callable with VariantDataType, StructDataType and
+ *                          VectorDataType references
+ *
+ * @return The result of the function
+ */
+template<typename T, typename F>
+decltype(auto)
+visit( T& node,
+       F&& function );
+
+/**
+ * Call a function for a data type and all struct attributes below it, depth
+ * first with parents before their attributes. If the function returns bool,
+ * false skips the attributes of the node.
+ *
+ * @param [in]  node        The root data type, constness is forwarded
+ * @param [in]  function    Callable with VariantDataType, StructDataType and
+ *                          VectorDataType references
+ */
+template<typename T, typename F>
+void
+walk( T& node,
+      F&& function );
+
+/******************************************************************************
+ * Inlined implementations
+ *****************************************************************************/
+template<typename T, typename F>
+inline decltype(auto)
+visit( T& node,
+       F&& function )
+{
+    static_assert( std::is_same_v<std::remove_const_t<T>, IDataType>, "Visit an IDataType" );
+    constexpr bool IS_CONST = std::is_const_v<T>;
+    using VariantType = std::conditional_t<IS_CONST, const VariantDataType, VariantDataType>;
+    using StructType = std::conditional_t<IS_CONST, const StructDataType, StructDataType>;
+    using VectorType = std::conditional_t<IS_CONST, const VectorDataType, VectorDataType>;
+
+    switch ( node.getType() )
+    {
+        case IDataType::Type::Variant:
+            return std::forward<F>(function)( static_cast<VariantType&>( node ) );
+
+        case IDataType::Type::Struct:
+            return std::forward<F>(function)( static_cast<StructType&>( node ) );
+
+        case IDataType::Type::Vector:
+            return std::forward<F>(function)( static_cast<VectorType&>( node ) );
+    }
+    SEQ_ASSERT_INVARIANT( false, "Unknown data type" );
+}
+
+template<typename T, typename F>
+inline void
+walk( T& node,
+      F&& function )
+{
+    visit( node, [&function]( auto& type )
+    {
+        using Type = std::remove_reference_t<decltype(type)>;
+        if constexpr ( std::is_same_v<bool, std::invoke_result_t<F&, Type&>> )
+        {
+            if ( !function( type ) )
+            {
+                return;
+            }
+        }
+        else
+        {
+            function( type );
+        }
+
+        if constexpr ( std::is_same_v<std::remove_const_t<Type>, StructDataType> )
+        {
+            const size_t size = type.getAttributeNames().size();
+            for ( size_t i = 0; i < size; ++i )
+            {
+                walk( type.get( i ), function );
+            }
+        }
+    } );
+}
+
+} // end namespace workflow::type
@@ -1,177 +1,102 @@
+// Out of line definitions of the hot paths for the shared library
+#define SEQ_DEFINE_DATASTREAM_HOT_PATH
 #include <workflow/type/DataStream.hpp>
 
 #include <algorithm>
-
-#ifdef __MINGW32__
-#include <sys/param.h>
-#endif
+#include <limits>
 
 #include <workflow/utils/Error.hpp>
 
+#include <internal/SchemaDictionary.hpp>
+
 namespace workflow::type {
 namespace {
 
-enum class ByteOrder
-{
-    LittleEndian,
-    BigEndian
-};
-
-constexpr ByteOrder NETWORK_BYTEORDER = ByteOrder::LittleEndian;
-
-#ifdef __MINGW32__
-#if (BYTE_ORDER == LITTLE_ENDIAN)
-    constexpr ByteOrder HOST_BYTEORDER = ByteOrder::LittleEndian;
-#else
-    constexpr ByteOrder HOST_BYTEORDER = ByteOrder::Big;
-#endif
-#else
-#   error Add compiler support
-#endif
-
-template<typename T>
-void
-byteSwap( T& value )
-{
-    uint8_t* begin = reinterpret_cast<uint8_t>( &value );
-    uint8_t* end = reinterpret_cast<uint8_t>( &value ) + sizeof(T);
-    std::reverse( begin, end );
-}
-
-template<enum ByteOrder HOST, enum ByteOrder DEST>
-struct Swapper
-{
-    template<typename T>
-    void
-    operator()( T& value )
-    {
-        if constexpr ( HOST != DEST )
-        {
-            byteSwap<T>( value );
-        }
-    }
-};
-
-using ByteSwapper = Swapper<HOST_BYTEORDER, NETWORK_BYTEORDER>;
-
-enum class SerializerTypes : uint8_t
-{
-    Invalid     = 255,
-    Bool        = 0,
-    UInt8,
-    UInt16,
-    UInt32,
-    UInt64,
-    SInt8,
-    SInt16,
-    SInt32,
-    SInt64,
-    IEEE32,     // float
-    IEEE64      // double
-};
-
-template<enum SerializerTypes S, typename T>
-void
-doWrite( DataStream& stream,
-         T value )
-{
-    constexpr uint8_t TYPE = static_cast<uint8_t>(S);
-
-    stream.write( sizeof(TYPE), &TYPE );
-    ByteSwapper()( value );
-    stream.write( sizeof(value), &value );
-}
-
-template<enum SerializerTypes S, typename T>
-void
-doRead( DataStream& stream,
-        T& value )
-{
-    uint8_t type = static_cast<uint8_t>(SerializerTypes::Invalid);
-    stream.read( sizeof(type), &type );
-    SEQ_ASSERT_INVARIANT( type == static_cast<uint8_t>(S),
-                          "Invalid stream: Expected type '"
-                          << static_cast<uint16_t>(S) << "' but got '"
-                          << static_cast<uint16_t>(type)  << "'" );
-
-    stream.read( sizeof(value), &value );
-    ByteSwapper()( value );
-}
+// Strings of unknown availability are read in chunks of this size, so memory
+// grows with the data that is actually received
+constexpr size_t STRING_CHUNK_SIZE = 64 * 1024;
 
+// Reserve hint used when the backend cannot tell the available data
+constexpr size_t UNKNOWN_SIZE_RESERVE = 4096;
 
 } // end namespace
 
 DataStream::DataStream( IDataStreamUniquePtr backend )
     : mBackend( std::move(backend) )
+    , mBytesRead( 0 )
+    , mDepth( 0 )
 {
     SEQ_ASSERT_ARGUMENT( mBackend, "Invalid backend" );
 }
 
-void
-DataStream::write( bool value )
-{
-    const uint8_t VALUE = value ? 1 : 0;
-    doWrite<SerializerTypes::Bool>( *this, VALUE );
-}
-
-void
-DataStream::write( uint8_t value )
-{
-    doWrite<SerializerTypes::UInt8>( *this, value );
-}
-
-void
-DataStream::write( uint16_t value )
-{
-    doWrite<SerializerTypes::UInt16>( *this, value );
-}
+DataStream::~DataStream() = default;
 
 void
-DataStream::write( uint32_t value )
+DataStream::setSchemaDictionary( bool enabled )
 {
-    doWrite<SerializerTypes::UInt32>( *this, value );
+    if ( !enabled )
+    {
+        mSchemaDictionary.reset();
+    }
+    else if ( !mSchemaDictionary )
+    {
+        mSchemaDictionary = std::make_unique<internal::SchemaDictionary>();
+    }
 }
 
-void
-DataStream::write( uint64_t value )
+bool
+DataStream::hasSchemaDictionary() const noexcept
 {
-    doWrite<SerializerTypes::UInt64>( *this, value );
+    return !!mSchemaDictionary;
 }
 
 void
-DataStream::write( int8_t value )
+DataStream::setLimits( const DecodeLimits& limits )
 {
-    doWrite<SerializerTypes::SInt8>( *this, value );
+    mLimits = limits;
 }
 
-void
-DataStream::write( int16_t value )
+const DecodeLimits&
+DataStream::getLimits() const
 {
-    doWrite<SerializerTypes::SInt16>( *this, value );
+    return mLimits;
 }
 
-void
-DataStream::write( int32_t value )
+uint64_t
+DataStream::getBytesRead() const
 {
-    doWrite<SerializerTypes::SInt32>( *this, value );
+    return mBytesRead;
 }
 
-void
-DataStream::write( int64_t value )
+size_t
+DataStream::getReserveHint( uint64_t count,
+                            size_t minElementSize ) const
 {
-    doWrite<SerializerTypes::SInt64>( *this, value );
+    const size_t available = this->available();
+    if ( std::numeric_limits<size_t>::max() == available )
+    {
+        return static_cast<size_t>( std::min<uint64_t>( count, UNKNOWN_SIZE_RESERVE ) );
+    }
+    return static_cast<size_t>( std::min<uint64_t>( count,
+                                    available / std::max<size_t>( minElementSize, 1 ) ) );
 }
 
-void
-DataStream::write( float value )
+DecodeError
+DataStream::enterNested()
 {
-    doWrite<SerializerTypes::IEEE32>( *this, value );
+    if ( mDepth >= mLimits.maxDepth )
+    {
+        return DecodeError::NestingTooDeep;
+    }
+    ++mDepth;
+    return DecodeError::None;
 }
 
 void
-DataStream::write( double value )
+DataStream::leaveNested()
 {
-    doWrite<SerializerTypes::IEEE64>( *this, value );
+    SEQ_ASSERT_INVARIANT( mDepth > 0, "Unbalanced leaveNested()" );
+    --mDepth;
 }
 
 void
@@ -182,99 +107,148 @@ DataStream::write( const std::string& value )
 
     uint32_t length = static_cast<uint32_t>( value.size() );
     write( length );
-    write( length, value.data() );
+    if ( length )
+    {
+        write( length, value.data() );
+    }
 }
 
 void
-DataStream::read( bool& value )
+DataStream::read( std::string& value )
 {
-    uint8_t tmp = 0;
-    doRead<SerializerTypes::Bool>( *this, tmp );
-    SEQ_ASSERT_INVARIANT( tmp == 0 || tmp == 1, "Invalid stream. Unexpected byte value" );
-    value = !!tmp;
+    auto error = tryRead( value );
+    SEQ_ASSERT_INVARIANT( DecodeError::None == error, "Failed to read string: " << error );
 }
 
-void
-DataStream::read( uint8_t& value )
+DecodeError
+DataStream::tryRead( std::string& value )
 {
-    doRead<SerializerTypes::UInt8>( *this, value );
-}
+    uint32_t length = 0;
+    auto error = tryRead( length );
+    if ( DecodeError::None != error )
+    {
+        return error;
+    }
+    if ( length > mLimits.maxStringLength )
+    {
+        return DecodeError::StringTooLong;
+    }
+    if ( !withinTotalLimit( length ) )
+    {
+        return DecodeError::TotalSizeExceeded;
+    }
 
-void
-DataStream::read( uint16_t& value )
-{
-    doRead<SerializerTypes::UInt16>( *this, value );
-}
+    // Never allocate more than the stream is able to deliver
+    const size_t available = this->available();
+    if ( length > available )
+    {
+        return DecodeError::EndOfStream;
+    }
 
-void
-DataStream::read( uint32_t& value )
-{
-    doRead<SerializerTypes::UInt32>( *this, value );
+    if ( length <= STRING_CHUNK_SIZE || std::numeric_limits<size_t>::max() != available )
+    {
+        value.resize( length );
+        if ( length && !readRaw( length, value.data() ) )
+        {
+            return DecodeError::EndOfStream;
+        }
+        return DecodeError::None;
+    }
+
+    value.clear();
+    size_t offset = 0;
+    while ( offset < length )
+    {
+        const size_t chunk = std::min<size_t>( STRING_CHUNK_SIZE, length - offset );
+        value.resize( offset + chunk );
+        if ( !readRaw( chunk, value.data() + offset ) )
+        {
+            return DecodeError::EndOfStream;
+        }
+        offset += chunk;
+    }
+    return DecodeError::None;
 }
 
 void
-DataStream::read( uint64_t& value )
+DataStream::write( const utils::InternedString& value )
 {
-    doRead<SerializerTypes::UInt64>( *this, value );
+    write( value.str() );
 }
 
 void
-DataStream::read( int8_t& value )
+DataStream::read( utils::InternedString& value )
 {
-    doRead<SerializerTypes::SInt8>( *this, value );
+    auto error = tryRead( value );
+    SEQ_ASSERT_INVARIANT( DecodeError::None == error, "Failed to read string: " << error );
 }
 
-void
-DataStream::read( int16_t& value )
+DecodeError
+DataStream::tryRead( utils::InternedString& value )
 {
-    doRead<SerializerTypes::SInt16>( *this, value );
+    auto error = tryRead( mScratch );
+    if ( DecodeError::None != error )
+    {
+        return error;
+    }
+    value = utils::InternedString( mScratch );
+    return DecodeError::None;
 }
 
 void
-DataStream::read( int32_t& value )
+DataStream::write( const size_t length,
+                   const void* data )
 {
-    doRead<SerializerTypes::SInt32>( *this, value );
+    mBackend->write( length, data );
 }
 
 void
-DataStream::read( int64_t& value )
+DataStream::read( const size_t length,
+                  void* data )
 {
-    doRead<SerializerTypes::SInt64>( *this, value );
+    SEQ_ASSERT_INVARIANT( withinTotalLimit( length ), "Invalid stream: "
+                          << DecodeError::TotalSizeExceeded );
+    mBackend->read( length, data );
+    mBytesRead += length;
 }
 
-void
-DataStream::read( float& value )
+bool
+DataStream::tryRead( const size_t length,
+                     void* data )
 {
-    doRead<SerializerTypes::IEEE32>( *this, value );
+    return readRaw( length, data );
 }
 
-void
-DataStream::read( double& value )
+bool
+DataStream::trySkip( const size_t length )
 {
-    doRead<SerializerTypes::IEEE64>( *this, value );
+    if ( !withinTotalLimit( length ) || !mBackend->trySkip( length ) )
+    {
+        return false;
+    }
+    mBytesRead += length;
+    return true;
 }
 
-void
-DataStream::read( std::string& value )
+size_t
+DataStream::available() const
 {
-    uint32_t length = 0;
-    read( length );
-    value.resize( length );
-    read( length, value.data() );
+    return mBackend->available();
 }
 
 void
-DataStream::write( const size_t length,
-                   const void* data )
+DataStream::writeGather( utils::Span<const utils::Span<const uint8_t>> buffers )
 {
-    mBackend->write( length, data );
+    mBackend->writeGather( buffers );
 }
 
 void
-DataStream::read( const size_t length,
-                  void* data )
+DataStream::throwDecodeError( DecodeError error )
 {
-     mBackend->read( length, data );
+    std::stringstream ss;
+    ss << "Invalid stream: " << error;
+    throw utils::Error( __FILE__, __LINE__, __PRETTY_FUNCTION__, ss.str(),
+                        utils::CommonError::InvariantFailed );
 }
 
 } // end namespace workflow::type
\ No newline at end of file
@@ -0,0 +1,370 @@
+#include <workflow/type/DataTypeView.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <workflow/utils/Error.hpp>
+
+#include <workflow/type/DataStream.hpp>
+#include <workflow/type/IVariantMethods.hpp>
+#include <workflow/type/VariantMethodsManager.hpp>
+
+#include <internal/Skip.hpp>
+#include <internal/SpanStream.hpp>
+
+namespace workflow::type {
+namespace {
+
+void
+checkError( DecodeError error )
+{
+    SEQ_ASSERT_INVARIANT( DecodeError::None == error, "Invalid stream: " << error );
+}
+
+/**
+ * Read a string without copying it
+ */
+DecodeError
+readString( DataStream& stream,
+            const internal::SpanStream& span,
+            std::string_view& value )
+{
+    uint32_t length = 0;
+    auto error = stream.tryRead( length );
+    if ( DecodeError::None != error )
+    {
+        return error;
+    }
+    if ( length > stream.getLimits().maxStringLength )
+    {
+        return DecodeError::StringTooLong;
+    }
+
+    value = std::string_view( reinterpret_cast<const char*>( span.current() ), length );
+    return stream.trySkip( length ) ? DecodeError::None : DecodeError::EndOfStream;
+}
+
+} // end namespace
+
+/******************************************************************************
+ * Shared state of all copies of a view
+ *****************************************************************************/
+struct DataTypeView::Node
+{
+    Node( Data data,
+          const DecodeLimits& limits )
+        : data( data )
+        , limits( limits )
+    {
+    }
+
+    Data                                data;
+    DecodeLimits                        limits;
+    mutable std::once_flag              flag;
+    mutable std::unique_ptr<const Index> index;
+};
+
+/******************************************************************************
+ * Offsets of the parts of the serialized data type
+ *****************************************************************************/
+struct DataTypeView::Index
+{
+    using Attribute = std::pair<std::string_view, Data>;
+
+    IDataType::Type         type = IDataType::Type::Variant;
+
+    /// Methods of the variant or the vector elements
+    const IVariantMethods*  methods = nullptr;
+
+    /// Offset of the variant value or the first vector element
+    size_t                  valueOffset = 0;
+
+    /// Name of the struct
+    std::string_view        name;
+
+    /// Attributes of the struct, ordered by name
+    std::vector<Attribute>  attributes;
+
+    /// Nodes of the views of the attributes, so their offset tables are only
+    /// built once. Views share ownership of the root node.
+    std::deque<Node>        children;
+
+    /// Number of vector elements
+    size_t                  count = 0;
+
+    /// Encoded size of each vector element if fixed, else 0
+    size_t                  stride = 0;
+
+    /// Offsets of the vector elements if they are not of fixed size
+    std::vector<size_t>     offsets;
+};
+
+/*****************************************************************************/
+DataTypeView::DataTypeView( Data data,
+                            const DecodeLimits& limits )
+    : mNode( std::make_shared<Node>( data, limits ) )
+{
+}
+
+DataTypeView::DataTypeView( std::shared_ptr<const Node> node ) noexcept
+    : mNode( std::move(node) )
+{
+}
+
+DataTypeView::Data
+DataTypeView::getData() const noexcept
+{
+    return mNode->data;
+}
+
+IDataType::Type
+DataTypeView::getType() const
+{
+    return getIndex().type;
+}
+
+std::string
+DataTypeView::getName() const
+{
+    const auto& index = getIndex();
+    switch ( index.type )
+    {
+        case IDataType::Type::Variant:
+            return index.methods->create().getTypeName();
+
+        case IDataType::Type::Struct:
+            return std::string( index.name );
+
+        case IDataType::Type::Vector:
+            return "Vector<" + index.methods->create().getCachedTypeName() + ">";
+    }
+    SEQ_ASSERT_INVARIANT( false, "Unknown data type" );
+}
+
+size_t
+DataTypeView::size() const
+{
+    const auto& index = getIndex();
+    SEQ_ASSERT_ARGUMENT( IDataType::Type::Variant != index.type, "Variant has no size" );
+    return IDataType::Type::Struct == index.type ? index.attributes.size() : index.count;
+}
+
+bool
+DataTypeView::has( std::string_view name ) const
+{
+    const auto& attributes = getIndex( IDataType::Type::Struct ).attributes;
+    auto it = std::lower_bound( attributes.begin(), attributes.end(), name,
+                                []( const auto& attribute, std::string_view name )
+                                {
+                                    return attribute.first < name;
+                                } );
+    return attributes.end() != it && it->first == name;
+}
+
+std::string_view
+DataTypeView::getAttributeName( size_t index ) const
+{
+    const auto& attributes = getIndex( IDataType::Type::Struct ).attributes;
+    SEQ_ASSERT_ARGUMENT( index < attributes.size(), "Index " << index << " out of range" );
+    return attributes[index].first;
+}
+
+DataTypeView
+DataTypeView::get( std::string_view name ) const
+{
+    const auto& attributes = getIndex( IDataType::Type::Struct ).attributes;
+    auto it = std::lower_bound( attributes.begin(), attributes.end(), name,
+                                []( const auto& attribute, std::string_view name )
+                                {
+                                    return attribute.first < name;
+                                } );
+    SEQ_ASSERT_ARGUMENT( attributes.end() != it && it->first == name,
+                         "No attribute called '" << name << "'" );
+    return get( static_cast<size_t>( it - attributes.begin() ) );
+}
+
+DataTypeView
+DataTypeView::get( size_t index ) const
+{
+    const auto& children = getIndex( IDataType::Type::Struct ).children;
+    SEQ_ASSERT_ARGUMENT( index < children.size(), "Index " << index << " out of range" );
+    return DataTypeView( std::shared_ptr<const Node>( mNode, &children[index] ) );
+}
+
+std::type_index
+DataTypeView::getValueType() const
+{
+    const auto& index = getIndex();
+    SEQ_ASSERT_ARGUMENT( IDataType::Type::Struct != index.type, "Struct has no value type" );
+    return index.methods->create().getTypeIndex();
+}
+
+Variant
+DataTypeView::getValue() const
+{
+    const auto& index = getIndex( IDataType::Type::Variant );
+    const auto& data = mNode->data;
+
+    DataStream stream( std::make_unique<internal::SpanStream>(
+        Data( data.data() + index.valueOffset, data.size() - index.valueOffset ) ) );
+    stream.setLimits( mNode->limits );
+
+    Variant value;
+    checkError( index.methods->tryDeserialize( stream, value ) );
+    return value;
+}
+
+Variant
+DataTypeView::getElement( size_t element ) const
+{
+    const auto& index = getIndex( IDataType::Type::Vector );
+    SEQ_ASSERT_ARGUMENT( element < index.count, "Index " << element << " out of range" );
+
+    const auto& data = mNode->data;
+    const size_t offset = index.stride ? index.valueOffset + element * index.stride
+                                       : index.offsets[element];
+    DataStream stream( std::make_unique<internal::SpanStream>(
+        Data( data.data() + offset, data.size() - offset ) ) );
+    stream.setLimits( mNode->limits );
+
+    Variant value;
+    checkError( index.methods->tryDeserialize( stream, value ) );
+    return value;
+}
+
+IDataTypeUniquePtr
+DataTypeView::materialize() const
+{
+    DataStream stream( std::make_unique<internal::SpanStream>( mNode->data ) );
+    stream.setLimits( mNode->limits );
+
+    auto ret = IDataType::tryDeserialize( stream );
+    checkError( ret ? DecodeError::None : ret.error() );
+    return std::move(ret).value();
+}
+
+const DataTypeView::Index&
+DataTypeView::getIndex( IDataType::Type type ) const
+{
+    const auto& index = getIndex();
+    SEQ_ASSERT_ARGUMENT( type == index.type, "Data type is "
+                         << static_cast<uint32_t>( index.type ) << ", expected "
+                         << static_cast<uint32_t>( type ) );
+    return index;
+}
+
+const DataTypeView::Index&
+DataTypeView::getIndex() const
+{
+    std::call_once( mNode->flag, [this]
+    {
+        const auto& data = mNode->data;
+        auto backend = std::make_unique<internal::SpanStream>( data );
+        auto& span = *backend;
+        DataStream stream( std::move(backend) );
+        stream.setLimits( mNode->limits );
+
+        auto index = std::make_unique<Index>();
+        uint32_t type = 0;
+        uint32_t count = 0;
+        uint64_t hash = 0;
+
+        // The viewed data type is nested like in IDataType::tryDeserialize()
+        checkError( stream.enterNested() );
+        checkError( stream.tryRead( type ) );
+        switch ( type )
+        {
+            case static_cast<uint32_t>(IDataType::Type::Variant):
+                checkError( internal::readMethods( stream, index->methods, hash ) );
+                index->valueOffset = span.getPosition();
+                break;
+
+            case static_cast<uint32_t>(IDataType::Type::Struct):
+            {
+                checkError( readString( stream, span, index->name ) );
+                checkError( index->name.empty() ? DecodeError::InvalidName : DecodeError::None );
+                checkError( stream.tryRead( count ) );
+                checkError( count > mNode->limits.maxElementCount ? DecodeError::TooManyElements
+                                                                  : DecodeError::None );
+
+                index->attributes.reserve( stream.getReserveHint( count, 2 * sizeof(uint32_t) ) );
+                for ( uint32_t i = 0; i < count; ++i )
+                {
+                    std::string_view name;
+                    checkError( readString( stream, span, name ) );
+                    checkError( name.empty() ? DecodeError::InvalidName : DecodeError::None );
+
+                    const size_t begin = span.getPosition();
+                    checkError( internal::skipDataType( stream ) );
+                    index->attributes.emplace_back( name, Data( data.data() + begin,
+                                                                span.getPosition() - begin ) );
+                }
+
+                // Serialized structs are ordered by name, only foreign data needs sorting
+                auto byName = []( const auto& lhs, const auto& rhs ){ return lhs.first < rhs.first; };
+                auto& attributes = index->attributes;
+                if ( !std::is_sorted( attributes.begin(), attributes.end(), byName ) )
+                {
+                    std::sort( attributes.begin(), attributes.end(), byName );
+                }
+                auto duplicate = std::adjacent_find( attributes.begin(), attributes.end(),
+                                                     []( const auto& lhs, const auto& rhs )
+                                                     {
+                                                         return lhs.first == rhs.first;
+                                                     } );
+                checkError( attributes.end() != duplicate ? DecodeError::DuplicateAttribute
+                                                          : DecodeError::None );
+
+                // The attributes are one level deeper than the struct
+                auto limits = mNode->limits;
+                limits.maxDepth = limits.maxDepth ? limits.maxDepth - 1 : 0;
+                for ( const auto& attribute: attributes )
+                {
+                    index->children.emplace_back( attribute.second, limits );
+                }
+                break;
+            }
+
+            case static_cast<uint32_t>(IDataType::Type::Vector):
+            {
+                checkError( internal::readMethods( stream, index->methods, hash ) );
+                checkError( stream.tryRead( count ) );
+                checkError( count > mNode->limits.maxElementCount ? DecodeError::TooManyElements
+                                                                  : DecodeError::None );
+                index->count = count;
+                index->valueOffset = span.getPosition();
+
+                const size_t encoding = internal::getEncodedSize( hash );
+                if ( internal::UNKNOWN_ENCODING != encoding && internal::STRING_ENCODING != encoding )
+                {
+                    // Elements are located by arithmetic, only check they are there
+                    checkError( count > span.available() / encoding ? DecodeError::EndOfStream
+                                                                    : DecodeError::None );
+                    index->stride = encoding;
+                    break;
+                }
+
+                index->offsets.reserve( stream.getReserveHint( count, 1 ) );
+                for ( uint32_t i = 0; i < count; ++i )
+                {
+                    index->offsets.push_back( span.getPosition() );
+                    checkError( internal::skipValue( stream, *index->methods, encoding ) );
+                }
+                break;
+            }
+
+            default:
+                checkError( DecodeError::UnknownDataType );
+        }
+
+        index->type = static_cast<IDataType::Type>( type );
+        mNode->index = std::move(index);
+    } );
+    return *mNode->index;
+}
+
+} // end namespace workflow::type
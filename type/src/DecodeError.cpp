@@ -0,0 +1,39 @@
+#include <workflow/type/DecodeError.hpp>
+
+#include <iostream>
+
+namespace workflow::type {
+
+const char*
+toString( DecodeError error ) noexcept
+{
+    switch ( error )
+    {
+        case DecodeError::None:                 return "None";
+        case DecodeError::EndOfStream:          return "EndOfStream";
+        case DecodeError::TypeMismatch:         return "TypeMismatch";
+        case DecodeError::InvalidValue:         return "InvalidValue";
+        case DecodeError::UnknownDataType:      return "UnknownDataType";
+        case DecodeError::UnknownVariantType:   return "UnknownVariantType";
+        case DecodeError::InvalidName:          return "InvalidName";
+        case DecodeError::DuplicateAttribute:   return "DuplicateAttribute";
+        case DecodeError::StringTooLong:        return "StringTooLong";
+        case DecodeError::TooManyElements:      return "TooManyElements";
+        case DecodeError::NestingTooDeep:       return "NestingTooDeep";
+        case DecodeError::TotalSizeExceeded:    return "TotalSizeExceeded";
+        case DecodeError::SyntaxError:          return "SyntaxError";
+        case DecodeError::UnknownAttribute:     return "UnknownAttribute";
+        case DecodeError::MissingAttribute:     return "MissingAttribute";
+    }
+    return "Unknown";
+}
+
+std::ostream&
+operator<<( std::ostream& os,
+            DecodeError error )
+{
+    os << toString( error );
+    return os;
+}
+
+} // end namespace workflow::type
@@ -1,9 +1,69 @@
 #include <workflow/type/IDataStream.hpp>
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
 namespace workflow::type {
 
 SEQ_INTERFACE_IMPL( IDataStream );
 
+bool
+IDataStream::tryRead( const size_t length,
+                      void* data )
+{
+    try
+    {
+        read( length, data );
+        return true;
+    }
+    catch ( ... )
+    {
+        return false;
+    }
+}
+
+bool
+IDataStream::trySkip( const size_t length )
+{
+    constexpr size_t CHUNK_SIZE = 4096;
+
+    if ( length > available() )
+    {
+        return false;
+    }
+
+    uint8_t buffer[CHUNK_SIZE];
+    for ( size_t skipped = 0; skipped < length; )
+    {
+        const size_t chunk = std::min( length - skipped, CHUNK_SIZE );
+        if ( !tryRead( chunk, buffer ) )
+        {
+            return false;
+        }
+        skipped += chunk;
+    }
+    return true;
+}
+
+size_t
+IDataStream::available() const
+{
+    return std::numeric_limits<size_t>::max();
+}
+
+void
+IDataStream::writeGather( utils::Span<const utils::Span<const uint8_t>> buffers )
+{
+    for ( const auto& buffer: buffers )
+    {
+        if ( !buffer.empty() )
+        {
+            write( buffer.size(), buffer.data() );
+        }
+    }
+}
+
 void
 write( bool value );
 
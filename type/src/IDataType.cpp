@@ -3,8 +3,55 @@
 
 #include <workflow/type/VariantDataType.hpp>
 #include <workflow/type/StructDataType.hpp>
+#include <workflow/type/VectorDataType.hpp>
 
 namespace workflow::type {
+namespace {
+
+template<typename T>
+IDataType::DecodeResult
+toDecodeResult( utils::Expected<std::unique_ptr<T>, DecodeError> result )
+{
+    if ( !result )
+    {
+        return utils::makeUnexpected( result.error() );
+    }
+    return IDataTypeUniquePtr( std::move(result).value() );
+}
+
+/**
+ * Tracks the nesting depth of the stream for the lifetime of the guard
+ */
+class NestingGuard
+{
+public:
+    explicit
+    NestingGuard( DataStream& stream )
+        : mStream( stream )
+        , mError( stream.enterNested() )
+    {
+    }
+
+    ~NestingGuard()
+    {
+        if ( DecodeError::None == mError )
+        {
+            mStream.leaveNested();
+        }
+    }
+
+    DecodeError
+    getError() const
+    {
+        return mError;
+    }
+
+private:
+    DataStream& mStream;
+    DecodeError mError;
+};
+
+} // end namespace
 
 SEQ_INTERFACE_IMPL( IDataType );
 
@@ -22,6 +69,10 @@ IDataType::deserialize( DataStream& stream )
     // NOTE: Here we depend on all the data type implementations. This is odd,
     // but we cannot overcome this. At some place we have to dispatch
     // deserialization
+    NestingGuard guard( stream );
+    SEQ_ASSERT_INVARIANT( DecodeError::None == guard.getError(), "Invalid stream: "
+                          << guard.getError() );
+
     uint32_t type = 0;
     stream.read( type );
 
@@ -32,11 +83,45 @@ IDataType::deserialize( DataStream& stream )
 
         case static_cast<uint32_t>(Type::Struct):
             return std::make_unique<StructDataType>( stream );
+
+        case static_cast<uint32_t>(Type::Vector):
+            return std::make_unique<VectorDataType>( stream );
     }
 
     SEQ_ASSERT_INVARIANT( false, "No data type with id '" << type << "'" );
 }
 
+IDataType::DecodeResult
+IDataType::tryDeserialize( DataStream& stream )
+{
+    NestingGuard guard( stream );
+    if ( DecodeError::None != guard.getError() )
+    {
+        return utils::makeUnexpected( guard.getError() );
+    }
+
+    uint32_t type = 0;
+    auto error = stream.tryRead( type );
+    if ( DecodeError::None != error )
+    {
+        return utils::makeUnexpected( error );
+    }
+
+    switch ( type )
+    {
+        case static_cast<uint32_t>(Type::Variant):
+            return toDecodeResult( VariantDataType::tryDeserialize( stream ) );
+
+        case static_cast<uint32_t>(Type::Struct):
+            return toDecodeResult( StructDataType::tryDeserialize( stream ) );
+
+        case static_cast<uint32_t>(Type::Vector):
+            return toDecodeResult( VectorDataType::tryDeserialize( stream ) );
+    }
+
+    return utils::makeUnexpected( DecodeError::UnknownDataType );
+}
+
 bool
 operator==( const IDataType& lhs,
             const IDataType& rhs )
@@ -4,4 +4,19 @@ namespace workflow::type {
 
 SEQ_INTERFACE_IMPL( IVariantMethods );
 
+DecodeError
+IVariantMethods::tryDeserialize( DataStream& stream,
+                                 Variant& value ) const
+{
+    try
+    {
+        deserialize( stream, value );
+        return DecodeError::None;
+    }
+    catch ( ... )
+    {
+        return DecodeError::InvalidValue;
+    }
+}
+
 } // end namespace workflow::type
\ No newline at end of file
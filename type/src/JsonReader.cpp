@@ -0,0 +1,1036 @@
+#include <workflow/type/JsonReader.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include <workflow/utils/Error.hpp>
+
+#include <workflow/type/IVariantMethods.hpp>
+#include <workflow/type/StructDataType.hpp>
+#include <workflow/type/VariantDataType.hpp>
+#include <workflow/type/VariantMethodsManager.hpp>
+#include <workflow/type/VectorDataType.hpp>
+
+#include <internal/JsonScan.hpp>
+#include <internal/Primitives.hpp>
+
+namespace workflow::type {
+namespace {
+
+bool
+isDigit( char c ) noexcept
+{
+    return c >= '0' && c <= '9';
+}
+
+/**
+ * Convert a number scanned by JsonReader::scanNumber()
+ */
+template<typename T>
+DecodeError
+toNumber( std::string_view token,
+          bool integral,
+          T& value )
+{
+    if ( std::is_integral_v<T> && !integral )
+    {
+        return DecodeError::InvalidValue;
+    }
+
+    const char* end = token.data() + token.size();
+    auto result = std::from_chars( token.data(), end, value );
+    if ( std::errc() != result.ec || end != result.ptr )
+    {
+        return DecodeError::InvalidValue;
+    }
+    return DecodeError::None;
+}
+
+/**
+ * Append a code point encoded as UTF-8
+ */
+void
+appendUtf8( std::string& text,
+            uint32_t code )
+{
+    if ( code < 0x80 )
+    {
+        text += static_cast<char>( code );
+    }
+    else if ( code < 0x800 )
+    {
+        text += static_cast<char>( 0xc0 | ( code >> 6 ) );
+        text += static_cast<char>( 0x80 | ( code & 0x3f ) );
+    }
+    else if ( code < 0x10000 )
+    {
+        text += static_cast<char>( 0xe0 | ( code >> 12 ) );
+        text += static_cast<char>( 0x80 | ( ( code >> 6 ) & 0x3f ) );
+        text += static_cast<char>( 0x80 | ( code & 0x3f ) );
+    }
+    else
+    {
+        text += static_cast<char>( 0xf0 | ( code >> 18 ) );
+        text += static_cast<char>( 0x80 | ( ( code >> 12 ) & 0x3f ) );
+        text += static_cast<char>( 0x80 | ( ( code >> 6 ) & 0x3f ) );
+        text += static_cast<char>( 0x80 | ( code & 0x3f ) );
+    }
+}
+
+} // end namespace
+
+/******************************************************************************
+ * An object being parsed
+ *****************************************************************************/
+struct JsonReader::Frame
+{
+    /// The schema of the object, null if inferred
+    StructSchemaSharedPtr               schema;
+
+    /// The values by attribute index with schema, else in text order
+    StructDataType::Values              values;
+
+    /// The attribute names in text order without schema, interned once the
+    /// schema is built
+    std::vector<std::string>            names;
+
+    /// Number of attributes read
+    size_t                              count = 0;
+
+    /// Attribute index of the nested object being parsed
+    size_t                              pending = 0;
+};
+
+/*****************************************************************************/
+JsonReader::JsonReader() = default;
+
+JsonReader::~JsonReader() = default;
+
+IDataTypeUniquePtr
+JsonReader::parse( std::string_view text,
+                   const StructSchemaSharedPtr& schema,
+                   const DecodeLimits& limits )
+{
+    auto ret = tryParse( text, schema, limits );
+    SEQ_ASSERT_INVARIANT( ret, "Invalid JSON at offset " << mErrorOffset << ": " << ret.error() );
+    return std::move(ret).value();
+}
+
+IDataType::DecodeResult
+JsonReader::tryParse( std::string_view text,
+                      const StructSchemaSharedPtr& schema,
+                      const DecodeLimits& limits )
+{
+    mBegin = text.data();
+    mPosition = mBegin;
+    mEnd = mBegin + text.size();
+    mLimits = limits;
+    mErrorOffset = 0;
+    mStack.clear();
+
+    IDataTypeUniquePtr result;
+    auto error = text.size() > mLimits.maxTotalBytes ? DecodeError::TotalSizeExceeded
+                                                     : parseDocument( schema, result );
+    if ( DecodeError::None != error )
+    {
+        mErrorOffset = static_cast<size_t>( mPosition - mBegin );
+        mStack.clear();
+        return utils::makeUnexpected( error );
+    }
+    return result;
+}
+
+DecodeError
+JsonReader::parseDocument( const StructSchemaSharedPtr& schema,
+                           IDataTypeUniquePtr& result )
+{
+    if ( !skipWhitespace() )
+    {
+        return DecodeError::EndOfStream;
+    }
+
+    DecodeError error = DecodeError::None;
+    if ( '{' == *mPosition )
+    {
+        ++mPosition;
+        error = openObject( schema );
+    }
+    else if ( schema )
+    {
+        error = DecodeError::TypeMismatch;
+    }
+    else
+    {
+        error = mLimits.maxDepth ? parseValue( nullptr, result ) : DecodeError::NestingTooDeep;
+    }
+    if ( DecodeError::None != error )
+    {
+        return error;
+    }
+
+    // Objects are parsed on the stack, all other values at once
+    while ( !mStack.empty() )
+    {
+        if ( !skipWhitespace() )
+        {
+            return DecodeError::EndOfStream;
+        }
+
+        auto& frame = mStack.back();
+        if ( '}' == *mPosition )
+        {
+            ++mPosition;
+            IDataTypeUniquePtr value;
+            error = closeObject( value );
+            if ( DecodeError::None != error )
+            {
+                return error;
+            }
+            if ( mStack.empty() )
+            {
+                result = std::move(value);
+                break;
+            }
+
+            auto& parent = mStack.back();
+            if ( parent.schema )
+            {
+                parent.values[parent.pending] = std::move(value);
+            }
+            else
+            {
+                parent.values.push_back( std::move(value) );
+            }
+            continue;
+        }
+
+        if ( frame.count )
+        {
+            if ( ',' != *mPosition )
+            {
+                return syntaxError( mPosition );
+            }
+            ++mPosition;
+            if ( !skipWhitespace() )
+            {
+                return DecodeError::EndOfStream;
+            }
+        }
+        if ( '"' != *mPosition )
+        {
+            return syntaxError( mPosition );
+        }
+
+        std::string_view name;
+        error = parseString( name );
+        if ( DecodeError::None != error )
+        {
+            return error;
+        }
+        if ( ++frame.count > mLimits.maxElementCount )
+        {
+            return DecodeError::TooManyElements;
+        }
+
+        const StructSchema::Attribute* attribute = nullptr;
+        size_t index = frame.values.size();
+        if ( frame.schema )
+        {
+            index = frame.schema->find( name );
+            if ( StructSchema::npos == index )
+            {
+                return DecodeError::UnknownAttribute;
+            }
+            if ( frame.values[index] )
+            {
+                return DecodeError::DuplicateAttribute;
+            }
+            attribute = &frame.schema->getAttributes()[index];
+        }
+        else
+        {
+            if ( name.empty() )
+            {
+                return DecodeError::InvalidName;
+            }
+            frame.names.emplace_back( name );
+        }
+
+        if ( !skipWhitespace() )
+        {
+            return DecodeError::EndOfStream;
+        }
+        if ( ':' != *mPosition )
+        {
+            return syntaxError( mPosition );
+        }
+        ++mPosition;
+        if ( !skipWhitespace() )
+        {
+            return DecodeError::EndOfStream;
+        }
+
+        const bool isStruct = attribute && IDataType::Type::Struct == attribute->type;
+        if ( '{' == *mPosition )
+        {
+            if ( attribute && !isStruct )
+            {
+                return DecodeError::TypeMismatch;
+            }
+            ++mPosition;
+            frame.pending = index;
+            error = openObject( attribute ? attribute->schema : nullptr );
+            if ( DecodeError::None != error )
+            {
+                return error;
+            }
+            continue;
+        }
+        if ( isStruct )
+        {
+            return DecodeError::TypeMismatch;
+        }
+        if ( mStack.size() >= mLimits.maxDepth )
+        {
+            return DecodeError::NestingTooDeep;
+        }
+
+        IDataTypeUniquePtr value;
+        error = parseValue( attribute, value );
+        if ( DecodeError::None != error )
+        {
+            return error;
+        }
+        if ( frame.schema )
+        {
+            frame.values[index] = std::move(value);
+        }
+        else
+        {
+            frame.values.push_back( std::move(value) );
+        }
+    }
+
+    if ( skipWhitespace() )
+    {
+        return DecodeError::SyntaxError;
+    }
+    return DecodeError::None;
+}
+
+DecodeError
+JsonReader::openObject( const StructSchemaSharedPtr& schema )
+{
+    if ( mStack.size() >= mLimits.maxDepth )
+    {
+        return DecodeError::NestingTooDeep;
+    }
+
+    auto& frame = mStack.emplace_back();
+    frame.schema = schema;
+    if ( schema )
+    {
+        frame.values.resize( schema->size() );
+    }
+    return DecodeError::None;
+}
+
+DecodeError
+JsonReader::closeObject( IDataTypeUniquePtr& result )
+{
+    auto& frame = mStack.back();
+    std::unique_ptr<StructDataType> value( new StructDataType() );
+    if ( frame.schema )
+    {
+        if ( frame.count != frame.values.size() )
+        {
+            return DecodeError::MissingAttribute;
+        }
+        value->mSchema = std::move(frame.schema);
+        value->mValues = std::move(frame.values);
+    }
+    else
+    {
+        if ( !frame.count )
+        {
+            return DecodeError::MissingAttribute;
+        }
+
+        StructSchema::Attributes attributes;
+        attributes.reserve( frame.values.size() );
+        for ( size_t i = 0; i < frame.values.size(); ++i )
+        {
+            attributes.push_back( StructSchema::describe( utils::InternedString( frame.names[i] ),
+                                                          *frame.values[i] ) );
+        }
+        value->mValues = std::move(frame.values);
+
+        static const utils::InternedString name( OBJECT_NAME );
+        auto error = value->finishDecode( name, std::move(attributes) );
+        if ( DecodeError::None != error )
+        {
+            return error;
+        }
+    }
+
+    mStack.pop_back();
+    result = std::move(value);
+    return DecodeError::None;
+}
+
+DecodeError
+JsonReader::parseValue( const StructSchema::Attribute* attribute,
+                        IDataTypeUniquePtr& value )
+{
+    if ( !attribute )
+    {
+        if ( '[' == *mPosition )
+        {
+            return inferVector( value );
+        }
+
+        Variant variant;
+        auto error = inferVariant( variant );
+        if ( DecodeError::None != error )
+        {
+            return error;
+        }
+        value = std::make_unique<VariantDataType>( std::move(variant) );
+        return DecodeError::None;
+    }
+
+    if ( IDataType::Type::Vector == attribute->type )
+    {
+        return parseVector( attribute->valueType, value );
+    }
+
+    Variant variant;
+    auto error = parseVariant( attribute->valueType, variant );
+    if ( DecodeError::None != error )
+    {
+        return error;
+    }
+    value = std::make_unique<VariantDataType>( std::move(variant) );
+    return DecodeError::None;
+}
+
+DecodeError
+JsonReader::parseVector( std::type_index elementType,
+                         IDataTypeUniquePtr& value )
+{
+    if ( '[' != *mPosition )
+    {
+        return DecodeError::TypeMismatch;
+    }
+
+    const auto& methods = VariantMethodsManager::instance().get( elementType );
+    auto vector = std::make_unique<VectorDataType>( methods.create() );
+    DecodeError error = DecodeError::None;
+    const bool typed = internal::dispatchPrimitive( elementType, [&]( auto tag )
+    {
+        using T = typename decltype(tag)::type;
+        error = parseElements<T>( *vector );
+    } );
+    if ( !typed )
+    {
+        error = parseArray( [&]()
+        {
+            Variant element;
+            auto elementError = parseVariant( elementType, element );
+            if ( DecodeError::None == elementError )
+            {
+                vector->push_back( element );
+            }
+            return elementError;
+        } );
+    }
+    if ( DecodeError::None != error )
+    {
+        return error;
+    }
+
+    value = std::move(vector);
+    return DecodeError::None;
+}
+
+template<typename T>
+DecodeError
+JsonReader::parseElements( VectorDataType& vector )
+{
+    auto& values = vector.getStorage<T>().mValues;
+    return parseArray( [&]()
+    {
+        T element{};
+        auto error = parseScalar( element );
+        if ( DecodeError::None == error )
+        {
+            values.push_back( std::move(element) );
+        }
+        return error;
+    } );
+}
+
+DecodeError
+JsonReader::parseVariant( std::type_index type,
+                          Variant& value )
+{
+    DecodeError error = DecodeError::None;
+    const bool typed = internal::dispatchPrimitive( type, [&]( auto tag )
+    {
+        using T = typename decltype(tag)::type;
+        T scalar{};
+        error = parseScalar( scalar );
+        value = Variant( std::move(scalar) );
+    } );
+    if ( typed )
+    {
+        return error;
+    }
+
+    // Other variant types are read from their string representation
+    std::string_view text;
+    error = '"' == *mPosition ? parseString( text ) : DecodeError::TypeMismatch;
+    if ( DecodeError::None != error )
+    {
+        return error;
+    }
+    try
+    {
+        value = VariantMethodsManager::instance().get( type ).fromString( std::string( text ) );
+        return DecodeError::None;
+    }
+    catch ( ... )
+    {
+        return DecodeError::InvalidValue;
+    }
+}
+
+DecodeError
+JsonReader::inferVector( IDataTypeUniquePtr& value )
+{
+    enum class Kind
+    {
+        Empty,
+        Bool,
+        String,
+        Integer,
+        Real
+    };
+
+    Kind kind = Kind::Empty;
+    std::vector<bool> bools;
+    std::vector<std::string> strings;
+    std::vector<int64_t> integers;
+    std::vector<double> reals;
+
+    auto error = parseArray( [&]()
+    {
+        const char c = *mPosition;
+        if ( '"' == c )
+        {
+            if ( Kind::Empty != kind && Kind::String != kind )
+            {
+                return DecodeError::TypeMismatch;
+            }
+            kind = Kind::String;
+            std::string_view text;
+            auto error = parseString( text );
+            strings.emplace_back( text );
+            return error;
+        }
+
+        if ( 't' == c || 'f' == c )
+        {
+            if ( Kind::Empty != kind && Kind::Bool != kind )
+            {
+                return DecodeError::TypeMismatch;
+            }
+            kind = Kind::Bool;
+            bool flag = false;
+            auto error = parseScalar( flag );
+            bools.push_back( flag );
+            return error;
+        }
+
+        if ( '-' != c && !isDigit( c ) )
+        {
+            return '[' == c || '{' == c || 'n' == c ? DecodeError::TypeMismatch : syntaxError( mPosition );
+        }
+        if ( Kind::Empty != kind && Kind::Integer != kind && Kind::Real != kind )
+        {
+            return DecodeError::TypeMismatch;
+        }
+
+        std::string_view token;
+        bool integral = false;
+        auto error = scanNumber( token, integral );
+        if ( DecodeError::None != error )
+        {
+            return error;
+        }
+
+        int64_t integer = 0;
+        if ( Kind::Real != kind && DecodeError::None == toNumber( token, integral, integer ) )
+        {
+            kind = Kind::Integer;
+            integers.push_back( integer );
+            return DecodeError::None;
+        }
+
+        // Once a number is not an int64_t all elements are stored as double
+        if ( Kind::Real != kind )
+        {
+            kind = Kind::Real;
+            reals.assign( integers.begin(), integers.end() );
+        }
+        double real = 0.0;
+        error = toNumber( token, false, real );
+        reals.push_back( real );
+        return error;
+    } );
+    if ( DecodeError::None != error )
+    {
+        return error;
+    }
+
+    switch ( kind )
+    {
+        case Kind::Bool:
+            value = std::make_unique<VectorDataType>( Variant( false ) );
+            static_cast<VectorDataType&>( *value ).getStorage<bool>().mValues = std::move(bools);
+            break;
+
+        case Kind::String:
+            value = std::make_unique<VectorDataType>( Variant( std::string() ) );
+            static_cast<VectorDataType&>( *value ).getStorage<std::string>().mValues = std::move(strings);
+            break;
+
+        case Kind::Integer:
+            value = std::make_unique<VectorDataType>( Variant( int64_t(0) ) );
+            static_cast<VectorDataType&>( *value ).getStorage<int64_t>().mValues = std::move(integers);
+            break;
+
+        case Kind::Empty:
+        case Kind::Real:
+            value = std::make_unique<VectorDataType>( Variant( 0.0 ) );
+            static_cast<VectorDataType&>( *value ).getStorage<double>().mValues = std::move(reals);
+            break;
+    }
+    return DecodeError::None;
+}
+
+DecodeError
+JsonReader::inferVariant( Variant& value )
+{
+    const char c = *mPosition;
+    if ( '"' == c )
+    {
+        std::string_view text;
+        auto error = parseString( text );
+        value = Variant( std::string( text ) );
+        return error;
+    }
+
+    if ( 't' == c || 'f' == c )
+    {
+        bool flag = false;
+        auto error = parseScalar( flag );
+        value = Variant( flag );
+        return error;
+    }
+
+    if ( '-' != c && !isDigit( c ) )
+    {
+        return '{' == c || 'n' == c ? DecodeError::TypeMismatch : syntaxError( mPosition );
+    }
+
+    std::string_view token;
+    bool integral = false;
+    auto error = scanNumber( token, integral );
+    if ( DecodeError::None != error )
+    {
+        return error;
+    }
+
+    int64_t integer = 0;
+    uint64_t unsignedInteger = 0;
+    double real = 0.0;
+    if ( DecodeError::None == toNumber( token, integral, integer ) )
+    {
+        value = Variant( integer );
+    }
+    else if ( DecodeError::None == toNumber( token, integral, unsignedInteger ) )
+    {
+        value = Variant( unsignedInteger );
+    }
+    else
+    {
+        error = toNumber( token, false, real );
+        value = Variant( real );
+    }
+    return error;
+}
+
+template<typename F>
+DecodeError
+JsonReader::parseArray( F&& element )
+{
+    // The opening bracket is checked by the caller
+    ++mPosition;
+    size_t count = 0;
+    while ( true )
+    {
+        if ( !skipWhitespace() )
+        {
+            return DecodeError::EndOfStream;
+        }
+        if ( ']' == *mPosition && !count )
+        {
+            ++mPosition;
+            return DecodeError::None;
+        }
+        if ( ++count > mLimits.maxElementCount )
+        {
+            return DecodeError::TooManyElements;
+        }
+
+        auto error = element();
+        if ( DecodeError::None != error )
+        {
+            return error;
+        }
+
+        if ( !skipWhitespace() )
+        {
+            return DecodeError::EndOfStream;
+        }
+        if ( ']' == *mPosition )
+        {
+            ++mPosition;
+            return DecodeError::None;
+        }
+        if ( ',' != *mPosition )
+        {
+            return syntaxError( mPosition );
+        }
+        ++mPosition;
+        if ( !skipWhitespace() )
+        {
+            return DecodeError::EndOfStream;
+        }
+        if ( ']' == *mPosition )
+        {
+            return DecodeError::SyntaxError;
+        }
+    }
+}
+
+template<typename T>
+DecodeError
+JsonReader::parseScalar( T& value )
+{
+    if constexpr ( std::is_same_v<T, bool> )
+    {
+        if ( 't' == *mPosition )
+        {
+            value = true;
+            return parseLiteral( "true" );
+        }
+        if ( 'f' == *mPosition )
+        {
+            value = false;
+            return parseLiteral( "false" );
+        }
+        return DecodeError::TypeMismatch;
+    }
+    else if constexpr ( std::is_same_v<T, std::string> )
+    {
+        if ( '"' != *mPosition )
+        {
+            return DecodeError::TypeMismatch;
+        }
+        std::string_view text;
+        auto error = parseString( text );
+        value.assign( text.data(), text.size() );
+        return error;
+    }
+    else
+    {
+        if constexpr ( std::is_floating_point_v<T> )
+        {
+            if ( 'n' == *mPosition )
+            {
+                value = std::numeric_limits<T>::quiet_NaN();
+                return parseLiteral( "null" );
+            }
+        }
+        if ( '-' != *mPosition && !isDigit( *mPosition ) )
+        {
+            return DecodeError::TypeMismatch;
+        }
+
+        std::string_view token;
+        bool integral = false;
+        auto error = scanNumber( token, integral );
+        if ( DecodeError::None != error )
+        {
+            return error;
+        }
+        return toNumber( token, integral, value );
+    }
+}
+
+DecodeError
+JsonReader::parseString( std::string_view& value )
+{
+    // The opening quote is checked by the caller
+    const char* begin = ++mPosition;
+    const char* special = internal::findJsonSpecial( begin, mEnd );
+    if ( mEnd != special && '"' == *special )
+    {
+        // Strings without escapes refer to the text
+        value = std::string_view( begin, static_cast<size_t>( special - begin ) );
+        mPosition = special + 1;
+        return value.size() > mLimits.maxStringLength ? DecodeError::StringTooLong : DecodeError::None;
+    }
+
+    mScratch.assign( begin, special );
+    mPosition = special;
+    while ( true )
+    {
+        if ( mEnd == mPosition )
+        {
+            return DecodeError::EndOfStream;
+        }
+        if ( mScratch.size() > mLimits.maxStringLength )
+        {
+            return DecodeError::StringTooLong;
+        }
+
+        const char c = *mPosition;
+        if ( '"' == c )
+        {
+            ++mPosition;
+            break;
+        }
+        if ( '\\' != c )
+        {
+            return DecodeError::SyntaxError;
+        }
+
+        ++mPosition;
+        auto error = parseEscape();
+        if ( DecodeError::None != error )
+        {
+            return error;
+        }
+
+        special = internal::findJsonSpecial( mPosition, mEnd );
+        mScratch.append( mPosition, special );
+        mPosition = special;
+    }
+
+    value = mScratch;
+    return value.size() > mLimits.maxStringLength ? DecodeError::StringTooLong : DecodeError::None;
+}
+
+DecodeError
+JsonReader::parseEscape()
+{
+    if ( mEnd == mPosition )
+    {
+        return DecodeError::EndOfStream;
+    }
+
+    const char c = *mPosition++;
+    switch ( c )
+    {
+        case '"':
+        case '\\':
+        case '/':
+            mScratch += c;
+            return DecodeError::None;
+
+        case 'b':
+            mScratch += '\b';
+            return DecodeError::None;
+
+        case 'f':
+            mScratch += '\f';
+            return DecodeError::None;
+
+        case 'n':
+            mScratch += '\n';
+            return DecodeError::None;
+
+        case 'r':
+            mScratch += '\r';
+            return DecodeError::None;
+
+        case 't':
+            mScratch += '\t';
+            return DecodeError::None;
+
+        case 'u':
+            break;
+
+        default:
+            --mPosition;
+            return DecodeError::SyntaxError;
+    }
+
+    uint32_t code = 0;
+    auto error = parseHex( code );
+    if ( DecodeError::None != error )
+    {
+        return error;
+    }
+
+    // Code points beyond the basic plane are escaped as surrogate pairs
+    if ( code >= 0xd800 && code < 0xdc00 )
+    {
+        if ( mEnd - mPosition < 2 )
+        {
+            return DecodeError::EndOfStream;
+        }
+        if ( '\\' != mPosition[0] || 'u' != mPosition[1] )
+        {
+            return DecodeError::SyntaxError;
+        }
+        mPosition += 2;
+
+        uint32_t low = 0;
+        error = parseHex( low );
+        if ( DecodeError::None != error )
+        {
+            return error;
+        }
+        if ( low < 0xdc00 || low >= 0xe000 )
+        {
+            return DecodeError::InvalidValue;
+        }
+        code = 0x10000 + ( ( code - 0xd800 ) << 10 ) + ( low - 0xdc00 );
+    }
+    else if ( code >= 0xdc00 && code < 0xe000 )
+    {
+        return DecodeError::InvalidValue;
+    }
+
+    appendUtf8( mScratch, code );
+    return DecodeError::None;
+}
+
+DecodeError
+JsonReader::parseHex( uint32_t& value )
+{
+    if ( mEnd - mPosition < 4 )
+    {
+        return DecodeError::EndOfStream;
+    }
+
+    auto result = std::from_chars( mPosition, mPosition + 4, value, 16 );
+    if ( std::errc() != result.ec || mPosition + 4 != result.ptr )
+    {
+        return DecodeError::SyntaxError;
+    }
+    mPosition += 4;
+    return DecodeError::None;
+}
+
+DecodeError
+JsonReader::scanNumber( std::string_view& token,
+                        bool& integral )
+{
+    const char* position = mPosition;
+    auto digits = [&]()
+    {
+        const char* begin = position;
+        while ( mEnd != position && isDigit( *position ) )
+        {
+            ++position;
+        }
+        return begin != position;
+    };
+
+    if ( mEnd != position && '-' == *position )
+    {
+        ++position;
+    }
+    if ( mEnd != position && '0' == *position )
+    {
+        ++position;
+    }
+    else if ( !digits() )
+    {
+        return syntaxError( position );
+    }
+
+    integral = true;
+    if ( mEnd != position && '.' == *position )
+    {
+        ++position;
+        integral = false;
+        if ( !digits() )
+        {
+            return syntaxError( position );
+        }
+    }
+    if ( mEnd != position && ( 'e' == *position || 'E' == *position ) )
+    {
+        ++position;
+        integral = false;
+        if ( mEnd != position && ( '+' == *position || '-' == *position ) )
+        {
+            ++position;
+        }
+        if ( !digits() )
+        {
+            return syntaxError( position );
+        }
+    }
+
+    token = std::string_view( mPosition, static_cast<size_t>( position - mPosition ) );
+    mPosition = position;
+    return DecodeError::None;
+}
+
+DecodeError
+JsonReader::parseLiteral( std::string_view literal )
+{
+    const size_t available = static_cast<size_t>( mEnd - mPosition );
+    const size_t length = std::min( available, literal.size() );
+    if ( 0 != std::memcmp( mPosition, literal.data(), length ) )
+    {
+        return DecodeError::SyntaxError;
+    }
+    if ( length < literal.size() )
+    {
+        mPosition = mEnd;
+        return DecodeError::EndOfStream;
+    }
+    mPosition += length;
+    return DecodeError::None;
+}
+
+bool
+JsonReader::skipWhitespace() noexcept
+{
+    while ( mEnd != mPosition
+            && ( ' ' == *mPosition || '\n' == *mPosition || '\r' == *mPosition || '\t' == *mPosition ) )
+    {
+        ++mPosition;
+    }
+    return mEnd != mPosition;
+}
+
+DecodeError
+JsonReader::syntaxError( const char* position ) noexcept
+{
+    mPosition = position;
+    return mEnd == position ? DecodeError::EndOfStream : DecodeError::SyntaxError;
+}
+
+} // end namespace workflow::type
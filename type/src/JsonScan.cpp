@@ -0,0 +1,129 @@
+#include <internal/JsonScan.hpp>
+
+#include <cstdint>
+#include <cstring>
+
+#include <workflow/type/VectorMath.hpp>
+
+#if defined(__GNUC__) && ( defined(__x86_64__) || defined(__i386__) )
+#define HAS_X86_SIMD 1
+#include <immintrin.h>
+#else
+#define HAS_X86_SIMD 0
+#endif
+
+namespace workflow::type::internal {
+namespace {
+
+/**
+ * Find the first special character, testing eight characters at once
+ */
+const char*
+findScalar( const char* begin,
+            const char* end ) noexcept
+{
+    constexpr uint64_t ONES = 0x0101010101010101ull;
+    constexpr uint64_t HIGHS = 0x8080808080808080ull;
+
+    // Non zero if a byte of the word is less than n, n must not exceed 128
+    auto hasLess = []( uint64_t word, uint64_t n )
+    {
+        return ( word - ONES * n ) & ~word & HIGHS;
+    };
+
+    while ( end - begin >= 8 )
+    {
+        uint64_t word;
+        std::memcpy( &word, begin, sizeof(word) );
+        if ( hasLess( word, 0x20 )
+             || hasLess( word ^ ( ONES * '"' ), 1 )
+             || hasLess( word ^ ( ONES * '\\' ), 1 ) )
+        {
+            break;
+        }
+        begin += 8;
+    }
+
+    while ( begin != end && !isJsonSpecial( *begin ) )
+    {
+        ++begin;
+    }
+    return begin;
+}
+
+#if HAS_X86_SIMD
+#pragma GCC push_options
+#pragma GCC target("avx2")
+const char*
+findAvx2( const char* begin,
+          const char* end ) noexcept
+{
+    const __m256i quote = _mm256_set1_epi8( '"' );
+    const __m256i backslash = _mm256_set1_epi8( '\\' );
+    const __m256i control = _mm256_set1_epi8( 0x1f );
+    while ( end - begin >= 32 )
+    {
+        const __m256i chars = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( begin ) );
+        const __m256i special = _mm256_or_si256(
+            _mm256_or_si256( _mm256_cmpeq_epi8( chars, quote ), _mm256_cmpeq_epi8( chars, backslash ) ),
+            _mm256_cmpeq_epi8( _mm256_min_epu8( chars, control ), chars ) );
+        const auto mask = static_cast<uint32_t>( _mm256_movemask_epi8( special ) );
+        if ( mask )
+        {
+            return begin + __builtin_ctz( mask );
+        }
+        begin += 32;
+    }
+    return findScalar( begin, end );
+}
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx512bw")
+const char*
+findAvx512( const char* begin,
+            const char* end ) noexcept
+{
+    const __m512i quote = _mm512_set1_epi8( '"' );
+    const __m512i backslash = _mm512_set1_epi8( '\\' );
+    const __m512i control = _mm512_set1_epi8( 0x20 );
+    while ( end - begin >= 64 )
+    {
+        const __m512i chars = _mm512_loadu_si512( begin );
+        const __mmask64 mask = _mm512_cmpeq_epi8_mask( chars, quote )
+                             | _mm512_cmpeq_epi8_mask( chars, backslash )
+                             | _mm512_cmplt_epu8_mask( chars, control );
+        if ( mask )
+        {
+            return begin + __builtin_ctzll( mask );
+        }
+        begin += 64;
+    }
+    return findScalar( begin, end );
+}
+#pragma GCC pop_options
+#endif
+
+} // end namespace
+
+const char*
+findJsonSpecial( const char* begin,
+                 const char* end ) noexcept
+{
+#if HAS_X86_SIMD
+    switch ( math::getSimdLevel() )
+    {
+        case math::SimdLevel::Avx512:
+            return findAvx512( begin, end );
+
+        case math::SimdLevel::Avx2:
+            return findAvx2( begin, end );
+
+        case math::SimdLevel::Scalar:
+            break;
+    }
+#endif
+    return findScalar( begin, end );
+}
+
+} // end namespace workflow::type::internal
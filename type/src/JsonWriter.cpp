@@ -0,0 +1,239 @@
+#include <workflow/type/JsonWriter.hpp>
+
+#include <charconv>
+#include <cmath>
+#include <type_traits>
+
+#include <workflow/utils/Overloaded.hpp>
+
+#include <workflow/type/IVariantMethods.hpp>
+#include <workflow/type/Variant.hpp>
+#include <workflow/type/VariantMethodsManager.hpp>
+#include <workflow/type/Visit.hpp>
+
+#include <internal/JsonScan.hpp>
+#include <internal/Primitives.hpp>
+
+namespace workflow::type {
+namespace {
+
+// Longest text of a number written by std::to_chars
+constexpr size_t MAX_NUMBER_CHARS = 32;
+
+} // end namespace
+
+std::string_view
+JsonWriter::write( const IDataType& dataType )
+{
+    clear();
+    append( dataType );
+    return view();
+}
+
+void
+JsonWriter::append( const IDataType& dataType )
+{
+    // Structs are opened on the stack, all other data types are written at once
+    auto open = [this]( const IDataType& node )
+    {
+        visit( node, utils::Overloaded{
+            [this]( const VariantDataType& value )
+            {
+                appendVariant( value.getRef() );
+            },
+            [this]( const VectorDataType& value )
+            {
+                appendVector( value );
+            },
+            [this]( const StructDataType& value )
+            {
+                mBuffer += '{';
+                mStack.push_back( { &value, 0 } );
+            } } );
+    };
+
+    const size_t base = mStack.size();
+    open( dataType );
+    while ( mStack.size() > base )
+    {
+        auto& frame = mStack.back();
+        const auto& names = frame.node->getAttributeNames();
+        if ( frame.index == names.size() )
+        {
+            mStack.pop_back();
+            mBuffer += '}';
+            continue;
+        }
+
+        const size_t index = frame.index++;
+        if ( index )
+        {
+            mBuffer += ',';
+        }
+        appendString( names[index].view() );
+        mBuffer += ':';
+        open( frame.node->get( index ) );
+    }
+}
+
+void
+JsonWriter::appendVariant( const Variant& value )
+{
+    const bool typed = internal::anyOf<internal::Primitives>( [&]( auto tag )
+    {
+        return appendTyped<typename decltype(tag)::type>( value );
+    } );
+    if ( !typed )
+    {
+        const auto& methods = VariantMethodsManager::instance().get( value.getTypeIndex() );
+        appendString( methods.toString( value ) );
+    }
+}
+
+void
+JsonWriter::appendVector( const VectorDataType& vector )
+{
+    mBuffer += '[';
+    const bool typed = internal::anyOf<internal::Primitives>( [&]( auto tag )
+    {
+        return appendElements<typename decltype(tag)::type>( vector );
+    } );
+    if ( !typed )
+    {
+        const auto& methods = VariantMethodsManager::instance().get( vector.getElementType() );
+        for ( size_t i = 0; i < vector.size(); ++i )
+        {
+            if ( i )
+            {
+                mBuffer += ',';
+            }
+            appendString( methods.toString( vector[i] ) );
+        }
+    }
+    mBuffer += ']';
+}
+
+template<typename T>
+bool
+JsonWriter::appendElements( const VectorDataType& vector )
+{
+    if ( vector.getElementType() != typeid(T) )
+    {
+        return false;
+    }
+
+    const auto begin = vector.begin<T>();
+    const auto end = vector.end<T>();
+    for ( auto it = begin; it != end; ++it )
+    {
+        if ( it != begin )
+        {
+            mBuffer += ',';
+        }
+        appendValue<T>( *it );
+    }
+    return true;
+}
+
+template<typename T>
+bool
+JsonWriter::appendTyped( const Variant& value )
+{
+    if ( value.getTypeIndex() != typeid(T) )
+    {
+        return false;
+    }
+
+    // Refer to the stored value instead of copying it out by Variant::get()
+    appendValue<T>( static_cast<const Variant::Value<T>&>( *value.mValue ).mValue );
+    return true;
+}
+
+template<typename T>
+void
+JsonWriter::appendValue( const T& value )
+{
+    if constexpr ( std::is_same_v<T, bool> )
+    {
+        mBuffer += value ? "true" : "false";
+    }
+    else if constexpr ( std::is_same_v<T, std::string> )
+    {
+        appendString( value );
+    }
+    else
+    {
+        if constexpr ( std::is_floating_point_v<T> )
+        {
+            if ( !std::isfinite( value ) )
+            {
+                mBuffer += "null";
+                return;
+            }
+        }
+
+        const size_t size = mBuffer.size();
+        mBuffer.resize( size + MAX_NUMBER_CHARS );
+        auto result = std::to_chars( mBuffer.data() + size, mBuffer.data() + mBuffer.size(), value );
+        mBuffer.resize( result.ptr - mBuffer.data() );
+    }
+}
+
+void
+JsonWriter::appendString( std::string_view value )
+{
+    constexpr char HEX[] = "0123456789abcdef";
+
+    // Characters not needing escapes are appended in runs
+    mBuffer += '"';
+    const char* const end = value.data() + value.size();
+    const char* begin = value.data();
+    while ( true )
+    {
+        const char* special = internal::findJsonSpecial( begin, end );
+        mBuffer.append( begin, special );
+        if ( end == special )
+        {
+            break;
+        }
+
+        const auto c = static_cast<unsigned char>( *special );
+        begin = special + 1;
+        mBuffer += '\\';
+        switch ( c )
+        {
+            case '"':
+            case '\\':
+                mBuffer += static_cast<char>( c );
+                break;
+
+            case '\b':
+                mBuffer += 'b';
+                break;
+
+            case '\f':
+                mBuffer += 'f';
+                break;
+
+            case '\n':
+                mBuffer += 'n';
+                break;
+
+            case '\r':
+                mBuffer += 'r';
+                break;
+
+            case '\t':
+                mBuffer += 't';
+                break;
+
+            default:
+                mBuffer += "u00";
+                mBuffer += HEX[c >> 4];
+                mBuffer += HEX[c & 0xf];
+        }
+    }
+    mBuffer += '"';
+}
+
+} // end namespace workflow::type
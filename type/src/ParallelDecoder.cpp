@@ -0,0 +1,433 @@
+#include <workflow/type/ParallelDecoder.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <thread>
+#include <utility>
+
+#include <workflow/utils/Error.hpp>
+#include <workflow/utils/InternedString.hpp>
+
+#include <workflow/type/DataStream.hpp>
+#include <workflow/type/IVariantMethods.hpp>
+#include <workflow/type/StructDataType.hpp>
+#include <workflow/type/StructSchema.hpp>
+#include <workflow/type/VectorDataType.hpp>
+
+#include <internal/ParallelFor.hpp>
+#include <internal/Primitives.hpp>
+#include <internal/Skip.hpp>
+#include <internal/SpanStream.hpp>
+
+namespace workflow::type {
+namespace {
+
+using ElementDecoder = DecodeError (*)( DataStream& stream,
+                                        void* elements,
+                                        size_t begin,
+                                        size_t count );
+
+/**
+ * Decode a range of contiguous vector elements
+ */
+template<typename T>
+DecodeError
+decodeElements( DataStream& stream,
+                void* elements,
+                size_t begin,
+                size_t count )
+{
+    return stream.tryReadArray( static_cast<T*>( elements ) + begin, count );
+}
+
+} // end namespace
+
+/******************************************************************************
+ * A part of the buffer decoded on its own
+ *****************************************************************************/
+struct ParallelDecoder::Part
+{
+    enum class Kind
+    {
+        Whole,      ///< Decoded by IDataType::tryDeserialize()
+        Struct,     ///< Split into its attributes
+        Vector      ///< Split into chunks of elements
+    };
+
+    using Attribute = std::pair<utils::InternedString, size_t>;
+
+    Kind                    kind = Kind::Whole;
+
+    /// The serialized data type, only the elements of a split vector
+    Data                    data;
+
+    /// Number of nesting levels above the part
+    uint32_t                depth = 0;
+
+    /// Name of a split struct
+    utils::InternedString   name;
+
+    /// Names of the attributes of a split struct and the indices of their parts
+    std::vector<Attribute>  attributes;
+
+    /// The decoded data type. A split vector is allocated before decoding.
+    IDataTypeUniquePtr      value;
+
+    /// The elements of a split vector
+    void*                   elements = nullptr;
+
+    /// Encoded size of an element of a split vector
+    size_t                  stride = 0;
+
+    /// Decoder of the elements of a split vector
+    ElementDecoder          decodeElements = nullptr;
+};
+
+/******************************************************************************
+ * Parts decoded by one thread at once
+ *****************************************************************************/
+struct ParallelDecoder::Job
+{
+    /// The first part
+    size_t  first = 0;
+
+    /// Number of parts decoded as a whole, 0 for a chunk of vector elements
+    size_t  count = 0;
+
+    /// Range of the vector elements
+    size_t  begin = 0;
+    size_t  end = 0;
+};
+
+/*****************************************************************************/
+ParallelDecoder::ParallelDecoder( size_t threads,
+                                  size_t grainSize )
+    : mThreads( threads ? threads : std::max<size_t>( std::thread::hardware_concurrency(), 1 ) )
+    , mGrainSize( grainSize )
+{
+    SEQ_ASSERT_ARGUMENT( mGrainSize, "Invalid grain size" );
+}
+
+IDataTypeUniquePtr
+ParallelDecoder::deserialize( Data data,
+                              const DecodeLimits& limits ) const
+{
+    auto ret = tryDeserialize( data, limits );
+    SEQ_ASSERT_INVARIANT( ret, "Invalid stream: " << ret.error() );
+    return std::move(ret).value();
+}
+
+IDataType::DecodeResult
+ParallelDecoder::tryDeserialize( Data data,
+                                 const DecodeLimits& limits ) const
+{
+    // Split parts are followed by their attributes, so the loop visits them too
+    Parts parts;
+    parts.emplace_back().data = data;
+    for ( size_t i = 0; mThreads > 1 && i < parts.size(); ++i )
+    {
+        auto error = split( parts, i, limits );
+        if ( DecodeError::None != error )
+        {
+            return utils::makeUnexpected( error );
+        }
+    }
+
+    if ( Part::Kind::Whole == parts.front().kind )
+    {
+        DataStream stream( std::make_unique<internal::SpanStream>( data ) );
+        stream.setLimits( limits );
+        return IDataType::tryDeserialize( stream );
+    }
+
+    const auto jobs = schedule( parts );
+    std::vector<DecodeError> errors( jobs.size(), DecodeError::None );
+    internal::parallelFor( mThreads, jobs.size(), [&]( size_t i )
+    {
+        errors[i] = decode( parts, jobs[i], limits );
+        return DecodeError::None == errors[i];
+    } );
+
+    auto error = std::find_if( errors.begin(), errors.end(),
+                               []( DecodeError error ){ return DecodeError::None != error; } );
+    if ( errors.end() != error )
+    {
+        return utils::makeUnexpected( *error );
+    }
+
+    auto assembled = assemble( parts );
+    if ( DecodeError::None != assembled )
+    {
+        return utils::makeUnexpected( assembled );
+    }
+    return std::move( parts.front().value );
+}
+
+DecodeError
+ParallelDecoder::split( Parts& parts,
+                        size_t index,
+                        const DecodeLimits& limits ) const
+{
+    // Parts are appended below, do not keep references into them
+    const Data data = parts[index].data;
+    const uint32_t depth = parts[index].depth;
+    if ( data.size() <= mGrainSize )
+    {
+        return DecodeError::None;
+    }
+    if ( depth >= limits.maxDepth )
+    {
+        return DecodeError::NestingTooDeep;
+    }
+
+    // The total size is checked against the end of the part, the levels
+    // below the part are checked while skipping its attributes
+    DecodeLimits indexLimits = limits;
+    indexLimits.maxDepth -= depth + 1;
+    indexLimits.maxTotalBytes = std::numeric_limits<uint64_t>::max();
+
+    auto backend = std::make_unique<internal::SpanStream>( data );
+    auto& span = *backend;
+    DataStream stream( std::move(backend) );
+    stream.setLimits( indexLimits );
+
+    uint32_t type = 0;
+    uint32_t count = 0;
+    auto error = stream.tryRead( type );
+    if ( DecodeError::None != error )
+    {
+        return error;
+    }
+
+    if ( static_cast<uint32_t>( IDataType::Type::Struct ) == type )
+    {
+        utils::InternedString name;
+        error = stream.tryRead( name );
+        if ( DecodeError::None == error && name.empty() )
+        {
+            error = DecodeError::InvalidName;
+        }
+        if ( DecodeError::None == error )
+        {
+            error = stream.tryRead( count );
+        }
+        if ( DecodeError::None == error && count > limits.maxElementCount )
+        {
+            error = DecodeError::TooManyElements;
+        }
+        if ( DecodeError::None != error )
+        {
+            return error;
+        }
+
+        std::vector<Part::Attribute> attributes;
+        attributes.reserve( stream.getReserveHint( count, 2 * sizeof(uint32_t) ) );
+        for ( uint32_t i = 0; i < count; ++i )
+        {
+            utils::InternedString attributeName;
+            error = stream.tryRead( attributeName );
+            if ( DecodeError::None == error && attributeName.empty() )
+            {
+                error = DecodeError::InvalidName;
+            }
+            const size_t begin = span.getPosition();
+            if ( DecodeError::None == error )
+            {
+                error = internal::skipDataType( stream );
+            }
+            if ( DecodeError::None != error )
+            {
+                return error;
+            }
+
+            attributes.emplace_back( attributeName, parts.size() );
+            auto& attribute = parts.emplace_back();
+            attribute.data = Data( data.data() + begin, span.getPosition() - begin );
+            attribute.depth = depth + 1;
+        }
+        if ( span.getPosition() > limits.maxTotalBytes )
+        {
+            return DecodeError::TotalSizeExceeded;
+        }
+
+        auto& part = parts[index];
+        part.kind = Part::Kind::Struct;
+        part.name = name;
+        part.attributes = std::move(attributes);
+    }
+    else if ( static_cast<uint32_t>( IDataType::Type::Vector ) == type )
+    {
+        const IVariantMethods* methods = nullptr;
+        uint64_t hash = 0;
+        error = internal::readMethods( stream, methods, hash );
+        if ( DecodeError::None == error )
+        {
+            error = stream.tryRead( count );
+        }
+        if ( DecodeError::None == error && count > limits.maxElementCount )
+        {
+            error = DecodeError::TooManyElements;
+        }
+        if ( DecodeError::None != error )
+        {
+            return error;
+        }
+
+        // Only numbers have a fixed encoding and contiguous storage
+        const size_t encoding = internal::getEncodedSize( hash );
+        if ( internal::UNKNOWN_ENCODING == encoding || internal::STRING_ENCODING == encoding )
+        {
+            return DecodeError::None;
+        }
+        if ( count > span.available() / encoding )
+        {
+            return DecodeError::EndOfStream;
+        }
+        if ( span.getPosition() + count * encoding > limits.maxTotalBytes )
+        {
+            return DecodeError::TotalSizeExceeded;
+        }
+
+        const auto elementType = methods->create();
+        auto& part = parts[index];
+        const bool number = internal::anyOf<internal::Numbers>( [&]( auto tag )
+        {
+            return allocate<typename decltype(tag)::type>( part, elementType, count );
+        } );
+        if ( number )
+        {
+            part.data = Data( span.current(), count * encoding );
+        }
+    }
+    return DecodeError::None;
+}
+
+template<typename T>
+bool
+ParallelDecoder::allocate( Part& part,
+                           const Variant& type,
+                           uint32_t count )
+{
+    if ( type.getTypeIndex() != typeid(T) )
+    {
+        return false;
+    }
+
+    std::unique_ptr<VectorDataType> vector( new VectorDataType() );
+    vector->mType = type;
+    vector->mStorage = VectorDataType::createStorage( typeid(T) );
+    auto& values = vector->getStorage<T>().mValues;
+    values.resize( count );
+
+    part.kind = Part::Kind::Vector;
+    part.elements = values.data();
+    part.stride = 1 + sizeof(T);
+    part.decodeElements = &decodeElements<T>;
+    part.value = std::move(vector);
+    return true;
+}
+
+ParallelDecoder::Jobs
+ParallelDecoder::schedule( const Parts& parts ) const
+{
+    Jobs jobs;
+    size_t bytes = 0;
+    for ( size_t i = 0; i < parts.size(); ++i )
+    {
+        const auto& part = parts[i];
+        if ( Part::Kind::Vector == part.kind )
+        {
+            const size_t count = part.data.size() / part.stride;
+            const size_t chunk = std::max<size_t>( mGrainSize / part.stride, 1 );
+            for ( size_t begin = 0; begin < count; begin += chunk )
+            {
+                jobs.push_back( Job{ i, 0, begin, std::min( count, begin + chunk ) } );
+            }
+        }
+        else if ( Part::Kind::Whole == part.kind )
+        {
+            // Neighbouring small parts are decoded by the same job
+            auto* last = jobs.empty() ? nullptr : &jobs.back();
+            if ( last && last->count && last->first + last->count == i
+                 && bytes + part.data.size() <= mGrainSize )
+            {
+                ++last->count;
+                bytes += part.data.size();
+            }
+            else
+            {
+                jobs.push_back( Job{ i, 1, 0, 0 } );
+                bytes = part.data.size();
+            }
+        }
+    }
+    return jobs;
+}
+
+DecodeError
+ParallelDecoder::decode( Parts& parts,
+                         const Job& job,
+                         const DecodeLimits& limits )
+{
+    if ( !job.count )
+    {
+        auto& part = parts[job.first];
+        const size_t count = job.end - job.begin;
+        DataStream stream( std::make_unique<internal::SpanStream>(
+            Data( part.data.data() + job.begin * part.stride, count * part.stride ) ) );
+        stream.setLimits( limits );
+        return part.decodeElements( stream, part.elements, job.begin, count );
+    }
+
+    for ( size_t i = job.first; i < job.first + job.count; ++i )
+    {
+        auto& part = parts[i];
+        DecodeLimits partLimits = limits;
+        partLimits.maxDepth -= part.depth;
+
+        DataStream stream( std::make_unique<internal::SpanStream>( part.data ) );
+        stream.setLimits( partLimits );
+        auto value = IDataType::tryDeserialize( stream );
+        if ( !value )
+        {
+            return value.error();
+        }
+        part.value = std::move(value).value();
+    }
+    return DecodeError::None;
+}
+
+DecodeError
+ParallelDecoder::assemble( Parts& parts )
+{
+    // Attributes follow their struct, going backwards they are complete first
+    for ( size_t i = parts.size(); i-- > 0; )
+    {
+        auto& part = parts[i];
+        if ( Part::Kind::Struct != part.kind )
+        {
+            continue;
+        }
+
+        std::unique_ptr<StructDataType> value( new StructDataType() );
+        StructSchema::Attributes attributes;
+        attributes.reserve( part.attributes.size() );
+        value->mValues.reserve( part.attributes.size() );
+        for ( const auto& [name, index]: part.attributes )
+        {
+            IDataTypeSharedPtr attribute( std::move( parts[index].value ) );
+            attributes.push_back( StructSchema::describe( name, *attribute ) );
+            value->mValues.push_back( std::move(attribute) );
+        }
+
+        auto error = value->finishDecode( part.name, std::move(attributes) );
+        if ( DecodeError::None != error )
+        {
+            return error;
+        }
+        part.value = std::move(value);
+    }
+    return DecodeError::None;
+}
+
+} // end namespace workflow::type
@@ -0,0 +1,345 @@
+#include <workflow/type/ParallelEncoder.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <utility>
+
+#include <workflow/utils/Error.hpp>
+#include <workflow/utils/Overloaded.hpp>
+#include <workflow/utils/Span.hpp>
+
+#include <workflow/type/DataStream.hpp>
+#include <workflow/type/VariantMethodsManager.hpp>
+#include <workflow/type/Visit.hpp>
+
+#include <internal/BufferStream.hpp>
+#include <internal/ParallelFor.hpp>
+#include <internal/Primitives.hpp>
+
+namespace workflow::type {
+namespace {
+
+// Estimated size of a data type id followed by a variant type hash
+constexpr size_t HEADER_SIZE = 5 + 9;
+
+// Estimated size of a value not of fixed size
+constexpr size_t VALUE_SIZE = 9;
+
+using ElementEncoder = void (*)( DataStream& stream,
+                                 const VectorDataType& vector,
+                                 size_t begin,
+                                 size_t end );
+
+/**
+ * Encode a range of contiguous vector elements
+ */
+template<typename T>
+void
+encodeElements( DataStream& stream,
+                const VectorDataType& vector,
+                size_t begin,
+                size_t end )
+{
+    stream.writeArray( vector.getSpan<T>().data() + begin, end - begin );
+}
+
+template<typename T>
+bool
+findEncoder( const VectorDataType& vector,
+             ElementEncoder& encoder,
+             size_t& stride )
+{
+    if ( vector.getElementType() != typeid(T) )
+    {
+        return false;
+    }
+    encoder = &encodeElements<T>;
+    stride = 1 + sizeof(T);
+    return true;
+}
+
+/**
+ * Find the encoder of a vector of numbers
+ *
+ * @param [in]  vector      The vector
+ * @param [out] encoder     The encoder of its elements
+ * @param [out] stride      The encoded size of an element
+ *
+ * @return False if the elements are not numbers
+ */
+bool
+findEncoder( const VectorDataType& vector,
+             ElementEncoder& encoder,
+             size_t& stride )
+{
+    return internal::anyOf<internal::Numbers>( [&]( auto tag )
+    {
+        return findEncoder<typename decltype(tag)::type>( vector, encoder, stride );
+    } );
+}
+
+} // end namespace
+
+/******************************************************************************
+ * A part of the encoding written on its own
+ *****************************************************************************/
+struct ParallelEncoder::Piece
+{
+    enum class Kind
+    {
+        Literal,    ///< Headers of split structs and vectors
+        Whole,      ///< Written by IDataType::serialize()
+        Elements    ///< Chunk of the elements of a vector
+    };
+
+    Kind                kind = Kind::Literal;
+
+    /// The data type written as a whole or the vector
+    const IDataType*    value = nullptr;
+
+    /// Range of the literal bytes or the vector elements
+    size_t              begin = 0;
+    size_t              end = 0;
+
+    /// Estimated encoded size
+    size_t              size = 0;
+
+    /// Encoder of the vector elements
+    ElementEncoder      encodeElements = nullptr;
+};
+
+/******************************************************************************
+ * Pieces written to the same buffer
+ *****************************************************************************/
+struct ParallelEncoder::Job
+{
+    size_t  first = 0;
+    size_t  count = 0;
+};
+
+/*****************************************************************************/
+ParallelEncoder::ParallelEncoder( size_t threads,
+                                  size_t grainSize )
+    : mThreads( threads ? threads : std::max<size_t>( std::thread::hardware_concurrency(), 1 ) )
+    , mGrainSize( grainSize )
+{
+    SEQ_ASSERT_ARGUMENT( mGrainSize, "Invalid grain size" );
+}
+
+void
+ParallelEncoder::serialize( DataStream& stream,
+                            const IDataType& dataType ) const
+{
+    if ( mThreads < 2 || stream.hasSchemaDictionary() )
+    {
+        IDataType::serialize( stream, dataType );
+        return;
+    }
+
+    std::vector<uint8_t> literals;
+    const auto pieces = split( dataType, literals );
+    if ( 1 == pieces.size() )
+    {
+        IDataType::serialize( stream, dataType );
+        return;
+    }
+
+    const auto jobs = schedule( pieces );
+    std::vector<std::unique_ptr<DataStream>> streams( jobs.size() );
+    std::vector<const internal::BufferStream*> buffers( jobs.size() );
+    internal::parallelFor( mThreads, jobs.size(), [&]( size_t i )
+    {
+        auto backend = std::make_unique<internal::BufferStream>();
+        buffers[i] = backend.get();
+        streams[i] = std::make_unique<DataStream>( std::move(backend) );
+        encode( *streams[i], pieces, jobs[i], literals );
+        return true;
+    } );
+
+    std::vector<utils::Span<const uint8_t>> data;
+    data.reserve( buffers.size() );
+    for ( const auto* buffer: buffers )
+    {
+        data.emplace_back( buffer->getData().data(), buffer->getData().size() );
+    }
+    stream.writeGather( { data.data(), data.size() } );
+}
+
+size_t
+ParallelEncoder::estimate( const IDataType& dataType ) const
+{
+    size_t size = 0;
+    std::vector<const IDataType*> pending{ &dataType };
+    while ( !pending.empty() && size <= mGrainSize )
+    {
+        const auto* node = pending.back();
+        pending.pop_back();
+        size += HEADER_SIZE;
+        visit( *node, utils::Overloaded{
+            [&size]( const VariantDataType& )
+            {
+                size += VALUE_SIZE;
+            },
+            [&size]( const VectorDataType& vector )
+            {
+                ElementEncoder encoder = nullptr;
+                size_t stride = VALUE_SIZE;
+                findEncoder( vector, encoder, stride );
+                size += vector.size() * stride;
+            },
+            [&size, &pending]( const StructDataType& value )
+            {
+                const auto& names = value.getAttributeNames();
+                size += value.getSchema()->getName().size();
+                for ( size_t i = 0; i < names.size(); ++i )
+                {
+                    size += sizeof(uint32_t) + 1 + names[i].view().size();
+                    pending.push_back( &value.get( i ) );
+                }
+            } } );
+    }
+    return size;
+}
+
+ParallelEncoder::Pieces
+ParallelEncoder::split( const IDataType& dataType,
+                        std::vector<uint8_t>& literals ) const
+{
+    auto backend = std::make_unique<internal::BufferStream>();
+    const auto& buffer = *backend;
+    DataStream stream( std::move(backend) );
+
+    Pieces pieces;
+    size_t literalStart = 0;
+    auto flushLiteral = [&]()
+    {
+        const size_t literalEnd = buffer.getData().size();
+        if ( literalEnd > literalStart )
+        {
+            auto& piece = pieces.emplace_back();
+            piece.begin = literalStart;
+            piece.end = literalEnd;
+            piece.size = literalEnd - literalStart;
+            literalStart = literalEnd;
+        }
+    };
+
+    // Split structs are written attribute by attribute, the stack holds the
+    // next attribute of each of them
+    std::vector<std::pair<const StructDataType*, size_t>> stack;
+    auto add = [&]( const IDataType& value )
+    {
+        const size_t size = estimate( value );
+        if ( size > mGrainSize && IDataType::Type::Struct == value.getType() )
+        {
+            const auto& node = static_cast<const StructDataType&>( value );
+            stream.write( static_cast<uint32_t>( IDataType::Type::Struct ) );
+            stream.write( node.getSchema()->getInternedName() );
+            stream.write( static_cast<uint32_t>( node.getAttributeNames().size() ) );
+            stack.emplace_back( &node, 0 );
+            return;
+        }
+
+        ElementEncoder encoder = nullptr;
+        size_t stride = 0;
+        if ( size > mGrainSize && IDataType::Type::Vector == value.getType()
+             && findEncoder( static_cast<const VectorDataType&>( value ), encoder, stride ) )
+        {
+            const auto& vector = static_cast<const VectorDataType&>( value );
+            SEQ_ASSERT_INVARIANT( vector.size() < std::numeric_limits<uint32_t>::max(),
+                                  "Too many elements" );
+            const auto& manager = VariantMethodsManager::instance();
+            stream.write( static_cast<uint32_t>( IDataType::Type::Vector ) );
+            stream.write( manager.calculateHash( vector.getElementType() ).value );
+            stream.write( static_cast<uint32_t>( vector.size() ) );
+            flushLiteral();
+
+            const size_t chunk = std::max<size_t>( mGrainSize / stride, 1 );
+            for ( size_t begin = 0; begin < vector.size(); begin += chunk )
+            {
+                auto& piece = pieces.emplace_back();
+                piece.kind = Piece::Kind::Elements;
+                piece.value = &vector;
+                piece.begin = begin;
+                piece.end = std::min( vector.size(), begin + chunk );
+                piece.size = ( piece.end - piece.begin ) * stride;
+                piece.encodeElements = encoder;
+            }
+            return;
+        }
+
+        flushLiteral();
+        auto& piece = pieces.emplace_back();
+        piece.kind = Piece::Kind::Whole;
+        piece.value = &value;
+        piece.size = size;
+    };
+
+    add( dataType );
+    while ( !stack.empty() )
+    {
+        auto& [node, next] = stack.back();
+        if ( next == node->getAttributeNames().size() )
+        {
+            stack.pop_back();
+            continue;
+        }
+
+        const size_t index = next++;
+        stream.write( node->getAttributeNames()[index] );
+        add( node->get( index ) );
+    }
+    flushLiteral();
+
+    literals = buffer.getData();
+    return pieces;
+}
+
+ParallelEncoder::Jobs
+ParallelEncoder::schedule( const Pieces& pieces ) const
+{
+    Jobs jobs;
+    size_t size = 0;
+    for ( size_t i = 0; i < pieces.size(); ++i )
+    {
+        if ( jobs.empty() || size >= mGrainSize )
+        {
+            jobs.push_back( Job{ i, 0 } );
+            size = 0;
+        }
+        ++jobs.back().count;
+        size += pieces[i].size;
+    }
+    return jobs;
+}
+
+void
+ParallelEncoder::encode( DataStream& stream,
+                         const Pieces& pieces,
+                         const Job& job,
+                         const std::vector<uint8_t>& literals )
+{
+    for ( size_t i = job.first; i < job.first + job.count; ++i )
+    {
+        const auto& piece = pieces[i];
+        switch ( piece.kind )
+        {
+            case Piece::Kind::Literal:
+                stream.write( piece.end - piece.begin, literals.data() + piece.begin );
+                break;
+
+            case Piece::Kind::Whole:
+                IDataType::serialize( stream, *piece.value );
+                break;
+
+            case Piece::Kind::Elements:
+                piece.encodeElements( stream, static_cast<const VectorDataType&>( *piece.value ),
+                                      piece.begin, piece.end );
+                break;
+        }
+    }
+}
+
+} // end namespace workflow::type
@@ -0,0 +1,78 @@
+#include <internal/ParallelFor.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace workflow::type::internal {
+
+void
+parallelFor( size_t threads,
+             size_t count,
+             const std::function<bool( size_t )>& task )
+{
+    std::atomic<size_t> next{ 0 };
+    std::atomic<bool> failed{ false };
+    std::exception_ptr exception;
+    std::mutex mutex;
+
+    auto work = [&]
+    {
+        try
+        {
+            while ( !failed )
+            {
+                const size_t i = next++;
+                if ( i >= count )
+                {
+                    break;
+                }
+                if ( !task( i ) )
+                {
+                    failed = true;
+                }
+            }
+        }
+        catch ( ... )
+        {
+            std::lock_guard<std::mutex> lock( mutex );
+            if ( !exception )
+            {
+                exception = std::current_exception();
+            }
+            failed = true;
+        }
+    };
+
+    std::vector<std::thread> helpers;
+    const size_t numHelpers = std::max<size_t>( std::min( threads, count ), 1 ) - 1;
+    helpers.reserve( numHelpers );
+    for ( size_t i = 0; i < numHelpers; ++i )
+    {
+        try
+        {
+            helpers.emplace_back( work );
+        }
+        catch ( const std::system_error& )
+        {
+            // Continue with the threads that could be started
+            break;
+        }
+    }
+    work();
+    for ( auto& helper: helpers )
+    {
+        helper.join();
+    }
+
+    if ( exception )
+    {
+        std::rethrow_exception( exception );
+    }
+}
+
+} // end namespace workflow::type::internal
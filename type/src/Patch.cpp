@@ -0,0 +1,360 @@
+#include <workflow/type/Patch.hpp>
+
+#include <algorithm>
+
+#include <workflow/utils/Error.hpp>
+
+#include <workflow/type/DataStream.hpp>
+#include <workflow/type/IVariantMethods.hpp>
+#include <workflow/type/StructDataType.hpp>
+#include <workflow/type/VariantMethodsManager.hpp>
+#include <workflow/type/VectorDataType.hpp>
+
+namespace workflow::type {
+namespace {
+
+/**
+ * Create an empty vector of an element type
+ */
+std::shared_ptr<VectorDataType>
+createVector( const std::type_index& type )
+{
+    return std::make_shared<VectorDataType>( VariantMethodsManager::instance().get( type ).create() );
+}
+
+} // end namespace
+
+Patch
+Patch::create( const std::shared_ptr<const IDataType>& from,
+               const std::shared_ptr<const IDataType>& to )
+{
+    SEQ_ASSERT_ARGUMENT( from && to, "No data type" );
+
+    Patch ret;
+    ret.mFrom = from->getContentHash();
+    ret.mTo = to->getContentHash();
+
+    Path path;
+    diff( *from, to, path, ret.mChanges );
+    return ret;
+}
+
+std::shared_ptr<const IDataType>
+Patch::apply( const std::shared_ptr<const IDataType>& root ) const
+{
+    SEQ_ASSERT_ARGUMENT( root, "No data type" );
+    SEQ_ASSERT_ARGUMENT( root->getContentHash() == mFrom, "The patch was created for another data type" );
+
+    // The tree is only shared, every node on a changed path is copied
+    auto ret = std::const_pointer_cast<IDataType>( root );
+    for ( const auto& change: mChanges )
+    {
+        ret = applyChange( ret, change, 0 );
+    }
+    SEQ_ASSERT_INVARIANT( ret->getContentHash() == mTo, "The patch did not produce the expected data type" );
+    return ret;
+}
+
+void
+Patch::serialize( DataStream& stream ) const
+{
+    stream.write( mFrom );
+    stream.write( mTo );
+    stream.write( static_cast<uint32_t>( mChanges.size() ) );
+    for ( const auto& change: mChanges )
+    {
+        stream.write( static_cast<uint32_t>( change.operation ) );
+        stream.write( static_cast<uint32_t>( change.path.size() ) );
+        for ( const auto& name: change.path )
+        {
+            stream.write( name );
+        }
+
+        if ( Operation::Splice == change.operation )
+        {
+            stream.write( change.offset );
+            stream.write( change.removed );
+        }
+        if ( Operation::Remove != change.operation )
+        {
+            IDataType::serialize( stream, *change.value );
+        }
+    }
+}
+
+utils::Expected<Patch, DecodeError>
+Patch::tryDeserialize( DataStream& stream )
+{
+    const auto& limits = stream.getLimits();
+
+    Patch ret;
+    uint32_t count = 0;
+    auto error = stream.tryRead( ret.mFrom );
+    error = DecodeError::None == error ? stream.tryRead( ret.mTo ) : error;
+    error = DecodeError::None == error ? stream.tryRead( count ) : error;
+    if ( DecodeError::None != error )
+    {
+        return utils::makeUnexpected( error );
+    }
+    if ( count > limits.maxElementCount )
+    {
+        return utils::makeUnexpected( DecodeError::TooManyElements );
+    }
+
+    ret.mChanges.reserve( stream.getReserveHint( count, 2 * ( 1 + sizeof(uint32_t) ) ) );
+    for ( uint32_t i = 0; i < count; ++i )
+    {
+        auto& change = ret.mChanges.emplace_back();
+        uint32_t operation = 0;
+        uint32_t length = 0;
+        error = stream.tryRead( operation );
+        error = DecodeError::None == error ? stream.tryRead( length ) : error;
+        if ( DecodeError::None != error )
+        {
+            return utils::makeUnexpected( error );
+        }
+        if ( operation < static_cast<uint32_t>( Operation::Set )
+             || operation > static_cast<uint32_t>( Operation::Splice ) )
+        {
+            return utils::makeUnexpected( DecodeError::InvalidValue );
+        }
+        if ( length > limits.maxDepth )
+        {
+            return utils::makeUnexpected( DecodeError::NestingTooDeep );
+        }
+        change.operation = static_cast<Operation>( operation );
+
+        change.path.resize( length );
+        for ( auto& name: change.path )
+        {
+            error = stream.tryRead( name );
+            if ( DecodeError::None != error )
+            {
+                return utils::makeUnexpected( error );
+            }
+            if ( name.empty() )
+            {
+                return utils::makeUnexpected( DecodeError::InvalidName );
+            }
+        }
+
+        switch ( change.operation )
+        {
+            case Operation::Remove:
+                if ( change.path.empty() )
+                {
+                    return utils::makeUnexpected( DecodeError::InvalidValue );
+                }
+                continue;
+
+            case Operation::Splice:
+                error = stream.tryRead( change.offset );
+                error = DecodeError::None == error ? stream.tryRead( change.removed ) : error;
+                if ( DecodeError::None != error )
+                {
+                    return utils::makeUnexpected( error );
+                }
+                break;
+
+            case Operation::Set:
+                break;
+        }
+
+        auto value = IDataType::tryDeserialize( stream );
+        if ( !value )
+        {
+            return utils::makeUnexpected( value.error() );
+        }
+        if ( Operation::Splice == change.operation && IDataType::Type::Vector != ( *value )->getType() )
+        {
+            return utils::makeUnexpected( DecodeError::TypeMismatch );
+        }
+        change.value = std::move(value).value();
+    }
+    return ret;
+}
+
+void
+Patch::diff( const IDataType& from,
+             const std::shared_ptr<const IDataType>& to,
+             Path& path,
+             Changes& changes )
+{
+    // Different hashes are conclusive, equal ones are confirmed
+    if ( &from == to.get()
+         || ( from.getContentHash() == to->getContentHash() && from.equals( *to ) ) )
+    {
+        return;
+    }
+
+    const auto type = to->getType();
+    if ( type == from.getType() && IDataType::Type::Struct == type )
+    {
+        const auto& lhs = static_cast<const StructDataType&>( from );
+        const auto& rhs = static_cast<const StructDataType&>( *to );
+        if ( lhs.getInternedName() == rhs.getInternedName() )
+        {
+            diffStruct( lhs, rhs, path, changes );
+            return;
+        }
+    }
+    else if ( type == from.getType() && IDataType::Type::Vector == type )
+    {
+        const auto& lhs = static_cast<const VectorDataType&>( from );
+        const auto& rhs = static_cast<const VectorDataType&>( *to );
+        if ( lhs.getElementType() == rhs.getElementType() )
+        {
+            diffVector( lhs, rhs, path, changes );
+            return;
+        }
+    }
+
+    changes.push_back( Change{ Operation::Set, path, to } );
+}
+
+void
+Patch::diffStruct( const StructDataType& from,
+                   const StructDataType& to,
+                   Path& path,
+                   Changes& changes )
+{
+    // The attributes of both are ordered by name
+    const auto& lhs = from.getAttributeNames();
+    const auto& rhs = to.getAttributeNames();
+    size_t i = 0;
+    size_t j = 0;
+    while ( i < lhs.size() || j < rhs.size() )
+    {
+        if ( j == rhs.size() || ( i < lhs.size() && lhs[i].str() < rhs[j].str() ) )
+        {
+            path.push_back( lhs[i++].str() );
+            changes.push_back( Change{ Operation::Remove, path, nullptr } );
+        }
+        else if ( i == lhs.size() || rhs[j].str() < lhs[i].str() )
+        {
+            path.push_back( rhs[j].str() );
+            changes.push_back( Change{ Operation::Set, path, to.mValues[j++] } );
+        }
+        else
+        {
+            path.push_back( rhs[j].str() );
+            diff( *from.mValues[i++], to.mValues[j++], path, changes );
+        }
+        path.pop_back();
+    }
+}
+
+void
+Patch::diffVector( const VectorDataType& from,
+                   const VectorDataType& to,
+                   Path& path,
+                   Changes& changes )
+{
+    const size_t lhs = from.size();
+    const size_t rhs = to.size();
+    size_t prefix = 0;
+    while ( prefix < lhs && prefix < rhs && from[prefix] == to[prefix] )
+    {
+        ++prefix;
+    }
+    size_t suffix = 0;
+    while ( suffix < lhs - prefix && suffix < rhs - prefix
+            && from[lhs - suffix - 1] == to[rhs - suffix - 1] )
+    {
+        ++suffix;
+    }
+
+    auto elements = createVector( to.getElementType() );
+    elements->reserve( rhs - prefix - suffix );
+    for ( size_t i = prefix; i < rhs - suffix; ++i )
+    {
+        elements->push_back( to[i] );
+    }
+    changes.push_back( Change{ Operation::Splice, path, std::move(elements),
+                               static_cast<uint32_t>( prefix ),
+                               static_cast<uint32_t>( lhs - prefix - suffix ) } );
+}
+
+IDataTypeSharedPtr
+Patch::applyChange( const IDataTypeSharedPtr& node,
+                    const Change& change,
+                    size_t depth )
+{
+    if ( depth == change.path.size() )
+    {
+        SEQ_ASSERT_ARGUMENT( Operation::Remove != change.operation, "Cannot remove the root" );
+        if ( Operation::Set == change.operation )
+        {
+            return std::const_pointer_cast<IDataType>( change.value );
+        }
+
+        SEQ_ASSERT_ARGUMENT( IDataType::Type::Vector == node->getType(), "Splice of a "
+                             << node->getName() );
+        const auto& vector = static_cast<const VectorDataType&>( *node );
+        const auto& elements = static_cast<const VectorDataType&>( *change.value );
+        SEQ_ASSERT_ARGUMENT( vector.getElementType() == elements.getElementType(),
+                             "Splice of " << elements.getName() << " into " << vector.getName() );
+        SEQ_ASSERT_ARGUMENT( change.offset <= vector.size()
+                             && change.removed <= vector.size() - change.offset,
+                             "Splice out of range" );
+
+        auto ret = createVector( vector.getElementType() );
+        ret->reserve( vector.size() - change.removed + elements.size() );
+        for ( size_t i = 0; i < change.offset; ++i )
+        {
+            ret->push_back( vector[i] );
+        }
+        for ( const auto& element: elements )
+        {
+            ret->push_back( element );
+        }
+        for ( size_t i = change.offset + change.removed; i < vector.size(); ++i )
+        {
+            ret->push_back( vector[i] );
+        }
+        return ret;
+    }
+
+    const auto& name = change.path[depth];
+    SEQ_ASSERT_ARGUMENT( IDataType::Type::Struct == node->getType(),
+                         "Attribute '" << name << "' is not in a struct" );
+    const auto& parent = static_cast<const StructDataType&>( *node );
+    const auto& schema = parent.mSchema;
+    auto attributes = schema->getAttributes();
+    auto values = parent.mValues;
+
+    const bool last = depth + 1 == change.path.size();
+    const auto index = schema->find( name );
+    if ( StructSchema::npos == index )
+    {
+        SEQ_ASSERT_ARGUMENT( last && Operation::Set == change.operation,
+                             "No attribute called '" << name << "'" );
+        auto value = std::const_pointer_cast<IDataType>( change.value );
+        auto it = std::lower_bound( attributes.begin(), attributes.end(), name,
+                                    []( const StructSchema::Attribute& attribute, const std::string& name )
+                                    {
+                                        return attribute.name.str() < name;
+                                    } );
+        values.insert( values.begin() + ( it - attributes.begin() ), value );
+        attributes.insert( it, StructSchema::describe( utils::InternedString( name ), *value ) );
+    }
+    else if ( last && Operation::Remove == change.operation )
+    {
+        attributes.erase( attributes.begin() + index );
+        values.erase( values.begin() + index );
+    }
+    else
+    {
+        values[index] = applyChange( values[index], change, depth + 1 );
+        attributes[index] = StructSchema::describe( attributes[index].name, *values[index] );
+        if ( attributes[index] == schema->getAttributes()[index] )
+        {
+            return std::make_shared<StructDataType>( schema, std::move(values) );
+        }
+    }
+    return std::make_shared<StructDataType>( StructSchema::get( schema->getInternedName(),
+                                                                std::move(attributes) ),
+                                             std::move(values) );
+}
+
+} // end namespace workflow::type
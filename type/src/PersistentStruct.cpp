@@ -0,0 +1,95 @@
+#include <workflow/type/PersistentStruct.hpp>
+
+#include <workflow/utils/Error.hpp>
+
+#include <workflow/type/VariantDataType.hpp>
+
+namespace workflow::type {
+namespace {
+
+/**
+ * Split the first name off a path
+ */
+std::string_view
+nextName( std::string_view& path )
+{
+    const auto separator = path.find( '.' );
+    const auto name = path.substr( 0, separator );
+    path = std::string_view::npos == separator ? std::string_view() : path.substr( separator + 1 );
+    SEQ_ASSERT_ARGUMENT( !name.empty(), "Invalid attribute path" );
+    return name;
+}
+
+} // end namespace
+
+PersistentStruct::PersistentStruct( std::shared_ptr<const StructDataType> root )
+    : mRoot( std::const_pointer_cast<StructDataType>( std::move(root) ) )
+{
+    SEQ_ASSERT_ARGUMENT( mRoot, "No root" );
+}
+
+const IDataType&
+PersistentStruct::get( std::string_view path ) const
+{
+    const IDataType* node = mRoot.get();
+    do
+    {
+        const auto name = nextName( path );
+        SEQ_ASSERT_ARGUMENT( IDataType::Type::Struct == node->getType(),
+                             "Attribute '" << name << "' is not in a struct" );
+        node = &static_cast<const StructDataType*>( node )->get( std::string( name ) );
+    }
+    while ( !path.empty() );
+    return *node;
+}
+
+void
+PersistentStruct::set( std::string_view path,
+                       IDataTypeSharedPtr value )
+{
+    SEQ_ASSERT_ARGUMENT( value, "No value" );
+
+    // Every struct on the path changes, the hashes of all others stay valid
+    StructDataType* node = &makeUnique( mRoot );
+    node->mContentHash.reset();
+    auto name = nextName( path );
+    while ( !path.empty() )
+    {
+        auto& child = node->mValues[node->indexOf( std::string( name ) )];
+        SEQ_ASSERT_ARGUMENT( IDataType::Type::Struct == child->getType(),
+                             "Attribute '" << name << "' is not a struct" );
+        node = &makeUnique( child );
+        node->mContentHash.reset();
+        name = nextName( path );
+    }
+
+    const auto index = node->indexOf( std::string( name ) );
+    const auto& attribute = node->mSchema->getAttributes()[index];
+    SEQ_ASSERT_ARGUMENT( StructSchema::describe( attribute.name, *value ) == attribute,
+                         "Invalid value for attribute '" << attribute.name << "'" );
+    node->mValues[index] = std::move(value);
+}
+
+void
+PersistentStruct::set( std::string_view path,
+                       Variant value )
+{
+    set( path, std::make_shared<VariantDataType>( std::move(value) ) );
+}
+
+template<typename T>
+StructDataType&
+PersistentStruct::makeUnique( std::shared_ptr<T>& node )
+{
+    if ( node.use_count() > 1 )
+    {
+        const auto& shared = static_cast<const StructDataType&>( *node );
+        std::shared_ptr<StructDataType> copy( new StructDataType() );
+        copy->mSchema = shared.mSchema;
+        copy->mValues = shared.mValues;
+        node = std::move(copy);
+    }
+    return static_cast<StructDataType&>( *node );
+}
+
+} // end namespace workflow::type
@@ -0,0 +1,66 @@
+#include <workflow/type/Projection.hpp>
+
+#include <algorithm>
+
+#include <workflow/utils/Error.hpp>
+
+namespace workflow::type {
+
+Projection::Projection( std::initializer_list<std::string_view> paths )
+{
+    for ( auto path: paths )
+    {
+        add( path );
+    }
+}
+
+Projection&
+Projection::add( std::string_view path )
+{
+    Projection* current = this;
+    while ( !current->mAll )
+    {
+        const auto separator = path.find( '.' );
+        const auto name = path.substr( 0, separator );
+        SEQ_ASSERT_ARGUMENT( !name.empty(), "Invalid attribute path '" << path << "'" );
+
+        auto& children = current->mChildren;
+        auto it = std::lower_bound( children.begin(), children.end(), name,
+                                    []( const Child& child, std::string_view name )
+                                    {
+                                        return child.first < name;
+                                    } );
+        if ( children.end() == it || it->first != name )
+        {
+            it = children.insert( it, Child( std::string( name ), Projection() ) );
+        }
+        current = &it->second;
+
+        if ( std::string_view::npos == separator )
+        {
+            // The whole attribute supersedes any path into it
+            current->mAll = true;
+            current->mChildren.clear();
+            break;
+        }
+        path.remove_prefix( separator + 1 );
+    }
+    return *this;
+}
+
+const Projection*
+Projection::find( std::string_view name ) const noexcept
+{
+    auto it = std::lower_bound( mChildren.begin(), mChildren.end(), name,
+                                []( const Child& child, std::string_view name )
+                                {
+                                    return child.first < name;
+                                } );
+    if ( mChildren.end() == it || it->first != name )
+    {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+} // end namespace workflow::type
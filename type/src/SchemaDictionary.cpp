@@ -0,0 +1,186 @@
+#include <internal/SchemaDictionary.hpp>
+
+#include <limits>
+
+#include <workflow/utils/Error.hpp>
+
+#include <workflow/type/DataStream.hpp>
+#include <workflow/type/IVariantMethods.hpp>
+#include <workflow/type/VariantMethodsManager.hpp>
+
+namespace workflow::type::internal {
+
+void
+SchemaDictionary::write( DataStream& stream,
+                         const StructSchemaSharedPtr& schema )
+{
+    auto it = mWriteIds.find( schema.get() );
+    if ( mWriteIds.end() != it )
+    {
+        stream.write( it->second );
+        return;
+    }
+
+    SEQ_ASSERT_INVARIANT( mWritten.size() < std::numeric_limits<uint32_t>::max(),
+                          "Too many schemas" );
+    const auto id = static_cast<uint32_t>( mWritten.size() );
+    mWriteIds.emplace( schema.get(), id );
+    mWritten.push_back( schema );
+
+    const auto& manager = VariantMethodsManager::instance();
+    stream.write( id );
+    stream.write( schema->getInternedName() );
+    stream.write( static_cast<uint32_t>( schema->size() ) );
+    for ( const auto& attribute: schema->getAttributes() )
+    {
+        stream.write( attribute.name );
+        stream.write( static_cast<uint32_t>( attribute.type ) );
+        switch ( attribute.type )
+        {
+            case IDataType::Type::Variant:
+            case IDataType::Type::Vector:
+                stream.write( manager.calculateHash( attribute.valueType ).value );
+                break;
+
+            case IDataType::Type::Struct:
+                write( stream, attribute.schema );
+                break;
+        }
+    }
+}
+
+DecodeError
+SchemaDictionary::read( DataStream& stream,
+                        StructSchemaSharedPtr& schema )
+{
+    uint32_t id = 0;
+    auto error = stream.tryRead( id );
+    if ( DecodeError::None != error )
+    {
+        return error;
+    }
+
+    if ( id < mRead.size() )
+    {
+        // Only null while its own definition is read, i.e. a recursive schema
+        schema = mRead[id];
+        return schema ? DecodeError::None : DecodeError::InvalidValue;
+    }
+    if ( id != mRead.size() )
+    {
+        return DecodeError::InvalidValue;
+    }
+
+    mRead.emplace_back();
+    error = readDefinition( stream, schema );
+    if ( DecodeError::None != error )
+    {
+        mRead.pop_back();
+        return error;
+    }
+    mRead[id] = schema;
+    return DecodeError::None;
+}
+
+DecodeError
+SchemaDictionary::readDefinition( DataStream& stream,
+                                  StructSchemaSharedPtr& schema )
+{
+    utils::InternedString name;
+    auto error = stream.tryRead( name );
+    if ( DecodeError::None != error )
+    {
+        return error;
+    }
+    if ( name.empty() )
+    {
+        return DecodeError::InvalidName;
+    }
+
+    uint32_t numAttributes = 0;
+    error = stream.tryRead( numAttributes );
+    if ( DecodeError::None != error )
+    {
+        return error;
+    }
+    if ( numAttributes > stream.getLimits().maxElementCount )
+    {
+        return DecodeError::TooManyElements;
+    }
+
+    const auto& manager = VariantMethodsManager::instance();
+    StructSchema::Attributes attributes;
+    attributes.reserve( stream.getReserveHint( numAttributes, 2 * sizeof(uint32_t) ) );
+    for ( uint32_t i = 0; i < numAttributes; ++i )
+    {
+        StructSchema::Attribute attribute;
+        error = stream.tryRead( attribute.name );
+        if ( DecodeError::None != error )
+        {
+            return error;
+        }
+        if ( attribute.name.empty() )
+        {
+            return DecodeError::InvalidName;
+        }
+        if ( !attributes.empty() && !( attributes.back().name < attribute.name ) )
+        {
+            // Definitions are written sorted, so this is a duplicate or foreign data
+            return attributes.back().name == attribute.name ? DecodeError::DuplicateAttribute
+                                                            : DecodeError::InvalidValue;
+        }
+
+        uint32_t type = 0;
+        error = stream.tryRead( type );
+        if ( DecodeError::None != error )
+        {
+            return error;
+        }
+
+        switch ( type )
+        {
+            case static_cast<uint32_t>(IDataType::Type::Variant):
+            case static_cast<uint32_t>(IDataType::Type::Vector):
+            {
+                VariantMethodsManager::Hash hash{ 0 };
+                error = stream.tryRead( hash.value );
+                if ( DecodeError::None != error )
+                {
+                    return error;
+                }
+                const auto* methods = manager.find( hash );
+                if ( !methods )
+                {
+                    return DecodeError::UnknownVariantType;
+                }
+                attribute.type = static_cast<IDataType::Type>( type );
+                attribute.valueType = methods->create().getTypeIndex();
+                break;
+            }
+
+            case static_cast<uint32_t>(IDataType::Type::Struct):
+                error = stream.enterNested();
+                if ( DecodeError::None != error )
+                {
+                    return error;
+                }
+                error = read( stream, attribute.schema );
+                stream.leaveNested();
+                if ( DecodeError::None != error )
+                {
+                    return error;
+                }
+                attribute.type = IDataType::Type::Struct;
+                break;
+
+            default:
+                return DecodeError::UnknownDataType;
+        }
+        attributes.push_back( std::move(attribute) );
+    }
+
+    schema = StructSchema::get( name, std::move(attributes) );
+    return DecodeError::None;
+}
+
+} // end namespace workflow::type::internal
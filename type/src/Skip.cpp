@@ -0,0 +1,192 @@
+#include <internal/Skip.hpp>
+
+#include <array>
+#include <string>
+#include <type_traits>
+
+#include <workflow/type/DataStream.hpp>
+#include <workflow/type/IVariantMethods.hpp>
+#include <workflow/type/VariantMethodsManager.hpp>
+
+#include <internal/Primitives.hpp>
+
+namespace workflow::type::internal {
+namespace {
+
+struct Encoding
+{
+    uint64_t    hash;
+    size_t      size;
+};
+
+template<typename T>
+Encoding
+makeEncoding( const VariantMethodsManager& manager )
+{
+    // Every primitive is written with its type tag in front
+    return { manager.calculateHash<T>().value,
+             std::is_same_v<T, std::string> ? STRING_ENCODING : 1 + sizeof(T) };
+}
+
+} // end namespace
+
+DecodeError
+readMethods( DataStream& stream,
+             const IVariantMethods*& methods,
+             uint64_t& hash )
+{
+    auto error = stream.tryRead( hash );
+    if ( DecodeError::None != error )
+    {
+        return error;
+    }
+    methods = VariantMethodsManager::instance().find( VariantMethodsManager::Hash{ hash } );
+    return methods ? DecodeError::None : DecodeError::UnknownVariantType;
+}
+
+size_t
+getEncodedSize( uint64_t hash )
+{
+    static const auto ENCODINGS = []
+    {
+        const auto& manager = VariantMethodsManager::instance();
+        std::array<Encoding, Primitives::SIZE> ret;
+        size_t index = 0;
+        anyOf<Primitives>( [&]( auto tag )
+        {
+            ret[index++] = makeEncoding<typename decltype(tag)::type>( manager );
+            return false;
+        } );
+        return ret;
+    }();
+
+    for ( const auto& encoding: ENCODINGS )
+    {
+        if ( encoding.hash == hash )
+        {
+            return encoding.size;
+        }
+    }
+    return UNKNOWN_ENCODING;
+}
+
+DecodeError
+skipString( DataStream& stream )
+{
+    uint32_t length = 0;
+    auto error = stream.tryRead( length );
+    if ( DecodeError::None != error )
+    {
+        return error;
+    }
+    if ( length > stream.getLimits().maxStringLength )
+    {
+        return DecodeError::StringTooLong;
+    }
+    return stream.trySkip( length ) ? DecodeError::None : DecodeError::EndOfStream;
+}
+
+DecodeError
+skipValue( DataStream& stream,
+           const IVariantMethods& methods,
+           size_t encodedSize )
+{
+    if ( STRING_ENCODING == encodedSize )
+    {
+        return skipString( stream );
+    }
+    if ( UNKNOWN_ENCODING == encodedSize )
+    {
+        // Custom types only know how to decode themselves
+        Variant value;
+        return methods.tryDeserialize( stream, value );
+    }
+    return stream.trySkip( encodedSize ) ? DecodeError::None : DecodeError::EndOfStream;
+}
+
+DecodeError
+skipBody( DataStream& stream,
+          uint32_t type )
+{
+    const IVariantMethods* methods = nullptr;
+    uint64_t hash = 0;
+    uint32_t count = 0;
+    DecodeError error = DecodeError::None;
+    switch ( type )
+    {
+        case static_cast<uint32_t>(IDataType::Type::Variant):
+            error = readMethods( stream, methods, hash );
+            if ( DecodeError::None != error )
+            {
+                return error;
+            }
+            return skipValue( stream, *methods, getEncodedSize( hash ) );
+
+        case static_cast<uint32_t>(IDataType::Type::Struct):
+            error = skipString( stream );
+            if ( DecodeError::None == error )
+            {
+                error = stream.tryRead( count );
+            }
+            for ( uint32_t i = 0; i < count && DecodeError::None == error; ++i )
+            {
+                error = skipString( stream );
+                if ( DecodeError::None == error )
+                {
+                    error = skipDataType( stream );
+                }
+            }
+            return error;
+
+        case static_cast<uint32_t>(IDataType::Type::Vector):
+        {
+            error = readMethods( stream, methods, hash );
+            if ( DecodeError::None == error )
+            {
+                error = stream.tryRead( count );
+            }
+            if ( DecodeError::None != error )
+            {
+                return error;
+            }
+
+            const size_t encodedSize = getEncodedSize( hash );
+            if ( UNKNOWN_ENCODING != encodedSize && STRING_ENCODING != encodedSize )
+            {
+                // Fixed size elements are skipped at once
+                if ( count > stream.available() / encodedSize )
+                {
+                    return DecodeError::EndOfStream;
+                }
+                return stream.trySkip( count * encodedSize ) ? DecodeError::None : DecodeError::EndOfStream;
+            }
+            for ( uint32_t i = 0; i < count && DecodeError::None == error; ++i )
+            {
+                error = skipValue( stream, *methods, encodedSize );
+            }
+            return error;
+        }
+    }
+    return DecodeError::UnknownDataType;
+}
+
+DecodeError
+skipDataType( DataStream& stream )
+{
+    auto error = stream.enterNested();
+    if ( DecodeError::None != error )
+    {
+        return error;
+    }
+
+    uint32_t type = 0;
+    error = stream.tryRead( type );
+    if ( DecodeError::None == error )
+    {
+        error = skipBody( stream, type );
+    }
+    stream.leaveNested();
+    return error;
+}
+
+} // end namespace workflow::type::internal
@@ -1,91 +1,399 @@
 #include <workflow/type/StructDataType.hpp>
 
 #include <algorithm>
+#include <limits>
+#include <numeric>
 
 #include <workflow/utils/Error.hpp>
 
 #include <workflow/type/DataStream.hpp>
 #include <workflow/type/IDataTypeVisitor.hpp>
+#include <workflow/type/TreeEngine.hpp>
+#include <workflow/type/Visit.hpp>
 
-#include <internal/EqualsVisitor.hpp>
+#include <internal/SchemaDictionary.hpp>
+#include <internal/Skip.hpp>
+#include <internal/StructPlan.hpp>
 
 namespace workflow::type {
 
 StructDataType::StructDataType( const std::string& name,
                                 const NamedTypes& namedTypes )
-    : mName( name )
-    , mAttributes( namedTypes )
 {
     SEQ_ASSERT_ARGUMENT( !name.empty(), "Invalid name" );
     SEQ_ASSERT_ARGUMENT( namedTypes.size(), "No attributes" );
+
+    StructSchema::Attributes attributes;
+    attributes.reserve( namedTypes.size() );
+    mValues.reserve( namedTypes.size() );
+    for ( const auto& item: namedTypes )
+    {
+        SEQ_ASSERT_ARGUMENT( item.second, "No value for attribute '" << item.first << "'" );
+        attributes.push_back( StructSchema::describe( utils::InternedString( item.first ), *item.second ) );
+        mValues.push_back( item.second );
+    }
+    mSchema = StructSchema::get( utils::InternedString( name ), std::move(attributes) );
+}
+
+StructDataType::StructDataType( StructSchemaSharedPtr schema,
+                                Values values )
+    : mSchema( std::move(schema) )
+    , mValues( std::move(values) )
+{
+    SEQ_ASSERT_ARGUMENT( mSchema, "No schema" );
+    SEQ_ASSERT_ARGUMENT( mSchema->size() == mValues.size(), "Expected " << mSchema->size()
+                         << " values, but got " << mValues.size() );
+    for ( size_t i = 0; i < mValues.size(); ++i )
+    {
+        const auto& attribute = mSchema->getAttributes()[i];
+        SEQ_ASSERT_ARGUMENT( mValues[i] && StructSchema::describe( attribute.name, *mValues[i] ) == attribute,
+                             "Invalid value for attribute '" << attribute.name << "'" );
+    }
 }
 
 StructDataType::StructDataType( DataStream& stream )
 {
-    stream.read( mName );
-    SEQ_ASSERT_INVARIANT( !mName.empty(), "Invalid name" );
+    auto error = decode( stream );
+    SEQ_ASSERT_INVARIANT( DecodeError::None == error, "Invalid stream: " << error );
+}
+
+StructDataType::~StructDataType()
+{
+    // Detach the exclusively owned nested structs before they are destroyed,
+    // so none of them destroys a nested struct itself
+    std::vector<IDataTypeSharedPtr> pending;
+    auto detach = [&pending]( Values& values )
+    {
+        for ( auto& value: values )
+        {
+            if ( value && Type::Struct == value->getType() && 1 == value.use_count() )
+            {
+                pending.push_back( std::move(value) );
+            }
+        }
+    };
+
+    detach( mValues );
+    while ( !pending.empty() )
+    {
+        auto node = std::move( pending.back() );
+        pending.pop_back();
+        detach( static_cast<StructDataType&>( *node ).mValues );
+    }
+}
+
+utils::Expected<std::unique_ptr<StructDataType>, DecodeError>
+StructDataType::tryDeserialize( DataStream& stream )
+{
+    std::unique_ptr<StructDataType> ret( new StructDataType() );
+    auto error = ret->decode( stream );
+    if ( DecodeError::None != error )
+    {
+        return utils::makeUnexpected( error );
+    }
+    return ret;
+}
+
+utils::Expected<std::unique_ptr<StructDataType>, DecodeError>
+StructDataType::tryDeserialize( DataStream& stream,
+                                const StructSchemaSharedPtr& schema )
+{
+    SEQ_ASSERT_ARGUMENT( schema, "No schema" );
+    std::unique_ptr<StructDataType> ret( new StructDataType() );
+    ret->mSchema = schema;
+
+    DecodeError error = DecodeError::None;
+    if ( auto* dictionary = stream.mSchemaDictionary.get() )
+    {
+        StructSchemaSharedPtr written;
+        error = dictionary->read( stream, written );
+        if ( DecodeError::None == error && written != schema )
+        {
+            error = DecodeError::TypeMismatch;
+        }
+        if ( DecodeError::None == error )
+        {
+            error = schema->getPlan().decodeValues( stream, ret->mValues );
+        }
+    }
+    else
+    {
+        error = schema->getPlan().decode( stream, ret->mValues );
+    }
+    if ( DecodeError::None != error )
+    {
+        return utils::makeUnexpected( error );
+    }
+    return ret;
+}
+
+utils::Expected<std::unique_ptr<StructDataType>, DecodeError>
+StructDataType::tryDeserialize( DataStream& stream,
+                                const Projection& projection )
+{
+    std::unique_ptr<StructDataType> ret( new StructDataType() );
+    auto error = ret->decode( stream, projection );
+    if ( DecodeError::None != error )
+    {
+        return utils::makeUnexpected( error );
+    }
+    return ret;
+}
+
+DecodeError
+StructDataType::decode( DataStream& stream )
+{
+    return TreeEngine::local().decodeStruct( stream, *this );
+}
+
+DecodeError
+StructDataType::decode( DataStream& stream,
+                        const Projection& projection )
+{
+    StructSchema::Attributes attributes;
+    if ( auto* dictionary = stream.mSchemaDictionary.get() )
+    {
+        StructSchemaSharedPtr schema;
+        auto error = dictionary->read( stream, schema );
+        if ( DecodeError::None == error )
+        {
+            error = schema->getPlan().decodeValues( stream, projection, attributes, mValues );
+        }
+        if ( DecodeError::None != error )
+        {
+            return error;
+        }
+        return finishDecode( schema->getInternedName(), std::move(attributes) );
+    }
+
+    utils::InternedString name;
+    auto error = stream.tryRead( name );
+    if ( DecodeError::None != error )
+    {
+        return error;
+    }
+    if ( name.empty() )
+    {
+        return DecodeError::InvalidName;
+    }
 
     uint32_t numAttributes = 0;
-    stream.read( numAttributes );
+    error = stream.tryRead( numAttributes );
+    if ( DecodeError::None != error )
+    {
+        return error;
+    }
+    if ( numAttributes > stream.getLimits().maxElementCount )
+    {
+        return DecodeError::TooManyElements;
+    }
 
+    // Only the names of selected attributes are interned
+    std::string attributeName;
     for ( uint32_t i = 0; i < numAttributes; ++i )
     {
-        std::string attributeName;
-        stream.read( attributeName );
-        SEQ_ASSERT_INVARIANT( !attributeName.empty(), "Invalid attribute name" );
+        error = stream.tryRead( attributeName );
+        if ( DecodeError::None != error )
+        {
+            return error;
+        }
+        if ( attributeName.empty() )
+        {
+            return DecodeError::InvalidName;
+        }
+
+        const auto* selected = projection.find( attributeName );
+        if ( !selected )
+        {
+            error = internal::skipDataType( stream );
+            if ( DecodeError::None != error )
+            {
+                return error;
+            }
+            continue;
+        }
+
+        IDataTypeSharedPtr value;
+        if ( selected->selectsAll() )
+        {
+            auto attribute = IDataType::tryDeserialize( stream );
+            if ( !attribute )
+            {
+                return attribute.error();
+            }
+            value = std::move(attribute).value();
+        }
+        else
+        {
+            error = stream.enterNested();
+            if ( DecodeError::None != error )
+            {
+                return error;
+            }
+
+            uint32_t type = 0;
+            error = stream.tryRead( type );
+            if ( DecodeError::None == error && static_cast<uint32_t>(Type::Struct) == type )
+            {
+                std::shared_ptr<StructDataType> nested( new StructDataType() );
+                error = nested->decode( stream, *selected );
+                value = std::move(nested);
+            }
+            else if ( DecodeError::None == error )
+            {
+                // Paths into other data types select nothing
+                error = internal::skipBody( stream, type );
+            }
+            stream.leaveNested();
+            if ( DecodeError::None != error )
+            {
+                return error;
+            }
+            if ( !value )
+            {
+                continue;
+            }
+        }
+
+        attributes.push_back( StructSchema::describe( utils::InternedString( attributeName ), *value ) );
+        mValues.push_back( std::move(value) );
+    }
+
+    return finishDecode( name, std::move(attributes) );
+}
+
+DecodeError
+StructDataType::finishDecode( utils::InternedString name,
+                              StructSchema::Attributes attributes )
+{
+    // Serialized structs are ordered by name, only foreign data needs sorting
+    auto byName = []( const auto& lhs, const auto& rhs ){ return lhs.name < rhs.name; };
+    if ( !std::is_sorted( attributes.begin(), attributes.end(), byName ) )
+    {
+        std::vector<size_t> order( attributes.size() );
+        std::iota( order.begin(), order.end(), size_t(0) );
+        std::sort( order.begin(), order.end(), [&]( size_t lhs, size_t rhs )
+                   {
+                       return attributes[lhs].name < attributes[rhs].name;
+                   } );
 
-        IDataTypeSharedPtr attribute = IDataType::deserialize(stream);
-        SEQ_ASSERT_INVARIANT( attribute, "Invalid attribute" );
+        StructSchema::Attributes sortedAttributes;
+        Values sortedValues;
+        sortedAttributes.reserve( order.size() );
+        sortedValues.reserve( order.size() );
+        for ( auto index: order )
+        {
+            sortedAttributes.push_back( std::move(attributes[index]) );
+            sortedValues.push_back( std::move(mValues[index]) );
+        }
+        attributes = std::move(sortedAttributes);
+        mValues = std::move(sortedValues);
+    }
 
-        auto status = mAttributes.insert({ attributeName, attribute });
-        SEQ_ASSERT_INVARIANT( status.second, "Dupliacted attribute '"
-                              << attributeName << "'" );
+    auto duplicate = std::adjacent_find( attributes.begin(), attributes.end(),
+                                         []( const auto& lhs, const auto& rhs )
+                                         {
+                                             return lhs.name == rhs.name;
+                                         } );
+    if ( attributes.end() != duplicate )
+    {
+        return DecodeError::DuplicateAttribute;
     }
+
+    mSchema = StructSchema::get( name, std::move(attributes) );
+    return DecodeError::None;
+}
+
+StructDataType::Handle
+StructDataType::resolve( const StructSchemaSharedPtr& schema,
+                         std::string_view name )
+{
+    SEQ_ASSERT_ARGUMENT( schema, "No schema" );
+    auto index = schema->find( name );
+    if ( StructSchema::npos == index )
+    {
+        return Handle();
+    }
+    return Handle( schema, index );
+}
+
+StructDataType::Handle
+StructDataType::resolve( std::string_view name ) const
+{
+    return resolve( mSchema, name );
 }
 
 std::vector<std::string>
 StructDataType::getAttributes() const
 {
     std::vector<std::string> ret;
-    ret.reserve( mAttributes.size() );
-    std::transform( mAttributes.begin(), mAttributes.end(), std::back_inserter(ret),
-                    [](const auto& item){ return item.first; });
+    ret.reserve( mSchema->size() );
+    std::transform( mSchema->getAttributes().begin(), mSchema->getAttributes().end(),
+                    std::back_inserter(ret), [](const auto& attribute){ return attribute.name.str(); });
     return ret;
 }
 
 bool
 StructDataType::has( const std::string& name ) const
 {
-    return mAttributes.end() != mAttributes.find(name);
+    return StructSchema::npos != mSchema->find( name );
 }
 
 const IDataType&
 StructDataType::get( const std::string& name ) const
 {
-    auto it = mAttributes.find(name);
-    SEQ_ASSERT_ARGUMENT( mAttributes.end() != it, "No attribute called '" << name << "'" );
-    return *it->second;
+    return *mValues[indexOf( name )];
 }
 
 IDataType&
 StructDataType::get( const std::string& name )
 {
-    auto it = mAttributes.find(name);
-    SEQ_ASSERT_ARGUMENT( mAttributes.end() != it, "No attribute called '" << name << "'" );
-    return *it->second;
+    auto& value = *mValues[indexOf( name )];
+    mContentHash.reset();
+    return value;
+}
+
+const IDataType&
+StructDataType::get( size_t index ) const
+{
+    SEQ_ASSERT_ARGUMENT( index < mValues.size(), "Index " << index << " out of range" );
+    return *mValues[index];
+}
+
+IDataType&
+StructDataType::get( size_t index )
+{
+    SEQ_ASSERT_ARGUMENT( index < mValues.size(), "Index " << index << " out of range" );
+    mContentHash.reset();
+    return *mValues[index];
+}
+
+size_t
+StructDataType::indexOf( const std::string& name ) const
+{
+    auto index = mSchema->find( name );
+    SEQ_ASSERT_ARGUMENT( StructSchema::npos != index, "No attribute called '" << name << "'" );
+    return index;
+}
+
+void
+StructDataType::throwHandleMismatch( const Handle& handle ) const
+{
+    SEQ_ASSERT_ARGUMENT( handle, "Invalid handle" );
+
+    std::stringstream ss;
+    ss << "Handle of attribute '" << handle.mSchema->getAttributes()[handle.mIndex].name
+       << "' of '" << handle.mSchema->getName() << "' does not match the schema of '"
+       << mSchema->getName() << "'";
+    throw utils::Error( __FILE__, __LINE__, __PRETTY_FUNCTION__, ss.str(),
+                        utils::CommonError::InvalidArgument );
 }
 
 bool
 operator==( const StructDataType& lhs,
             const StructDataType& rhs )
 {
-    return lhs.mName == rhs.mName
-        && std::equal( lhs.mAttributes.begin(), lhs.mAttributes.end(),
-                       rhs.mAttributes.begin(), rhs.mAttributes.end(),
-                       [](const auto& lhs, const auto& rhs)
-                        {
-                            return lhs.first == rhs.first && *lhs.second == *rhs.second;
-                        } );
+    return TreeEngine::local().equals( lhs, rhs );
 }
 
 bool
@@ -106,7 +414,7 @@ operator<<( std::ostream& os,
 std::string
 StructDataType::getName() const
 {
-    return mName;
+    return mSchema->getName();
 }
 
 StructDataType::Type
@@ -130,35 +438,46 @@ StructDataType::visit( IConstDataTypeVisitor& visitor ) const
 void
 StructDataType::serialize( DataStream& stream ) const
 {
-    // Also support 32 bit systems.
-    SEQ_ASSERT_INVARIANT( mAttributes.size() < std::numeric_limits<uint32_t>::max(),
-                          "Too many attributes" );
-
-    stream.write(mName);
-    stream.write(static_cast<uint32_t>(mAttributes.size()) );
-    for ( const auto& attribute: mAttributes )
-    {
-        stream.write( attribute.first );
-        IDataType::serialize( stream, *attribute.second );
-    }
+    TreeEngine::local().serializeStruct( stream, *this );
 }
 
 bool
 StructDataType::equals( const IDataType& other ) const
 {
-    internal::EqualsVisitor<StructDataType> visitor( *this );
-    return visitor.equals( other );
+    return type::visit( other, utils::Overloaded{
+        [this]( const StructDataType& rhs ){ return *this == rhs; },
+        []( const auto& ){ return false; } } );
+}
+
+uint64_t
+StructDataType::getContentHash() const
+{
+    // Validated on read, a shared attribute may have been changed through another struct
+    return mContentHash.get( [this]
+    {
+        auto update = []( utils::Hasher& hasher, std::string_view value )
+        {
+            hasher.update( static_cast<uint32_t>( value.size() ) );
+            hasher.update( value.data(), value.size() );
+        };
+
+        utils::Hasher hasher;
+        hasher.update( static_cast<uint32_t>( Type::Struct ) );
+        update( hasher, mSchema->getName() );
+        hasher.update( static_cast<uint32_t>( mValues.size() ) );
+        for ( size_t i = 0; i < mValues.size(); ++i )
+        {
+            update( hasher, mSchema->getAttributes()[i].name.str() );
+            hasher.update( mValues[i]->getContentHash() );
+        }
+        return hasher.digest();
+    } );
 }
 
 void
 StructDataType::output( std::ostream& os ) const
 {
-    os << "Struct[" << mName << "](\n";
-    for ( auto attribute: mAttributes )
-    {
-        os << "    " << attribute.first << "=" << *attribute.second << "\n";
-    }
-    os << ")";
+    TreeEngine::local().outputStruct( os, *this );
 }
 
 } // end namespace workflow::type
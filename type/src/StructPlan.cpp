@@ -0,0 +1,332 @@
+#include <internal/StructPlan.hpp>
+
+#include <array>
+#include <cstring>
+#include <limits>
+
+#include <workflow/utils/Error.hpp>
+
+#include <workflow/type/DataStream.hpp>
+#include <workflow/type/IVariantMethods.hpp>
+#include <workflow/type/TreeEngine.hpp>
+#include <workflow/type/VariantDataType.hpp>
+#include <workflow/type/VariantMethodsManager.hpp>
+#include <workflow/type/VectorDataType.hpp>
+
+#include <internal/BufferStream.hpp>
+#include <internal/Skip.hpp>
+
+namespace workflow::type::internal {
+namespace {
+
+// Literals are compared in chunks of this size while decoding
+constexpr size_t COMPARE_CHUNK_SIZE = 256;
+
+DecodeError
+expectBytes( DataStream& stream,
+             const uint8_t* expected,
+             size_t size )
+{
+    std::array<uint8_t, COMPARE_CHUNK_SIZE> buffer;
+    while ( size )
+    {
+        const size_t chunk = std::min( size, buffer.size() );
+        if ( !stream.tryRead( chunk, buffer.data() ) )
+        {
+            return DecodeError::EndOfStream;
+        }
+        if ( 0 != std::memcmp( buffer.data(), expected, chunk ) )
+        {
+            return DecodeError::TypeMismatch;
+        }
+        expected += chunk;
+        size -= chunk;
+    }
+    return DecodeError::None;
+}
+
+} // end namespace
+
+StructPlan::StructPlan( const StructSchema& schema )
+    : mNumValues( schema.size() )
+{
+    SEQ_ASSERT_INVARIANT( schema.size() < std::numeric_limits<uint32_t>::max(),
+                          "Too many attributes" );
+
+    const auto& manager = VariantMethodsManager::instance();
+    auto backend = std::make_unique<BufferStream>();
+    const auto& literals = backend->getData();
+    DataStream stream( std::move(backend) );
+    size_t literalStart = 0;
+
+    auto flushLiteral = [&]()
+    {
+        if ( literals.size() > literalStart )
+        {
+            mOps.push_back( { OpCode::Literal, 0, static_cast<uint32_t>( literalStart ),
+                              static_cast<uint32_t>( literals.size() - literalStart ),
+                              0, 0, nullptr } );
+        }
+        literalStart = literals.size();
+    };
+
+    stream.write( schema.getInternedName() );
+    stream.write( static_cast<uint32_t>( schema.size() ) );
+    for ( size_t i = 0; i < schema.size(); ++i )
+    {
+        const auto& attribute = schema.getAttributes()[i];
+        const auto index = static_cast<uint32_t>( i );
+        stream.write( attribute.name );
+        stream.write( static_cast<uint32_t>( attribute.type ) );
+
+        switch ( attribute.type )
+        {
+            case IDataType::Type::Variant:
+            {
+                // The hash only depends on the variant type
+                auto hash = manager.calculateHash( attribute.valueType );
+                stream.write( hash.value );
+                flushLiteral();
+                mOps.push_back( { OpCode::Variant, index, 0, 0, getEncodedSize( hash.value ),
+                                  hash.value, &attribute } );
+                break;
+            }
+
+            case IDataType::Type::Struct:
+                flushLiteral();
+                mOps.push_back( { OpCode::Struct, index, 0, 0, 0, 0, &attribute } );
+                break;
+
+            case IDataType::Type::Vector:
+                flushLiteral();
+                mOps.push_back( { OpCode::Vector, index, 0, 0, 0, 0, &attribute } );
+                break;
+        }
+    }
+    flushLiteral();
+    mLiterals = literals;
+}
+
+// Nested structs are processed by the engine without recursion
+void
+StructPlan::encode( DataStream& stream,
+                    const StructDataType::Values& values ) const
+{
+    TreeEngine::local().encodePlan( stream, *this, values, false );
+}
+
+DecodeError
+StructPlan::decode( DataStream& stream,
+                    StructDataType::Values& values ) const
+{
+    return TreeEngine::local().decodePlan( stream, *this, values, false );
+}
+
+void
+StructPlan::encodeValues( DataStream& stream,
+                          const StructDataType::Values& values ) const
+{
+    TreeEngine::local().encodePlan( stream, *this, values, true );
+}
+
+DecodeError
+StructPlan::decodeValues( DataStream& stream,
+                          StructDataType::Values& values ) const
+{
+    return TreeEngine::local().decodePlan( stream, *this, values, true );
+}
+
+DecodeError
+StructPlan::decodeValues( DataStream& stream,
+                          const Projection& projection,
+                          StructSchema::Attributes& attributes,
+                          StructDataType::Values& values ) const
+{
+    attributes.clear();
+    values.clear();
+
+    for ( const auto& op: mOps )
+    {
+        if ( OpCode::Literal == op.code )
+        {
+            continue;
+        }
+
+        DecodeError error = DecodeError::None;
+        const auto* selected = projection.find( op.attribute->name.view() );
+        if ( selected && selected->selectsAll() )
+        {
+            IDataTypeSharedPtr value;
+            error = decodeValue( stream, op, value, true );
+            if ( DecodeError::None == error )
+            {
+                attributes.push_back( *op.attribute );
+                values.push_back( std::move(value) );
+            }
+        }
+        else if ( selected && OpCode::Struct == op.code )
+        {
+            error = stream.enterNested();
+            if ( DecodeError::None != error )
+            {
+                return error;
+            }
+            const auto& schema = *op.attribute->schema;
+            StructSchema::Attributes nestedAttributes;
+            std::shared_ptr<StructDataType> value( new StructDataType() );
+            error = schema.getPlan().decodeValues( stream, *selected, nestedAttributes, value->mValues );
+            stream.leaveNested();
+            if ( DecodeError::None == error )
+            {
+                value->mSchema = StructSchema::get( schema.getInternedName(), std::move(nestedAttributes) );
+                attributes.push_back( StructSchema::describe( op.attribute->name, *value ) );
+                values.push_back( std::move(value) );
+            }
+        }
+        else
+        {
+            error = skipValue( stream, op );
+        }
+
+        if ( DecodeError::None != error )
+        {
+            return error;
+        }
+    }
+    return DecodeError::None;
+}
+
+DecodeError
+StructPlan::skipValues( DataStream& stream ) const
+{
+    for ( const auto& op: mOps )
+    {
+        if ( OpCode::Literal == op.code )
+        {
+            continue;
+        }
+        auto error = skipValue( stream, op );
+        if ( DecodeError::None != error )
+        {
+            return error;
+        }
+    }
+    return DecodeError::None;
+}
+
+DecodeError
+StructPlan::expectLiteral( DataStream& stream,
+                           const Op& op ) const
+{
+    return expectBytes( stream, mLiterals.data() + op.offset, op.size );
+}
+
+DecodeError
+StructPlan::decodeValue( DataStream& stream,
+                         const Op& op,
+                         IDataTypeSharedPtr& result,
+                         bool valuesOnly ) const
+{
+    DecodeError error = DecodeError::None;
+    switch ( op.code )
+    {
+        case OpCode::Literal:
+            break;
+
+        case OpCode::Variant:
+        {
+            const auto* methods = findMethods( op );
+            if ( !methods )
+            {
+                error = DecodeError::UnknownVariantType;
+                break;
+            }
+            std::shared_ptr<VariantDataType> value( new VariantDataType() );
+            error = methods->tryDeserialize( stream, value->mValue );
+            result = std::move(value);
+            break;
+        }
+
+        case OpCode::Struct:
+        {
+            error = stream.enterNested();
+            if ( DecodeError::None != error )
+            {
+                break;
+            }
+            std::shared_ptr<StructDataType> value( new StructDataType() );
+            value->mSchema = op.attribute->schema;
+            error = TreeEngine::local().decodePlan( stream, value->mSchema->getPlan(), value->mValues,
+                                                    valuesOnly );
+            stream.leaveNested();
+            result = std::move(value);
+            break;
+        }
+
+        case OpCode::Vector:
+        {
+            error = stream.enterNested();
+            if ( DecodeError::None != error )
+            {
+                break;
+            }
+            auto value = VectorDataType::tryDeserialize( stream );
+            stream.leaveNested();
+            if ( !value )
+            {
+                error = value.error();
+                break;
+            }
+            if ( (*value)->getElementType() != op.attribute->valueType )
+            {
+                error = DecodeError::TypeMismatch;
+                break;
+            }
+            result = std::move(value).value();
+            break;
+        }
+    }
+    return error;
+}
+
+DecodeError
+StructPlan::skipValue( DataStream& stream,
+                       const Op& op ) const
+{
+    switch ( op.code )
+    {
+        case OpCode::Literal:
+            break;
+
+        case OpCode::Variant:
+        {
+            const auto* methods = findMethods( op );
+            return methods ? internal::skipValue( stream, *methods, op.encodedSize )
+                           : DecodeError::UnknownVariantType;
+        }
+
+        case OpCode::Struct:
+        case OpCode::Vector:
+        {
+            auto error = stream.enterNested();
+            if ( DecodeError::None != error )
+            {
+                return error;
+            }
+            error = OpCode::Struct == op.code
+                    ? op.attribute->schema->getPlan().skipValues( stream )
+                    : skipBody( stream, static_cast<uint32_t>( IDataType::Type::Vector ) );
+            stream.leaveNested();
+            return error;
+        }
+    }
+    return DecodeError::None;
+}
+
+const IVariantMethods*
+StructPlan::findMethods( const Op& op ) noexcept
+{
+    return VariantMethodsManager::instance().find( VariantMethodsManager::Hash{ op.hash } );
+}
+
+} // end namespace workflow::type::internal
@@ -0,0 +1,244 @@
+#include <workflow/type/StructSchema.hpp>
+
+#include <algorithm>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include <workflow/utils/Error.hpp>
+#include <workflow/utils/Hash.hpp>
+
+#include <workflow/type/StructDataType.hpp>
+#include <workflow/type/VariantDataType.hpp>
+#include <workflow/type/VectorDataType.hpp>
+
+#include <internal/StructPlan.hpp>
+
+namespace workflow::type {
+namespace {
+
+// Number of layouts in the registry above which expired ones are swept
+constexpr size_t MIN_SWEEP_SIZE = 64;
+
+bool
+sameAttributes( const StructSchema::Attributes& lhs,
+                const StructSchema::Attributes& rhs )
+{
+    return std::equal( lhs.begin(), lhs.end(), rhs.begin(), rhs.end() );
+}
+
+/**
+ * Hash a layout. Interned names and registered schemas are hashed by address.
+ */
+uint64_t
+hashLayout( utils::InternedString name,
+            const StructSchema::Attributes& attributes )
+{
+    utils::Hasher hasher;
+    hasher.update( &name.str() );
+    for ( const auto& attribute: attributes )
+    {
+        hasher.update( &attribute.name.str() );
+        hasher.update( attribute.type );
+        hasher.update( attribute.valueType.hash_code() );
+        hasher.update( attribute.schema.get() );
+    }
+    return hasher.digest();
+}
+
+} // end namespace
+
+/******************************************************************************
+ * Registry of the schemas in use. Read mostly: lookups take a shared lock, only
+ * new layouts take the exclusive one. Schemas are found by the hash of their
+ * layout, so many layouts sharing a struct name do not slow down lookups.
+ *****************************************************************************/
+class StructSchema::Registry
+{
+public:
+    static Registry&
+    instance()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    StructSchemaSharedPtr
+    get( utils::InternedString name,
+         Attributes&& attributes )
+    {
+        const uint64_t hash = hashLayout( name, attributes );
+        {
+            std::shared_lock<std::shared_mutex> lock( mMutex );
+            if ( auto schema = find( hash, name, attributes ) )
+            {
+                return schema;
+            }
+        }
+
+        std::unique_lock<std::shared_mutex> lock( mMutex );
+        if ( auto schema = find( hash, name, attributes ) )
+        {
+            return schema;
+        }
+
+        // Expired layouts are swept whenever the registry doubled in size
+        if ( mSchemas.size() >= mSweepSize )
+        {
+            for ( auto it = mSchemas.begin(); it != mSchemas.end(); )
+            {
+                removeExpired( it->second );
+                it = it->second.empty() ? mSchemas.erase( it ) : std::next( it );
+            }
+            mSweepSize = std::max( MIN_SWEEP_SIZE, 2 * mSchemas.size() );
+        }
+
+        auto& candidates = mSchemas[hash];
+        removeExpired( candidates );
+
+        StructSchemaSharedPtr schema( new StructSchema( name, std::move(attributes) ) );
+        candidates.push_back( schema );
+        return schema;
+    }
+
+private:
+    StructSchemaSharedPtr
+    find( uint64_t hash,
+          utils::InternedString name,
+          const Attributes& attributes ) const
+    {
+        auto it = mSchemas.find( hash );
+        if ( mSchemas.end() == it )
+        {
+            return nullptr;
+        }
+        for ( const auto& weak: it->second )
+        {
+            auto schema = weak.lock();
+            if ( schema && schema->mName == name && sameAttributes( schema->mAttributes, attributes ) )
+            {
+                return schema;
+            }
+        }
+        return nullptr;
+    }
+
+    static void
+    removeExpired( std::vector<StructSchemaWeakPtr>& candidates )
+    {
+        candidates.erase( std::remove_if( candidates.begin(), candidates.end(),
+                                          []( const auto& weak ){ return weak.expired(); } ),
+                          candidates.end() );
+    }
+
+    std::shared_mutex mMutex;
+    std::unordered_map<uint64_t, std::vector<StructSchemaWeakPtr>> mSchemas;
+    size_t mSweepSize = MIN_SWEEP_SIZE;
+};
+
+/*****************************************************************************/
+StructSchemaSharedPtr
+StructSchema::get( utils::InternedString name,
+                   Attributes attributes )
+{
+    SEQ_ASSERT_ARGUMENT( !name.empty(), "Invalid name" );
+    for ( size_t i = 0; i < attributes.size(); ++i )
+    {
+        SEQ_ASSERT_ARGUMENT( !attributes[i].name.empty(), "Invalid attribute name" );
+        SEQ_ASSERT_ARGUMENT( 0 == i || attributes[i - 1].name < attributes[i].name,
+                             "Attribute '" << attributes[i].name << "' is not unique or not sorted" );
+    }
+    return Registry::instance().get( name, std::move(attributes) );
+}
+
+StructSchema::Attribute
+StructSchema::describe( utils::InternedString name,
+                        const IDataType& value )
+{
+    switch ( value.getType() )
+    {
+        case IDataType::Type::Variant:
+            return { name, IDataType::Type::Variant,
+                     static_cast<const VariantDataType&>( value ).getRef().getTypeIndex(), nullptr };
+
+        case IDataType::Type::Vector:
+            return { name, IDataType::Type::Vector,
+                     static_cast<const VectorDataType&>( value ).getElementType(), nullptr };
+
+        case IDataType::Type::Struct:
+            return { name, IDataType::Type::Struct, typeid(void),
+                     static_cast<const StructDataType&>( value ).getSchema() };
+    }
+    SEQ_ASSERT_INVARIANT( false, "Unknown data type" );
+}
+
+StructSchema::StructSchema( utils::InternedString name,
+                            Attributes attributes )
+    : mName( name )
+    , mAttributes( std::move(attributes) )
+{
+    mAttributeNames.reserve( mAttributes.size() );
+    for ( const auto& attribute: mAttributes )
+    {
+        mAttributeNames.push_back( attribute.name );
+    }
+}
+
+StructSchema::~StructSchema() = default;
+
+const internal::StructPlan&
+StructSchema::getPlan() const
+{
+    std::call_once( mPlanFlag, [this]{ mPlan = std::make_unique<internal::StructPlan>( *this ); } );
+    return *mPlan;
+}
+
+size_t
+StructSchema::find( std::string_view name ) const noexcept
+{
+    auto it = std::lower_bound( mAttributes.begin(), mAttributes.end(), name,
+                                []( const Attribute& attribute, std::string_view name )
+                                {
+                                    return attribute.name.view() < name;
+                                } );
+    if ( mAttributes.end() == it || it->name.view() != name )
+    {
+        return npos;
+    }
+    return static_cast<size_t>( it - mAttributes.begin() );
+}
+
+bool
+operator==( const StructSchema::Attribute& lhs,
+            const StructSchema::Attribute& rhs ) noexcept
+{
+    // Interned names and registered schemas compare by pointer
+    return lhs.name == rhs.name
+        && lhs.type == rhs.type
+        && lhs.valueType == rhs.valueType
+        && lhs.schema == rhs.schema;
+}
+
+bool
+operator!=( const StructSchema::Attribute& lhs,
+            const StructSchema::Attribute& rhs ) noexcept
+{
+    return !operator==( lhs, rhs );
+}
+
+bool
+operator==( const StructSchema& lhs,
+            const StructSchema& rhs )
+{
+    return &lhs == &rhs
+        || ( lhs.mName == rhs.mName && sameAttributes( lhs.mAttributes, rhs.mAttributes ) );
+}
+
+bool
+operator!=( const StructSchema& lhs,
+            const StructSchema& rhs )
+{
+    return !operator==( lhs, rhs );
+}
+
+} // end namespace workflow::type
@@ -0,0 +1,256 @@
+#include <workflow/type/TextFormatter.hpp>
+
+#include <charconv>
+#include <type_traits>
+
+#include <workflow/utils/Overloaded.hpp>
+
+#include <workflow/type/Variant.hpp>
+#include <workflow/type/Visit.hpp>
+
+#include <internal/Primitives.hpp>
+
+namespace workflow::type {
+namespace {
+
+// Longest text of a number written by std::to_chars
+constexpr size_t MAX_NUMBER_CHARS = 32;
+
+} // end namespace
+
+TextFormatter::TextFormatter( Style style )
+    : mStyle( style )
+{
+}
+
+std::string_view
+TextFormatter::format( const IDataType& dataType )
+{
+    clear();
+    append( dataType );
+    return view();
+}
+
+std::string_view
+TextFormatter::format( const Variant& value )
+{
+    clear();
+    append( value );
+    return view();
+}
+
+void
+TextFormatter::append( const IDataType& dataType )
+{
+    // Structs are opened on the stack, all other data types are written at once
+    auto open = [this]( const IDataType& node )
+    {
+        visit( node, utils::Overloaded{
+            [this]( const VariantDataType& value )
+            {
+                append( value.getRef() );
+            },
+            [this]( const VectorDataType& value )
+            {
+                appendVector( value );
+            },
+            [this]( const StructDataType& value )
+            {
+                mBuffer += value.getSchema()->getName();
+                mBuffer += '{';
+                mStack.push_back( { &value, 0 } );
+            } } );
+    };
+
+    const size_t base = mStack.size();
+    open( dataType );
+    while ( mStack.size() > base )
+    {
+        auto& frame = mStack.back();
+        const auto& names = frame.node->getAttributeNames();
+        const size_t depth = mStack.size() - base;
+        if ( frame.index == names.size() )
+        {
+            mStack.pop_back();
+            appendLine( depth - 1 );
+            mBuffer += '}';
+            continue;
+        }
+
+        const size_t index = frame.index++;
+        if ( index )
+        {
+            mBuffer += ',';
+        }
+        appendLine( depth );
+        mBuffer += names[index].view();
+        mBuffer += '=';
+        open( frame.node->get( index ) );
+    }
+}
+
+void
+TextFormatter::append( const Variant& value )
+{
+    if ( value.empty() )
+    {
+        mBuffer += "void";
+        return;
+    }
+
+    const bool typed = internal::anyOf<internal::Primitives>( [&]( auto tag )
+    {
+        return appendTyped<typename decltype(tag)::type>( value );
+    } );
+    if ( !typed )
+    {
+        mFallback.str( std::string() );
+        mFallback.clear();
+        mFallback << value;
+        mBuffer += mFallback.str();
+    }
+}
+
+void
+TextFormatter::appendVector( const VectorDataType& vector )
+{
+    mBuffer += '[';
+    const bool typed = internal::anyOf<internal::Primitives>( [&]( auto tag )
+    {
+        return appendElements<typename decltype(tag)::type>( vector );
+    } );
+    if ( !typed )
+    {
+        for ( size_t i = 0; i < vector.size(); ++i )
+        {
+            if ( i )
+            {
+                appendSeparator();
+            }
+            append( vector[i] );
+        }
+    }
+    mBuffer += ']';
+}
+
+template<typename T>
+bool
+TextFormatter::appendElements( const VectorDataType& vector )
+{
+    if ( vector.getElementType() != typeid(T) )
+    {
+        return false;
+    }
+
+    const auto end = vector.end<T>();
+    for ( auto it = vector.begin<T>(); it != end; ++it )
+    {
+        if ( it != vector.begin<T>() )
+        {
+            appendSeparator();
+        }
+        appendValue<T>( *it );
+    }
+    return true;
+}
+
+template<typename T>
+bool
+TextFormatter::appendTyped( const Variant& value )
+{
+    if ( value.getTypeIndex() != typeid(T) )
+    {
+        return false;
+    }
+
+    // Refer to the stored value instead of copying it out by Variant::get()
+    appendValue<T>( static_cast<const Variant::Value<T>&>( *value.mValue ).mValue );
+    return true;
+}
+
+template<typename T>
+void
+TextFormatter::appendValue( const T& value )
+{
+    if constexpr ( std::is_same_v<T, bool> )
+    {
+        mBuffer += value ? "true" : "false";
+    }
+    else if constexpr ( std::is_same_v<T, std::string> )
+    {
+        appendString( value );
+    }
+    else
+    {
+        const size_t size = mBuffer.size();
+        mBuffer.resize( size + MAX_NUMBER_CHARS );
+        auto result = std::to_chars( mBuffer.data() + size, mBuffer.data() + mBuffer.size(), value );
+        mBuffer.resize( result.ptr - mBuffer.data() );
+    }
+}
+
+void
+TextFormatter::appendString( std::string_view value )
+{
+    constexpr char HEX[] = "0123456789abcdef";
+
+    // Characters not needing escapes are appended in runs
+    mBuffer += '"';
+    size_t begin = 0;
+    for ( size_t i = 0; i < value.size(); ++i )
+    {
+        const auto c = static_cast<unsigned char>( value[i] );
+        if ( c >= 0x20 && '"' != c && '\\' != c )
+        {
+            continue;
+        }
+
+        mBuffer.append( value.data() + begin, i - begin );
+        begin = i + 1;
+        mBuffer += '\\';
+        switch ( c )
+        {
+            case '"':
+            case '\\':
+                mBuffer += static_cast<char>( c );
+                break;
+
+            case '\n':
+                mBuffer += 'n';
+                break;
+
+            case '\r':
+                mBuffer += 'r';
+                break;
+
+            case '\t':
+                mBuffer += 't';
+                break;
+
+            default:
+                mBuffer += 'x';
+                mBuffer += HEX[c >> 4];
+                mBuffer += HEX[c & 0xf];
+        }
+    }
+    mBuffer.append( value.data() + begin, value.size() - begin );
+    mBuffer += '"';
+}
+
+void
+TextFormatter::appendSeparator()
+{
+    mBuffer += Style::Pretty == mStyle ? ", " : ",";
+}
+
+void
+TextFormatter::appendLine( size_t depth )
+{
+    if ( Style::Pretty == mStyle )
+    {
+        mBuffer += '\n';
+        mBuffer.append( depth * INDENT, ' ' );
+    }
+}
+
+} // end namespace workflow::type
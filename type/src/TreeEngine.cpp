@@ -0,0 +1,597 @@
+#include <workflow/type/TreeEngine.hpp>
+
+#include <ostream>
+
+#include <workflow/utils/Error.hpp>
+
+#include <workflow/type/DataStream.hpp>
+#include <workflow/type/IVariantMethods.hpp>
+#include <workflow/type/StructDataType.hpp>
+#include <workflow/type/VariantDataType.hpp>
+#include <workflow/type/VariantMethodsManager.hpp>
+#include <workflow/type/VectorDataType.hpp>
+
+#include <internal/SchemaDictionary.hpp>
+#include <internal/StructPlan.hpp>
+
+namespace workflow::type {
+namespace {
+
+/**
+ * Removes the frames pushed by a call when it returns or throws, so nested
+ * calls of the engine leave the frames of the enclosing calls intact
+ */
+template<typename T>
+class StackGuard
+{
+public:
+    explicit
+    StackGuard( std::vector<T>& stack )
+        : mStack( stack )
+        , mBase( stack.size() )
+    {
+    }
+
+    ~StackGuard()
+    {
+        mStack.erase( mStack.begin() + mBase, mStack.end() );
+    }
+
+    size_t
+    getBase() const
+    {
+        return mBase;
+    }
+
+private:
+    std::vector<T>& mStack;
+    size_t          mBase;
+};
+
+} // end namespace
+
+/******************************************************************************
+ * Frames, one per struct being processed
+ *****************************************************************************/
+struct TreeEngine::EncodeFrame
+{
+    const internal::StructPlan* plan;
+    const Values*               values;
+    size_t                      op;
+};
+
+struct TreeEngine::PlanFrame
+{
+    const internal::StructPlan* plan;
+    Values*                     values;
+    size_t                      op;
+};
+
+struct TreeEngine::DecodeFrame
+{
+    StructDataType*             node = nullptr;
+    utils::InternedString       name;
+    uint32_t                    remaining = 0;
+    StructSchema::Attributes    attributes;
+
+    /// Name of the struct attribute being decoded in the frame above
+    utils::InternedString       pending;
+};
+
+struct TreeEngine::CompareFrame
+{
+    const StructDataType*       lhs;
+    const StructDataType*       rhs;
+    size_t                      index;
+};
+
+struct TreeEngine::OutputFrame
+{
+    const StructDataType*       node;
+    size_t                      index;
+};
+
+/*****************************************************************************/
+TreeEngine::TreeEngine( size_t maxDepth,
+                        size_t reserve )
+    : mMaxDepth( maxDepth )
+{
+    SEQ_ASSERT_ARGUMENT( maxDepth > 0, "Invalid maximum depth" );
+    reserve = std::min( reserve, maxDepth );
+    mEncodeStack.reserve( reserve );
+    mPlanStack.reserve( reserve );
+    mDecodeStack.reserve( reserve );
+    mCompareStack.reserve( reserve );
+    mOutputStack.reserve( reserve );
+}
+
+TreeEngine::~TreeEngine() = default;
+
+TreeEngine&
+TreeEngine::local()
+{
+    thread_local TreeEngine engine;
+    return engine;
+}
+
+void
+TreeEngine::serialize( DataStream& stream,
+                       const IDataType& dataType )
+{
+    stream.write( static_cast<uint32_t>( dataType.getType() ) );
+    if ( IDataType::Type::Struct == dataType.getType() )
+    {
+        serializeStruct( stream, static_cast<const StructDataType&>( dataType ) );
+        return;
+    }
+    dataType.serialize( stream );
+}
+
+IDataType::DecodeResult
+TreeEngine::tryDeserialize( DataStream& stream )
+{
+    auto error = stream.enterNested();
+    if ( DecodeError::None != error )
+    {
+        return utils::makeUnexpected( error );
+    }
+
+    IDataType::DecodeResult ret = utils::makeUnexpected( DecodeError::UnknownDataType );
+    uint32_t type = 0;
+    error = stream.tryRead( type );
+    if ( DecodeError::None != error )
+    {
+        ret = utils::makeUnexpected( error );
+    }
+    else if ( static_cast<uint32_t>( IDataType::Type::Struct ) == type )
+    {
+        std::unique_ptr<StructDataType> value( new StructDataType() );
+        error = decodeStruct( stream, *value );
+        ret = DecodeError::None == error ? IDataType::DecodeResult( std::move(value) )
+                                         : utils::makeUnexpected( error );
+    }
+    else if ( static_cast<uint32_t>( IDataType::Type::Variant ) == type )
+    {
+        auto value = VariantDataType::tryDeserialize( stream );
+        ret = value ? IDataType::DecodeResult( std::move(value).value() )
+                    : utils::makeUnexpected( value.error() );
+    }
+    else if ( static_cast<uint32_t>( IDataType::Type::Vector ) == type )
+    {
+        auto value = VectorDataType::tryDeserialize( stream );
+        ret = value ? IDataType::DecodeResult( std::move(value).value() )
+                    : utils::makeUnexpected( value.error() );
+    }
+    stream.leaveNested();
+    return ret;
+}
+
+bool
+TreeEngine::equals( const IDataType& lhs,
+                    const IDataType& rhs )
+{
+    if ( IDataType::Type::Struct == lhs.getType() && IDataType::Type::Struct == rhs.getType() )
+    {
+        return equalsStruct( static_cast<const StructDataType&>( lhs ),
+                             static_cast<const StructDataType&>( rhs ) );
+    }
+    return lhs.equals( rhs );
+}
+
+void
+TreeEngine::output( std::ostream& os,
+                    const IDataType& dataType )
+{
+    if ( IDataType::Type::Struct == dataType.getType() )
+    {
+        outputStruct( os, static_cast<const StructDataType&>( dataType ) );
+        return;
+    }
+    dataType.output( os );
+}
+
+void
+TreeEngine::serializeStruct( DataStream& stream,
+                             const StructDataType& value )
+{
+    if ( auto* dictionary = stream.mSchemaDictionary.get() )
+    {
+        dictionary->write( stream, value.mSchema );
+        encodePlan( stream, value.mSchema->getPlan(), value.mValues, true );
+        return;
+    }
+    encodePlan( stream, value.mSchema->getPlan(), value.mValues, false );
+}
+
+void
+TreeEngine::encodePlan( DataStream& stream,
+                        const internal::StructPlan& plan,
+                        const Values& values,
+                        bool valuesOnly )
+{
+    using OpCode = internal::StructPlan::OpCode;
+
+    StackGuard<EncodeFrame> guard( mEncodeStack );
+    mEncodeStack.push_back( { &plan, &values, 0 } );
+    while ( mEncodeStack.size() > guard.getBase() )
+    {
+        auto& frame = mEncodeStack.back();
+        const auto& ops = frame.plan->mOps;
+        if ( frame.op == ops.size() )
+        {
+            mEncodeStack.pop_back();
+            continue;
+        }
+
+        const auto& op = ops[frame.op++];
+        switch ( op.code )
+        {
+            case OpCode::Literal:
+                if ( !valuesOnly )
+                {
+                    stream.write( op.size, frame.plan->mLiterals.data() + op.offset );
+                }
+                break;
+
+            case OpCode::Variant:
+            {
+                const auto& methods = VariantMethodsManager::instance().get( VariantMethodsManager::Hash{ op.hash } );
+                methods.serialize( stream, static_cast<const VariantDataType&>( *( *frame.values )[op.index] ).getRef() );
+                break;
+            }
+
+            case OpCode::Struct:
+            {
+                checkDepth( mEncodeStack.size(), guard.getBase() );
+                const auto& child = static_cast<const StructDataType&>( *( *frame.values )[op.index] );
+                mEncodeStack.push_back( { &op.attribute->schema->getPlan(), &child.mValues, 0 } );
+                break;
+            }
+
+            case OpCode::Vector:
+                ( *frame.values )[op.index]->serialize( stream );
+                break;
+        }
+    }
+}
+
+DecodeError
+TreeEngine::decodeStruct( DataStream& stream,
+                          StructDataType& value )
+{
+    if ( auto* dictionary = stream.mSchemaDictionary.get() )
+    {
+        auto error = dictionary->read( stream, value.mSchema );
+        if ( DecodeError::None != error )
+        {
+            return error;
+        }
+        return decodePlan( stream, value.mSchema->getPlan(), value.mValues, true );
+    }
+    return decodeGeneric( stream, value );
+}
+
+DecodeError
+TreeEngine::decodePlan( DataStream& stream,
+                        const internal::StructPlan& plan,
+                        Values& values,
+                        bool valuesOnly )
+{
+    using OpCode = internal::StructPlan::OpCode;
+
+    StackGuard<PlanFrame> guard( mPlanStack );
+    const size_t base = guard.getBase();
+    values.clear();
+    values.resize( plan.mNumValues );
+    mPlanStack.push_back( { &plan, &values, 0 } );
+
+    DecodeError error = DecodeError::None;
+    while ( DecodeError::None == error && mPlanStack.size() > base )
+    {
+        auto& frame = mPlanStack.back();
+        const auto& ops = frame.plan->mOps;
+        if ( frame.op == ops.size() )
+        {
+            mPlanStack.pop_back();
+            if ( mPlanStack.size() > base )
+            {
+                stream.leaveNested();
+            }
+            continue;
+        }
+
+        const auto& op = ops[frame.op++];
+        switch ( op.code )
+        {
+            case OpCode::Literal:
+                if ( !valuesOnly )
+                {
+                    error = frame.plan->expectLiteral( stream, op );
+                }
+                break;
+
+            case OpCode::Struct:
+            {
+                if ( mPlanStack.size() - base >= mMaxDepth )
+                {
+                    error = DecodeError::NestingTooDeep;
+                    break;
+                }
+                error = stream.enterNested();
+                if ( DecodeError::None != error )
+                {
+                    break;
+                }
+
+                std::shared_ptr<StructDataType> child( new StructDataType() );
+                child->mSchema = op.attribute->schema;
+                const auto& childPlan = child->mSchema->getPlan();
+                child->mValues.resize( childPlan.mNumValues );
+                auto* childValues = &child->mValues;
+                ( *frame.values )[op.index] = std::move(child);
+                mPlanStack.push_back( { &childPlan, childValues, 0 } );
+                break;
+            }
+
+            default:
+                error = frame.plan->decodeValue( stream, op, ( *frame.values )[op.index], valuesOnly );
+                break;
+        }
+    }
+
+    // Every frame above the root entered a nesting level of the stream
+    for ( size_t i = base + 1; i < mPlanStack.size(); ++i )
+    {
+        stream.leaveNested();
+    }
+    return error;
+}
+
+DecodeError
+TreeEngine::decodeGeneric( DataStream& stream,
+                           StructDataType& value )
+{
+    StackGuard<DecodeFrame> guard( mDecodeStack );
+    const size_t base = guard.getBase();
+
+    // Read name and attribute count of the struct of the top frame
+    auto readHeader = [&stream]( DecodeFrame& frame )
+    {
+        auto error = stream.tryRead( frame.name );
+        if ( DecodeError::None != error )
+        {
+            return error;
+        }
+        if ( frame.name.empty() )
+        {
+            return DecodeError::InvalidName;
+        }
+        error = stream.tryRead( frame.remaining );
+        if ( DecodeError::None != error )
+        {
+            return error;
+        }
+        if ( frame.remaining > stream.getLimits().maxElementCount )
+        {
+            return DecodeError::TooManyElements;
+        }
+        frame.attributes.reserve( stream.getReserveHint( frame.remaining, 2 * sizeof(uint32_t) ) );
+        frame.node->mValues.reserve( frame.attributes.capacity() );
+        return DecodeError::None;
+    };
+
+    mDecodeStack.emplace_back().node = &value;
+    DecodeError error = readHeader( mDecodeStack.back() );
+    while ( DecodeError::None == error && mDecodeStack.size() > base )
+    {
+        auto& frame = mDecodeStack.back();
+        if ( !frame.remaining )
+        {
+            error = frame.node->finishDecode( frame.name, std::move(frame.attributes) );
+            mDecodeStack.pop_back();
+            if ( mDecodeStack.size() == base )
+            {
+                break;
+            }
+
+            // The struct was an attribute of the frame below
+            stream.leaveNested();
+            if ( DecodeError::None != error )
+            {
+                break;
+            }
+            auto& parent = mDecodeStack.back();
+            parent.attributes.push_back( StructSchema::describe( parent.pending,
+                                                                 *parent.node->mValues.back() ) );
+            continue;
+        }
+        --frame.remaining;
+
+        // A variant may decode a data type with this engine, growing the stack.
+        // The frame is looked up by its position again after decoding it.
+        const size_t position = mDecodeStack.size() - 1;
+
+        utils::InternedString name;
+        error = stream.tryRead( name );
+        if ( DecodeError::None == error && name.empty() )
+        {
+            error = DecodeError::InvalidName;
+        }
+        if ( DecodeError::None == error )
+        {
+            error = stream.enterNested();
+        }
+        if ( DecodeError::None != error )
+        {
+            break;
+        }
+
+        uint32_t type = 0;
+        error = stream.tryRead( type );
+        if ( DecodeError::None == error && static_cast<uint32_t>( IDataType::Type::Struct ) == type )
+        {
+            if ( mDecodeStack.size() - base >= mMaxDepth )
+            {
+                error = DecodeError::NestingTooDeep;
+            }
+            else
+            {
+                // The nesting level is left when the frame is done
+                std::shared_ptr<StructDataType> child( new StructDataType() );
+                auto* node = child.get();
+                frame.node->mValues.push_back( std::move(child) );
+                frame.pending = name;
+                mDecodeStack.emplace_back().node = node;
+                error = readHeader( mDecodeStack.back() );
+                continue;
+            }
+        }
+
+        IDataTypeSharedPtr attribute;
+        if ( DecodeError::None == error && static_cast<uint32_t>( IDataType::Type::Variant ) == type )
+        {
+            auto decoded = VariantDataType::tryDeserialize( stream );
+            error = decoded ? DecodeError::None : decoded.error();
+            attribute = decoded ? std::move(decoded).value() : nullptr;
+        }
+        else if ( DecodeError::None == error && static_cast<uint32_t>( IDataType::Type::Vector ) == type )
+        {
+            auto decoded = VectorDataType::tryDeserialize( stream );
+            error = decoded ? DecodeError::None : decoded.error();
+            attribute = decoded ? std::move(decoded).value() : nullptr;
+        }
+        else if ( DecodeError::None == error )
+        {
+            error = DecodeError::UnknownDataType;
+        }
+        stream.leaveNested();
+
+        if ( DecodeError::None == error )
+        {
+            auto& current = mDecodeStack[position];
+            current.attributes.push_back( StructSchema::describe( name, *attribute ) );
+            current.node->mValues.push_back( std::move(attribute) );
+        }
+    }
+
+    // Every frame above the root entered a nesting level of the stream
+    for ( size_t i = base + 1; i < mDecodeStack.size(); ++i )
+    {
+        stream.leaveNested();
+    }
+    return error;
+}
+
+bool
+TreeEngine::equalsStruct( const StructDataType& lhs,
+                          const StructDataType& rhs )
+{
+    // Differing valid cached hashes or schemas are conclusive without descending
+    auto mayBeEqual = []( const StructDataType& lhs,
+                          const StructDataType& rhs )
+    {
+        const auto lhsHash = lhs.mContentHash.peek();
+        const auto rhsHash = rhs.mContentHash.peek();
+        return ( !lhsHash || !rhsHash || lhsHash == rhsHash ) && *lhs.mSchema == *rhs.mSchema;
+    };
+
+    if ( &lhs == &rhs )
+    {
+        return true;
+    }
+    if ( !mayBeEqual( lhs, rhs ) )
+    {
+        return false;
+    }
+
+    StackGuard<CompareFrame> guard( mCompareStack );
+    mCompareStack.push_back( { &lhs, &rhs, 0 } );
+    while ( mCompareStack.size() > guard.getBase() )
+    {
+        auto& frame = mCompareStack.back();
+        if ( frame.index == frame.lhs->mValues.size() )
+        {
+            mCompareStack.pop_back();
+            continue;
+        }
+
+        const auto& lhsValue = frame.lhs->mValues[frame.index];
+        const auto& rhsValue = frame.rhs->mValues[frame.index];
+        ++frame.index;
+
+        // Shared attributes, like those of snapshots, are equal without comparing
+        if ( lhsValue == rhsValue )
+        {
+            continue;
+        }
+        if ( IDataType::Type::Struct != lhsValue->getType()
+             || IDataType::Type::Struct != rhsValue->getType() )
+        {
+            if ( !lhsValue->equals( *rhsValue ) )
+            {
+                return false;
+            }
+            continue;
+        }
+
+        const auto& lhsChild = static_cast<const StructDataType&>( *lhsValue );
+        const auto& rhsChild = static_cast<const StructDataType&>( *rhsValue );
+        if ( !mayBeEqual( lhsChild, rhsChild ) )
+        {
+            return false;
+        }
+        checkDepth( mCompareStack.size(), guard.getBase() );
+        mCompareStack.push_back( { &lhsChild, &rhsChild, 0 } );
+    }
+    return true;
+}
+
+void
+TreeEngine::outputStruct( std::ostream& os,
+                          const StructDataType& value )
+{
+    auto open = [&os]( const StructDataType& node )
+    {
+        os << "Struct[" << node.mSchema->getName() << "](\n";
+    };
+
+    StackGuard<OutputFrame> guard( mOutputStack );
+    open( value );
+    mOutputStack.push_back( { &value, 0 } );
+    while ( mOutputStack.size() > guard.getBase() )
+    {
+        auto& frame = mOutputStack.back();
+        const auto& values = frame.node->mValues;
+        if ( frame.index == values.size() )
+        {
+            os << ")";
+            mOutputStack.pop_back();
+            if ( mOutputStack.size() > guard.getBase() )
+            {
+                os << "\n";
+            }
+            continue;
+        }
+
+        const auto index = frame.index++;
+        const auto& child = *values[index];
+        os << "    " << frame.node->mSchema->getAttributes()[index].name << "=";
+        if ( IDataType::Type::Struct == child.getType() )
+        {
+            checkDepth( mOutputStack.size(), guard.getBase() );
+            open( static_cast<const StructDataType&>( child ) );
+            mOutputStack.push_back( { &static_cast<const StructDataType&>( child ), 0 } );
+            continue;
+        }
+        os << child << "\n";
+    }
+}
+
+void
+TreeEngine::checkDepth( size_t size,
+                        size_t base ) const
+{
+    SEQ_ASSERT_ARGUMENT( size - base < mMaxDepth, "Data type nested deeper than " << mMaxDepth );
+}
+
+} // end namespace workflow::type
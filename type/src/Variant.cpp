@@ -1,3 +1,5 @@
+// Out of line definitions of the hot paths for the shared library
+#define SEQ_DEFINE_VARIANT_HOT_PATH
 #include <workflow/type/Variant.hpp>
 
 #include <iostream>
@@ -9,11 +11,6 @@ Variant::Variant( const Variant& other )
 {
 }
 
-Variant::Variant( Variant&& other ) noexcept
-    : mValue( std::move(other.mValue) )
-{
-}
-
 Variant&
 Variant::operator=( const Variant& other )
 {
@@ -22,35 +19,16 @@ Variant::operator=( const Variant& other )
     return *this;
 }
 
-Variant&
-Variant::operator=( Variant&& other ) noexcept
-{
-    std::swap(mValue, other.mValue);
-    return *this;
-}
-
-bool
-Variant::empty() const
-{
-    return nullptr == mValue;
-}
-
-void
-Variant::clear()
-{
-    mValue.reset();
-}
-
-std::type_index
-Variant::getTypeIndex() const
+std::string
+Variant::getTypeName() const
 {
-    return mValue ? mValue->getTypeIndex() : typeid(void);
+    return getCachedTypeName();
 }
 
-std::string
-Variant::getTypeName() const
+const std::string&
+Variant::getCachedTypeName() const
 {
-    return utils::demangle(getTypeIndex().name());
+    return utils::demangle(getTypeIndex());
 }
 
 bool
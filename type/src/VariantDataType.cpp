@@ -2,10 +2,12 @@
 
 #include <workflow/type/DataStream.hpp>
 #include <workflow/type/IDataTypeVisitor.hpp>
+#include <workflow/type/Visit.hpp>
 #include <workflow/type/IVariantMethods.hpp>
 #include <workflow/type/VariantMethodsManager.hpp>
 
-#include <internal/EqualsVisitor.hpp>
+#include <internal/HashFloat.hpp>
+#include <internal/HashStream.hpp>
 
 namespace workflow::type {
 
@@ -20,15 +22,20 @@ VariantDataType::VariantDataType( Variant value )
 
 VariantDataType::VariantDataType(DataStream& stream)
 {
-    const auto& manager = VariantMethodsManager::instance();
-
-    // Read the hash
-    VariantMethodsManager::Hash hash;
-    stream.read( hash.value );
+    auto error = decode( stream );
+    SEQ_ASSERT_INVARIANT( DecodeError::None == error, "Invalid stream: " << error );
+}
 
-    // Get the method to deserialize the value
-    const auto& method = manager.get( hash );
-    method.deserialize( stream, mValue );
+utils::Expected<std::unique_ptr<VariantDataType>, DecodeError>
+VariantDataType::tryDeserialize( DataStream& stream )
+{
+    std::unique_ptr<VariantDataType> ret( new VariantDataType() );
+    auto error = ret->decode( stream );
+    if ( DecodeError::None != error )
+    {
+        return utils::makeUnexpected( error );
+    }
+    return ret;
 }
 
 Variant
@@ -44,6 +51,29 @@ VariantDataType::set(Variant value )
                          "Ivnalid data type: expected '" << mValue.getTypeName()
                          << "' but got '" << value.getTypeName() << "'" );
     mValue = std::move(value);
+    mContentHash.reset();
+}
+
+DecodeError
+VariantDataType::decode( DataStream& stream )
+{
+    const auto& manager = VariantMethodsManager::instance();
+
+    // Read the hash
+    VariantMethodsManager::Hash hash;
+    auto error = stream.tryRead( hash.value );
+    if ( DecodeError::None != error )
+    {
+        return error;
+    }
+
+    // Get the method to deserialize the value
+    const auto* method = manager.find( hash );
+    if ( !method )
+    {
+        return DecodeError::UnknownVariantType;
+    }
+    return method->tryDeserialize( stream, mValue );
 }
 
 bool
@@ -106,8 +136,39 @@ VariantDataType::serialize( DataStream& stream ) const
 bool
 VariantDataType::equals( const IDataType& other ) const
 {
-    internal::EqualsVisitor<VariantDataType> visitor(*this);
-    return visitor.equals(other);
+    return type::visit( other, utils::Overloaded{
+        [this]( const VariantDataType& rhs ){ return *this == rhs; },
+        []( const auto& ){ return false; } } );
+}
+
+uint64_t
+VariantDataType::getContentHash() const
+{
+    return mContentHash.get( [this]
+    {
+        const auto& manager = VariantMethodsManager::instance();
+        auto hash = manager.calculateHash( mValue.getTypeIndex() );
+        utils::Hasher hasher;
+        hasher.update( static_cast<uint32_t>( Type::Variant ) );
+        hasher.update( hash.value );
+
+        // Equal floating point values must hash equally, see canonicalFloat()
+        if ( mValue.getTypeIndex() == typeid(float) )
+        {
+            hasher.update( internal::canonicalFloat( mValue.get<float>() ) );
+        }
+        else if ( mValue.getTypeIndex() == typeid(double) )
+        {
+            hasher.update( internal::canonicalFloat( mValue.get<double>() ) );
+        }
+        else
+        {
+            // The serialization is the only byte representation known for all types
+            DataStream stream( std::make_unique<internal::HashStream>( hasher ) );
+            manager.get( hash ).serialize( stream, mValue );
+        }
+        return hasher.digest();
+    } );
 }
 
 void
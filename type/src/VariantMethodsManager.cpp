@@ -64,7 +64,7 @@ fromStringImpl( const std::string& value )
         if constexpr (std::is_unsigned_v<T> )
         {
             SEQ_ASSERT_ARGUMENT( value[0] != '-', "Failed to convert '"
-                                 << value << "' to " << utils::demangle(typeid(T).name()));
+                                 << value << "' to " << utils::typeName<T>());
         }
 
         return boost::lexical_cast<T>(value);
@@ -72,7 +72,7 @@ fromStringImpl( const std::string& value )
     catch ( ... )
     {
         SEQ_ASSERT_ARGUMENT( false, "Failed to convert '" << value << "' to "
-                             << utils::demangle(typeid(T).name()));
+                             << utils::typeName<T>());
     }
 }
 
@@ -173,6 +173,19 @@ public:
         value = Variant( tmp );
     }
 
+    virtual DecodeError
+    tryDeserialize( DataStream& stream,
+                    Variant& value ) const override
+    {
+        T tmp  = {};
+        auto error = stream.tryRead( tmp );
+        if ( DecodeError::None == error )
+        {
+            value = Variant( std::move(tmp) );
+        }
+        return error;
+    }
+
 private:
     std::string mName;
 };
@@ -263,13 +276,13 @@ VariantMethodsManager::remove( const std::type_index& type )
 {
     auto it = mImpl->mMethods.find( type );
     SEQ_ASSERT_ARGUMENT( mImpl->mMethods.end() != it, "Type '"
-            << utils::demangle(type.name()) << "' not known to the manager" );
+            << utils::demangle(type) << "' not known to the manager" );
     auto hash = Hash{ std::hash<std::string>{}(it->second->getName()) };
     mImpl->mMethods.erase(it);
 
     auto hashIt = mImpl->mHashMap.find( hash.value );
     SEQ_ASSERT_ARGUMENT( mImpl->mHashMap.end() != hashIt, "Type hash '"
-                         << utils::demangle(type.name()) << "' not known to the manager" );
+                         << utils::demangle(type) << "' not known to the manager" );
     mImpl->mHashMap.erase( hashIt );
 }
 
@@ -284,7 +297,7 @@ VariantMethodsManager::get( const std::type_index& type ) const
 {
     auto it = mImpl->mMethods.find( type );
     SEQ_ASSERT_ARGUMENT( mImpl->mMethods.end() != it, "Type '"
-            << utils::demangle(type.name()) << "' not known to the manager" );
+            << utils::demangle(type) << "' not known to the manager" );
     return *it->second;
 }
 
@@ -299,6 +312,24 @@ VariantMethodsManager::get( const Hash& hash ) const
     return *methodsIt->second;
 }
 
+const IVariantMethods*
+VariantMethodsManager::find( const std::type_index& type ) const noexcept
+{
+    auto it = mImpl->mMethods.find( type );
+    return mImpl->mMethods.end() != it ? it->second.get() : nullptr;
+}
+
+const IVariantMethods*
+VariantMethodsManager::find( const Hash& hash ) const noexcept
+{
+    auto hashIt = mImpl->mHashMap.find( hash.value );
+    if ( mImpl->mHashMap.end() == hashIt )
+    {
+        return nullptr;
+    }
+    return find( hashIt->second );
+}
+
 std::vector<std::type_index>
 VariantMethodsManager::getTypes() const
 {
@@ -1,17 +1,340 @@
 #include <workflow/type/VectorDataType.hpp>
 
-#include <sstream>
+#include <algorithm>
+#include <iostream>
 #include <limits>
 
 #include <workflow/type/IDataTypeVisitor.hpp>
+#include <workflow/type/Visit.hpp>
 #include <workflow/type/DataStream.hpp>
 #include <workflow/type/IVariantMethods.hpp>
 #include <workflow/type/VariantMethodsManager.hpp>
+#include <workflow/type/VectorMath.hpp>
 
-#include <internal/EqualsVisitor.hpp>
+#include <internal/HashFloat.hpp>
+#include <internal/HashStream.hpp>
 
 namespace workflow::type {
+namespace {
 
+// Number of elements grown per step while decoding contiguous arrays, so memory
+// grows with the data that is actually received
+constexpr size_t DECODE_CHUNK_ELEMENTS = 64 * 1024;
+
+template<typename T>
+constexpr bool IS_CONTIGUOUS = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+template<typename T>
+void
+outputElement( std::ostream& os,
+               const T& value )
+{
+    os << "<" << utils::typeName<T>() << ">(" << utils::Printer<T>(value) << ")";
+}
+
+} // end namespace
+
+/******************************************************************************
+ * Storage for the built in types
+ *****************************************************************************/
+template<typename T>
+size_t
+VectorDataType::Storage<T>::size() const
+{
+    return mValues.size();
+}
+
+template<typename T>
+void
+VectorDataType::Storage<T>::clear()
+{
+    mValues.clear();
+}
+
+template<typename T>
+void
+VectorDataType::Storage<T>::reserve( size_t capacity )
+{
+    mValues.reserve( capacity );
+}
+
+template<typename T>
+Variant
+VectorDataType::Storage<T>::get( size_t index ) const
+{
+    return Variant( static_cast<T>( mValues[index] ) );
+}
+
+template<typename T>
+void
+VectorDataType::Storage<T>::set( size_t index,
+                                 const Variant& value )
+{
+    mValues[index] = value.get<T>();
+}
+
+template<typename T>
+void
+VectorDataType::Storage<T>::push_back( const Variant& value )
+{
+    mValues.push_back( value.get<T>() );
+}
+
+template<typename T>
+void
+VectorDataType::Storage<T>::serialize( DataStream& stream,
+                                       const IVariantMethods& ) const
+{
+    if constexpr ( IS_CONTIGUOUS<T> )
+    {
+        stream.writeArray( mValues.data(), mValues.size() );
+    }
+    else
+    {
+        for ( const auto& value: mValues )
+        {
+            stream.write( static_cast<T>( value ) );
+        }
+    }
+}
+
+template<typename T>
+DecodeError
+VectorDataType::Storage<T>::deserialize( DataStream& stream,
+                                         const IVariantMethods&,
+                                         uint32_t count )
+{
+    mValues.clear();
+
+    if constexpr ( IS_CONTIGUOUS<T> )
+    {
+        mValues.reserve( stream.getReserveHint( count, 1 + sizeof(T) ) );
+
+        size_t offset = 0;
+        while ( offset < count )
+        {
+            const size_t num = std::min<size_t>( count - offset, DECODE_CHUNK_ELEMENTS );
+            mValues.resize( offset + num );
+            auto error = stream.tryReadArray( mValues.data() + offset, num );
+            if ( DecodeError::None != error )
+            {
+                return error;
+            }
+            offset += num;
+        }
+    }
+    else
+    {
+        mValues.reserve( stream.getReserveHint( count, 1 ) );
+        for ( uint32_t i = 0; i < count; ++i )
+        {
+            T value = {};
+            auto error = stream.tryRead( value );
+            if ( DecodeError::None != error )
+            {
+                return error;
+            }
+            mValues.push_back( std::move(value) );
+        }
+    }
+    return DecodeError::None;
+}
+
+template<typename T>
+bool
+VectorDataType::Storage<T>::equals( const IStorage& other ) const
+{
+    const auto& otherValues = static_cast<const Storage<T>&>( other ).mValues;
+    if constexpr ( IS_CONTIGUOUS<T> )
+    {
+        return math::equal<T>( { mValues.data(), mValues.size() },
+                               { otherValues.data(), otherValues.size() } );
+    }
+    else
+    {
+        return mValues == otherValues;
+    }
+}
+
+template<typename T>
+void
+VectorDataType::Storage<T>::hash( utils::Hasher& hasher,
+                                  const IVariantMethods& ) const
+{
+    if constexpr ( std::is_floating_point_v<T> )
+    {
+        // Equal values must hash equally, canonicalize them in chunks
+        constexpr size_t CHUNK_SIZE = 256;
+        T buffer[CHUNK_SIZE];
+        for ( size_t offset = 0; offset < mValues.size(); offset += CHUNK_SIZE )
+        {
+            const size_t count = std::min( CHUNK_SIZE, mValues.size() - offset );
+            for ( size_t i = 0; i < count; ++i )
+            {
+                buffer[i] = internal::canonicalFloat( mValues[offset + i] );
+            }
+            hasher.update( buffer, count * sizeof(T) );
+        }
+    }
+    else if constexpr ( IS_CONTIGUOUS<T> )
+    {
+        hasher.update( mValues.data(), mValues.size() * sizeof(T) );
+    }
+    else if constexpr ( std::is_same_v<T, bool> )
+    {
+        for ( bool value: mValues )
+        {
+            hasher.update( static_cast<uint8_t>( value ) );
+        }
+    }
+    else
+    {
+        for ( const auto& value: mValues )
+        {
+            hasher.update( static_cast<uint64_t>( value.size() ) );
+            hasher.update( value.data(), value.size() );
+        }
+    }
+}
+
+template<typename T>
+void
+VectorDataType::Storage<T>::output( std::ostream& os ) const
+{
+    bool first = true;
+    for ( const auto& value: mValues )
+    {
+        if ( !first )
+        {
+            os << ", ";
+        }
+        outputElement<T>( os, value );
+        first = false;
+    }
+}
+
+template struct VectorDataType::Storage<bool>;
+template struct VectorDataType::Storage<uint8_t>;
+template struct VectorDataType::Storage<uint16_t>;
+template struct VectorDataType::Storage<uint32_t>;
+template struct VectorDataType::Storage<uint64_t>;
+template struct VectorDataType::Storage<int8_t>;
+template struct VectorDataType::Storage<int16_t>;
+template struct VectorDataType::Storage<int32_t>;
+template struct VectorDataType::Storage<int64_t>;
+template struct VectorDataType::Storage<float>;
+template struct VectorDataType::Storage<double>;
+template struct VectorDataType::Storage<std::string>;
+
+/******************************************************************************
+ * Storage for all other variant types
+ *****************************************************************************/
+struct VectorDataType::VariantStorage : public IStorage
+{
+    virtual size_t
+    size() const override
+    {
+        return mValues.size();
+    }
+
+    virtual void
+    clear() override
+    {
+        mValues.clear();
+    }
+
+    virtual void
+    reserve( size_t capacity ) override
+    {
+        mValues.reserve( capacity );
+    }
+
+    virtual Variant
+    get( size_t index ) const override
+    {
+        return mValues[index];
+    }
+
+    virtual void
+    set( size_t index,
+         const Variant& value ) override
+    {
+        mValues[index] = value;
+    }
+
+    virtual void
+    push_back( const Variant& value ) override
+    {
+        mValues.push_back( value );
+    }
+
+    virtual void
+    serialize( DataStream& stream,
+               const IVariantMethods& methods ) const override
+    {
+        for ( const auto& value: mValues )
+        {
+            methods.serialize( stream, value );
+        }
+    }
+
+    virtual DecodeError
+    deserialize( DataStream& stream,
+                 const IVariantMethods& methods,
+                 uint32_t count ) override
+    {
+        mValues.clear();
+        mValues.reserve( stream.getReserveHint( count, 1 ) );
+        for( uint32_t i = 0; i < count; ++i )
+        {
+            Variant value;
+            auto error = methods.tryDeserialize( stream, value );
+            if ( DecodeError::None != error )
+            {
+                return error;
+            }
+            mValues.push_back( std::move(value) );
+        }
+        return DecodeError::None;
+    }
+
+    virtual bool
+    equals( const IStorage& other ) const override
+    {
+        return mValues == static_cast<const VariantStorage&>( other ).mValues;
+    }
+
+    virtual void
+    hash( utils::Hasher& hasher,
+          const IVariantMethods& methods ) const override
+    {
+        // The serialization is the only byte representation known for them
+        DataStream stream( std::make_unique<internal::HashStream>( hasher ) );
+        for ( const auto& value: mValues )
+        {
+            methods.serialize( stream, value );
+        }
+    }
+
+    virtual void
+    output( std::ostream& os ) const override
+    {
+        bool first = true;
+        for ( const auto& value: mValues )
+        {
+            if ( !first )
+            {
+                os << ", ";
+            }
+            os << value;
+            first = false;
+        }
+    }
+
+    VariantVector mValues;
+};
+
+/*****************************************************************************/
 VectorDataType::VectorDataType( const Variant& value )
     : mType( value )
 {
@@ -19,39 +342,223 @@ VectorDataType::VectorDataType( const Variant& value )
     SEQ_ASSERT_ARGUMENT( manager.has( value.getTypeIndex() ),
                          "No IVariantMethods registered to handle type '"
                          << value.getTypeName() << "'" );
+    mStorage = createStorage( value.getTypeIndex() );
 }
 
 VectorDataType::VectorDataType( DataStream& stream )
+{
+    auto error = decode( stream );
+    SEQ_ASSERT_INVARIANT( DecodeError::None == error, "Invalid stream: " << error );
+}
+
+utils::Expected<std::unique_ptr<VectorDataType>, DecodeError>
+VectorDataType::tryDeserialize( DataStream& stream )
+{
+    std::unique_ptr<VectorDataType> ret( new VectorDataType() );
+    auto error = ret->decode( stream );
+    if ( DecodeError::None != error )
+    {
+        return utils::makeUnexpected( error );
+    }
+    return ret;
+}
+
+DecodeError
+VectorDataType::decode( DataStream& stream )
 {
     const auto& manager = VariantMethodsManager::instance();
 
     // Read the hash
     VariantMethodsManager::Hash hash;
-    stream.read( hash.value );
+    auto error = stream.tryRead( hash.value );
+    if ( DecodeError::None != error )
+    {
+        return error;
+    }
 
     // Get the method to create the type description
-    const auto& method = manager.get( hash );
-    mType = method.create();
+    const auto* method = manager.find( hash );
+    if ( !method )
+    {
+        return DecodeError::UnknownVariantType;
+    }
+    mType = method->create();
+    mStorage = createStorage( mType.getTypeIndex() );
 
     // Get the number of attributes
     uint32_t numAttributes = 0;
-    stream.read( numAttributes );
-
-    // Read the values
-    mValues.reserve(numAttributes);
-    for( uint32_t i = 0; i < numAttributes; ++i )
+    error = stream.tryRead( numAttributes );
+    if ( DecodeError::None != error )
     {
-        Variant value;
-        method.deserialize(stream, value );
-        mValues.push_back( value );
+        return error;
+    }
+    if ( numAttributes > stream.getLimits().maxElementCount )
+    {
+        return DecodeError::TooManyElements;
     }
+
+    // Read the values. The count is untrusted, the storage does not reserve
+    // more than the stream is able to deliver.
+    return mStorage->deserialize( stream, *method, numAttributes );
+}
+
+VectorDataType::IStoragePtr
+VectorDataType::createStorage( const std::type_index& type )
+{
+    if ( type == typeid(bool) )          return std::make_unique<Storage<bool>>();
+    if ( type == typeid(uint8_t) )       return std::make_unique<Storage<uint8_t>>();
+    if ( type == typeid(uint16_t) )      return std::make_unique<Storage<uint16_t>>();
+    if ( type == typeid(uint32_t) )      return std::make_unique<Storage<uint32_t>>();
+    if ( type == typeid(uint64_t) )      return std::make_unique<Storage<uint64_t>>();
+    if ( type == typeid(int8_t) )        return std::make_unique<Storage<int8_t>>();
+    if ( type == typeid(int16_t) )       return std::make_unique<Storage<int16_t>>();
+    if ( type == typeid(int32_t) )       return std::make_unique<Storage<int32_t>>();
+    if ( type == typeid(int64_t) )       return std::make_unique<Storage<int64_t>>();
+    if ( type == typeid(float) )         return std::make_unique<Storage<float>>();
+    if ( type == typeid(double) )        return std::make_unique<Storage<double>>();
+    if ( type == typeid(std::string) )   return std::make_unique<Storage<std::string>>();
+    return std::make_unique<VariantStorage>();
+}
+
+VectorDataType::ConstIterator::ConstIterator( const VectorDataType* vector,
+                                              size_t index )
+    : mVector( vector )
+    , mIndex( index )
+{
+}
+
+Variant
+VectorDataType::ConstIterator::operator*() const
+{
+    return (*mVector)[mIndex];
+}
+
+VectorDataType::ConstIterator&
+VectorDataType::ConstIterator::operator++()
+{
+    ++mIndex;
+    return *this;
+}
+
+VectorDataType::ConstIterator
+VectorDataType::ConstIterator::operator++( int )
+{
+    ConstIterator ret( *this );
+    ++mIndex;
+    return ret;
+}
+
+bool
+operator==( const VectorDataType::ConstIterator& lhs,
+            const VectorDataType::ConstIterator& rhs )
+{
+    return lhs.mVector == rhs.mVector && lhs.mIndex == rhs.mIndex;
+}
+
+bool
+operator!=( const VectorDataType::ConstIterator& lhs,
+            const VectorDataType::ConstIterator& rhs )
+{
+    return !operator==( lhs, rhs );
+}
+
+/*****************************************************************************/
+std::type_index
+VectorDataType::getElementType() const
+{
+    return mType.getTypeIndex();
+}
+
+size_t
+VectorDataType::size() const
+{
+    return mStorage->size();
+}
+
+bool
+VectorDataType::empty() const
+{
+    return 0 == mStorage->size();
+}
+
+void
+VectorDataType::clear()
+{
+    mStorage->clear();
+    mContentHash.reset();
+}
+
+void
+VectorDataType::reserve( size_t capacity )
+{
+    mStorage->reserve( capacity );
+}
+
+void
+VectorDataType::push_back( const Variant& value )
+{
+    checkType( value );
+    mStorage->push_back( value );
+    mContentHash.reset();
+}
+
+Variant
+VectorDataType::operator[]( size_t index ) const
+{
+    return mStorage->get( index );
+}
+
+Variant
+VectorDataType::at( size_t index ) const
+{
+    SEQ_ASSERT_ARGUMENT( index < mStorage->size(), "Index " << index << " out of range" );
+    return mStorage->get( index );
+}
+
+void
+VectorDataType::set( size_t index,
+                     const Variant& value )
+{
+    checkType( value );
+    SEQ_ASSERT_ARGUMENT( index < mStorage->size(), "Index " << index << " out of range" );
+    mStorage->set( index, value );
+    mContentHash.reset();
+}
+
+VectorDataType::ConstIterator
+VectorDataType::begin() const
+{
+    return ConstIterator( this, 0 );
+}
+
+VectorDataType::ConstIterator
+VectorDataType::end() const
+{
+    return ConstIterator( this, mStorage->size() );
+}
+
+void
+VectorDataType::checkType( const Variant& value ) const
+{
+    SEQ_ASSERT_ARGUMENT( mType.getTypeIndex() == value.getTypeIndex(),
+                         "Invalid element type: expected '" << mType.getTypeName()
+                         << "' but got '" << value.getTypeName() << "'" );
 }
 
 bool
 operator==( const VectorDataType& lhs,
             const VectorDataType& rhs )
 {
-    return lhs.mValues == rhs.mValues;
+    // Hashes only computed before are compared, differing ones imply inequality
+    const auto lhsHash = lhs.mContentHash.peek();
+    const auto rhsHash = rhs.mContentHash.peek();
+    if ( lhsHash && rhsHash && lhsHash != rhsHash )
+    {
+        return false;
+    }
+    return lhs.mType.getTypeIndex() == rhs.mType.getTypeIndex()
+        && lhs.mStorage->size() == rhs.mStorage->size()
+        && lhs.mStorage->equals( *rhs.mStorage );
 }
 
 bool
@@ -64,9 +571,7 @@ operator!=( const VectorDataType& lhs,
 std::string
 VectorDataType::getName() const
 {
-    std::stringstream ss;
-    ss << "Vector<" << mType.getTypeName() << ">";
-    return ss.str();
+    return "Vector<" + mType.getCachedTypeName() + ">";
 }
 
 VectorDataType::Type
@@ -95,37 +600,40 @@ VectorDataType::serialize( DataStream& stream ) const
     const auto& method = manager.get( mType.getTypeIndex() );
 
     // Also support 32 bit systems.
-    SEQ_ASSERT_INVARIANT( mValues.size() < std::numeric_limits<uint32_t>::max(),
+    SEQ_ASSERT_INVARIANT( mStorage->size() < std::numeric_limits<uint32_t>::max(),
                           "Too many elements" );
     stream.write( hash.value );
-    stream.write(static_cast<uint32_t>(mValues.size()) );
-    for ( const auto& value: mValues )
+    stream.write( static_cast<uint32_t>(mStorage->size()) );
+    mStorage->serialize( stream, method );
+}
+
+uint64_t
+VectorDataType::getContentHash() const
+{
+    return mContentHash.get( [this]
     {
-        method.serialize(stream, value);
-    }
+        const auto& manager = VariantMethodsManager::instance();
+        utils::Hasher hasher;
+        hasher.update( manager.calculateHash( mType.getTypeIndex() ).value );
+        hasher.update( static_cast<uint64_t>( mStorage->size() ) );
+        mStorage->hash( hasher, manager.get( mType.getTypeIndex() ) );
+        return hasher.digest();
+    } );
 }
 
 bool
 VectorDataType::equals( const IDataType& other ) const
 {
-    internal::EqualsVisitor<VectorDataType> visitor( *this );
-    return visitor.equals( other );
+    return type::visit( other, utils::Overloaded{
+        [this]( const VectorDataType& rhs ){ return *this == rhs; },
+        []( const auto& ){ return false; } } );
 }
 
 void
 VectorDataType::output( std::ostream& os ) const
 {
-    os << "Vector[" << mValues.size() <<"](";
-    bool first = true;
-    for ( const auto& v: mValues )
-    {
-        if ( !first )
-        {
-            os << ", ";
-        }
-        os << v;
-        first = false;
-    }
+    os << "Vector[" << mStorage->size() <<"](";
+    mStorage->output( os );
     os << ")";
 }
 
@@ -0,0 +1,746 @@
+#include <workflow/type/VectorMath.hpp>
+
+#include <atomic>
+#include <cstring>
+
+#include <workflow/utils/Error.hpp>
+
+#include <workflow/type/VectorDataType.hpp>
+
+#if defined(__GNUC__) && ( defined(__x86_64__) || defined(__i386__) )
+#define HAS_X86_SIMD 1
+#else
+#define HAS_X86_SIMD 0
+#endif
+
+namespace workflow::type::math {
+namespace {
+
+constexpr size_t BITS_PER_WORD = 64;
+
+template<Compare OP, typename T>
+inline bool
+matches( T value,
+         T threshold )
+{
+    if constexpr ( Compare::Less == OP ) return value < threshold;
+    if constexpr ( Compare::LessEqual == OP ) return value <= threshold;
+    if constexpr ( Compare::Greater == OP ) return value > threshold;
+    if constexpr ( Compare::GreaterEqual == OP ) return value >= threshold;
+    if constexpr ( Compare::Equal == OP ) return value == threshold;
+    if constexpr ( Compare::NotEqual == OP ) return value != threshold;
+}
+
+/******************************************************************************
+ * Scalar kernels, also used for the tails of the vectorized ones
+ *****************************************************************************/
+namespace scalar {
+
+template<typename T>
+SumType<T>
+sum( const T* values,
+     size_t size )
+{
+    SumType<T> ret = 0;
+    for ( size_t i = 0; i < size; ++i )
+    {
+        ret += values[i];
+    }
+    return ret;
+}
+
+template<typename T>
+std::pair<T, T>
+minMax( const T* values,
+        size_t size )
+{
+    T min = values[0];
+    T max = values[0];
+    for ( size_t i = 1; i < size; ++i )
+    {
+        min = values[i] < min ? values[i] : min;
+        max = values[i] > max ? values[i] : max;
+    }
+    return { min, max };
+}
+
+template<typename T>
+SumType<T>
+dot( const T* lhs,
+     const T* rhs,
+     size_t size )
+{
+    SumType<T> ret = 0;
+    for ( size_t i = 0; i < size; ++i )
+    {
+        ret += static_cast<SumType<T>>( lhs[i] ) * static_cast<SumType<T>>( rhs[i] );
+    }
+    return ret;
+}
+
+template<typename T>
+bool
+equal( const T* lhs,
+       const T* rhs,
+       size_t size )
+{
+    for ( size_t i = 0; i < size; ++i )
+    {
+        if ( !( lhs[i] == rhs[i] ) )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename T>
+void
+scaleOffset( T* values,
+             size_t size,
+             T scale,
+             T offset )
+{
+    for ( size_t i = 0; i < size; ++i )
+    {
+        values[i] = static_cast<T>( values[i] * scale + offset );
+    }
+}
+
+template<typename T>
+void
+clamp( T* values,
+       size_t size,
+       T low,
+       T high )
+{
+    for ( size_t i = 0; i < size; ++i )
+    {
+        values[i] = values[i] < low ? low : ( values[i] > high ? high : values[i] );
+    }
+}
+
+template<Compare OP, typename T>
+void
+compare( const T* values,
+         size_t size,
+         T threshold,
+         uint64_t* mask )
+{
+    for ( size_t i = 0; i < size; ++i )
+    {
+        if ( matches<OP>( values[i], threshold ) )
+        {
+            mask[i / BITS_PER_WORD] |= uint64_t(1) << ( i % BITS_PER_WORD );
+        }
+    }
+}
+
+} // end namespace scalar
+
+#if HAS_X86_SIMD
+/******************************************************************************
+ * Vectorized kernels for W byte registers, written with the GCC vector
+ * extensions. They are inlined into the functions compiled for the target
+ * instruction set below.
+ *****************************************************************************/
+#define SIMD_KERNEL inline __attribute__((always_inline))
+
+namespace simd {
+
+template<typename T, size_t W>
+struct Vec
+{
+    typedef T Type __attribute__((vector_size(W)));
+};
+
+template<typename T, size_t W>
+using VecType = typename Vec<T, W>::Type;
+
+template<typename T, size_t W>
+SIMD_KERNEL SumType<T>
+sum( const T* values,
+     size_t size )
+{
+    // Accumulate in lanes of SumType, loading as many values as lanes exist
+    using S = SumType<T>;
+    constexpr size_t LANES = W / sizeof(S);
+    using Load = VecType<T, LANES * sizeof(T)>;
+    using Acc = VecType<S, W>;
+
+    Acc acc0 = {};
+    Acc acc1 = {};
+    size_t i = 0;
+    for ( ; i + 2 * LANES <= size; i += 2 * LANES )
+    {
+        Load v0, v1;
+        std::memcpy( &v0, values + i, sizeof(v0) );
+        std::memcpy( &v1, values + i + LANES, sizeof(v1) );
+        acc0 += __builtin_convertvector( v0, Acc );
+        acc1 += __builtin_convertvector( v1, Acc );
+    }
+    acc0 += acc1;
+
+    S ret = 0;
+    for ( size_t j = 0; j < LANES; ++j )
+    {
+        ret += acc0[j];
+    }
+    return ret + scalar::sum( values + i, size - i );
+}
+
+template<typename T, size_t W>
+SIMD_KERNEL std::pair<T, T>
+minMax( const T* values,
+        size_t size )
+{
+    constexpr size_t LANES = W / sizeof(T);
+    using V = VecType<T, W>;
+
+    if ( size < LANES )
+    {
+        return scalar::minMax( values, size );
+    }
+
+    V min, max;
+    std::memcpy( &min, values, sizeof(min) );
+    max = min;
+    size_t i = LANES;
+    for ( ; i + LANES <= size; i += LANES )
+    {
+        V v;
+        std::memcpy( &v, values + i, sizeof(v) );
+        min = v < min ? v : min;
+        max = v > max ? v : max;
+    }
+
+    T retMin = min[0];
+    T retMax = max[0];
+    for ( size_t j = 1; j < LANES; ++j )
+    {
+        retMin = min[j] < retMin ? min[j] : retMin;
+        retMax = max[j] > retMax ? max[j] : retMax;
+    }
+    for ( ; i < size; ++i )
+    {
+        retMin = values[i] < retMin ? values[i] : retMin;
+        retMax = values[i] > retMax ? values[i] : retMax;
+    }
+    return { retMin, retMax };
+}
+
+template<typename T, size_t W>
+SIMD_KERNEL SumType<T>
+dot( const T* lhs,
+     const T* rhs,
+     size_t size )
+{
+    using S = SumType<T>;
+    constexpr size_t LANES = W / sizeof(S);
+    using Load = VecType<T, LANES * sizeof(T)>;
+    using Acc = VecType<S, W>;
+
+    Acc acc = {};
+    size_t i = 0;
+    for ( ; i + LANES <= size; i += LANES )
+    {
+        Load l, r;
+        std::memcpy( &l, lhs + i, sizeof(l) );
+        std::memcpy( &r, rhs + i, sizeof(r) );
+        acc += __builtin_convertvector( l, Acc ) * __builtin_convertvector( r, Acc );
+    }
+
+    S ret = 0;
+    for ( size_t j = 0; j < LANES; ++j )
+    {
+        ret += acc[j];
+    }
+    return ret + scalar::dot( lhs + i, rhs + i, size - i );
+}
+
+template<typename T, size_t W>
+SIMD_KERNEL bool
+equal( const T* lhs,
+       const T* rhs,
+       size_t size )
+{
+    // Test for a mismatch once per block of registers to keep the loop tight
+    constexpr size_t LANES = W / sizeof(T);
+    constexpr size_t BLOCK = 4 * LANES;
+    using V = VecType<T, W>;
+    using Mask = decltype( V{} != V{} );
+
+    size_t i = 0;
+    for ( ; i + BLOCK <= size; i += BLOCK )
+    {
+        Mask mismatch = {};
+        for ( size_t j = 0; j < BLOCK; j += LANES )
+        {
+            V l, r;
+            std::memcpy( &l, lhs + i + j, sizeof(l) );
+            std::memcpy( &r, rhs + i + j, sizeof(r) );
+            mismatch |= l != r;
+        }
+        for ( size_t j = 0; j < LANES; ++j )
+        {
+            if ( mismatch[j] )
+            {
+                return false;
+            }
+        }
+    }
+    return scalar::equal( lhs + i, rhs + i, size - i );
+}
+
+template<typename T, size_t W>
+SIMD_KERNEL void
+scaleOffset( T* values,
+             size_t size,
+             T scale,
+             T offset )
+{
+    constexpr size_t LANES = W / sizeof(T);
+    using V = VecType<T, W>;
+
+    const V scaleV = V{} + scale;
+    const V offsetV = V{} + offset;
+    size_t i = 0;
+    for ( ; i + LANES <= size; i += LANES )
+    {
+        V v;
+        std::memcpy( &v, values + i, sizeof(v) );
+        v = v * scaleV + offsetV;
+        std::memcpy( values + i, &v, sizeof(v) );
+    }
+    scalar::scaleOffset( values + i, size - i, scale, offset );
+}
+
+template<typename T, size_t W>
+SIMD_KERNEL void
+clamp( T* values,
+       size_t size,
+       T low,
+       T high )
+{
+    constexpr size_t LANES = W / sizeof(T);
+    using V = VecType<T, W>;
+
+    const V lowV = V{} + low;
+    const V highV = V{} + high;
+    size_t i = 0;
+    for ( ; i + LANES <= size; i += LANES )
+    {
+        V v;
+        std::memcpy( &v, values + i, sizeof(v) );
+        v = v < lowV ? lowV : v;
+        v = v > highV ? highV : v;
+        std::memcpy( values + i, &v, sizeof(v) );
+    }
+    scalar::clamp( values + i, size - i, low, high );
+}
+
+template<Compare OP, typename T, size_t W>
+SIMD_KERNEL void
+compare( const T* values,
+         size_t size,
+         T threshold,
+         uint64_t* mask )
+{
+    // LANES divides 64, so a register never spans two mask words
+    constexpr size_t LANES = W / sizeof(T);
+    using V = VecType<T, W>;
+
+    using Mask = decltype( V{} < V{} );
+
+    const V thresholdV = V{} + threshold;
+    size_t i = 0;
+    for ( ; i + LANES <= size; i += LANES )
+    {
+        V v;
+        std::memcpy( &v, values + i, sizeof(v) );
+        Mask result;
+        if constexpr ( Compare::Less == OP ) result = v < thresholdV;
+        if constexpr ( Compare::LessEqual == OP ) result = v <= thresholdV;
+        if constexpr ( Compare::Greater == OP ) result = v > thresholdV;
+        if constexpr ( Compare::GreaterEqual == OP ) result = v >= thresholdV;
+        if constexpr ( Compare::Equal == OP ) result = v == thresholdV;
+        if constexpr ( Compare::NotEqual == OP ) result = v != thresholdV;
+
+        uint64_t bits = 0;
+        for ( size_t j = 0; j < LANES; ++j )
+        {
+            bits |= static_cast<uint64_t>( result[j] & 1 ) << j;
+        }
+        mask[i / BITS_PER_WORD] |= bits << ( i % BITS_PER_WORD );
+    }
+    for ( ; i < size; ++i )
+    {
+        if ( matches<OP>( values[i], threshold ) )
+        {
+            mask[i / BITS_PER_WORD] |= uint64_t(1) << ( i % BITS_PER_WORD );
+        }
+    }
+}
+
+} // end namespace simd
+
+/******************************************************************************
+ * Entry points compiled for the target instruction sets
+ *****************************************************************************/
+#define DEFINE_SIMD_KERNELS( WIDTH )                                            \
+    template<typename T>                                                        \
+    SumType<T>                                                                  \
+    sum( const T* values, size_t size )                                         \
+    {                                                                           \
+        return simd::sum<T, WIDTH>( values, size );                             \
+    }                                                                           \
+    template<typename T>                                                        \
+    std::pair<T, T>                                                             \
+    minMax( const T* values, size_t size )                                      \
+    {                                                                           \
+        return simd::minMax<T, WIDTH>( values, size );                          \
+    }                                                                           \
+    template<typename T>                                                        \
+    SumType<T>                                                                  \
+    dot( const T* lhs, const T* rhs, size_t size )                              \
+    {                                                                           \
+        return simd::dot<T, WIDTH>( lhs, rhs, size );                           \
+    }                                                                           \
+    template<typename T>                                                        \
+    bool                                                                        \
+    equal( const T* lhs, const T* rhs, size_t size )                            \
+    {                                                                           \
+        return simd::equal<T, WIDTH>( lhs, rhs, size );                         \
+    }                                                                           \
+    template<typename T>                                                        \
+    void                                                                        \
+    scaleOffset( T* values, size_t size, T scale, T offset )                    \
+    {                                                                           \
+        simd::scaleOffset<T, WIDTH>( values, size, scale, offset );             \
+    }                                                                           \
+    template<typename T>                                                        \
+    void                                                                        \
+    clamp( T* values, size_t size, T low, T high )                              \
+    {                                                                           \
+        simd::clamp<T, WIDTH>( values, size, low, high );                       \
+    }                                                                           \
+    template<Compare OP, typename T>                                            \
+    void                                                                        \
+    compare( const T* values, size_t size, T threshold, uint64_t* mask )        \
+    {                                                                           \
+        simd::compare<OP, T, WIDTH>( values, size, threshold, mask );           \
+    }
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+namespace avx2 {
+DEFINE_SIMD_KERNELS( 32 )
+} // end namespace avx2
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx512bw,avx512vl,avx512dq")
+namespace avx512 {
+DEFINE_SIMD_KERNELS( 64 )
+} // end namespace avx512
+#pragma GCC pop_options
+
+#undef DEFINE_SIMD_KERNELS
+#undef SIMD_KERNEL
+
+#define DISPATCH( KERNEL, ... )                                                 \
+    switch ( getSimdLevel() )                                                   \
+    {                                                                           \
+    case SimdLevel::Avx512:                                                     \
+        return avx512::KERNEL( __VA_ARGS__ );                                   \
+    case SimdLevel::Avx2:                                                       \
+        return avx2::KERNEL( __VA_ARGS__ );                                     \
+    case SimdLevel::Scalar:                                                     \
+        break;                                                                  \
+    }                                                                           \
+    return scalar::KERNEL( __VA_ARGS__ )
+#else
+#define DISPATCH( KERNEL, ... )                                                 \
+    return scalar::KERNEL( __VA_ARGS__ )
+#endif
+
+SimdLevel
+detectSimdLevel() noexcept
+{
+#if HAS_X86_SIMD
+    __builtin_cpu_init();
+    if ( __builtin_cpu_supports( "avx512f" ) && __builtin_cpu_supports( "avx512bw" )
+         && __builtin_cpu_supports( "avx512vl" ) && __builtin_cpu_supports( "avx512dq" ) )
+    {
+        return SimdLevel::Avx512;
+    }
+    if ( __builtin_cpu_supports( "avx2" ) )
+    {
+        return SimdLevel::Avx2;
+    }
+#endif
+    return SimdLevel::Scalar;
+}
+
+std::atomic<SimdLevel>&
+simdLevel() noexcept
+{
+    static std::atomic<SimdLevel> level( getSupportedSimdLevel() );
+    return level;
+}
+
+template<Compare OP, typename T>
+void
+compareKernel( const T* values,
+               size_t size,
+               T threshold,
+               uint64_t* mask )
+{
+    DISPATCH( compare<OP>, values, size, threshold, mask );
+}
+
+/**
+ * Call function with a null pointer of the numeric element type of a vector
+ */
+template<typename F>
+decltype(auto)
+visitNumeric( const VectorDataType& vector,
+              F&& func )
+{
+    const auto type = vector.getElementType();
+    if ( type == typeid(uint8_t) ) return func( static_cast<uint8_t*>( nullptr ) );
+    if ( type == typeid(uint16_t) ) return func( static_cast<uint16_t*>( nullptr ) );
+    if ( type == typeid(uint32_t) ) return func( static_cast<uint32_t*>( nullptr ) );
+    if ( type == typeid(uint64_t) ) return func( static_cast<uint64_t*>( nullptr ) );
+    if ( type == typeid(int8_t) ) return func( static_cast<int8_t*>( nullptr ) );
+    if ( type == typeid(int16_t) ) return func( static_cast<int16_t*>( nullptr ) );
+    if ( type == typeid(int32_t) ) return func( static_cast<int32_t*>( nullptr ) );
+    if ( type == typeid(int64_t) ) return func( static_cast<int64_t*>( nullptr ) );
+    if ( type == typeid(float) ) return func( static_cast<float*>( nullptr ) );
+    if ( type == typeid(double) ) return func( static_cast<double*>( nullptr ) );
+    SEQ_ASSERT_ARGUMENT( false, "Not a numeric vector: " << vector.getName() );
+}
+
+} // end namespace
+
+/*****************************************************************************/
+SimdLevel
+getSupportedSimdLevel() noexcept
+{
+    static const SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+SimdLevel
+getSimdLevel() noexcept
+{
+    return simdLevel().load( std::memory_order_relaxed );
+}
+
+void
+setSimdLevel( SimdLevel level ) noexcept
+{
+    simdLevel().store( std::min( level, getSupportedSimdLevel() ), std::memory_order_relaxed );
+}
+
+/*****************************************************************************/
+template<typename T>
+SumType<T>
+sum( utils::Span<const T> values )
+{
+    DISPATCH( sum, values.data(), values.size() );
+}
+
+template<typename T>
+double
+mean( utils::Span<const T> values )
+{
+    SEQ_ASSERT_ARGUMENT( !values.empty(), "Mean of empty values" );
+    return static_cast<double>( sum( values ) ) / static_cast<double>( values.size() );
+}
+
+template<typename T>
+std::pair<T, T>
+minMax( utils::Span<const T> values )
+{
+    SEQ_ASSERT_ARGUMENT( !values.empty(), "Minimum and maximum of empty values" );
+    DISPATCH( minMax, values.data(), values.size() );
+}
+
+template<typename T>
+SumType<T>
+dot( utils::Span<const T> lhs,
+     utils::Span<const T> rhs )
+{
+    SEQ_ASSERT_ARGUMENT( lhs.size() == rhs.size(), "Size mismatch: "
+                         << lhs.size() << " != " << rhs.size() );
+    DISPATCH( dot, lhs.data(), rhs.data(), lhs.size() );
+}
+
+template<typename T>
+bool
+equal( utils::Span<const T> lhs,
+       utils::Span<const T> rhs )
+{
+    if ( lhs.size() != rhs.size() )
+    {
+        return false;
+    }
+    if constexpr ( std::is_integral_v<T> )
+    {
+        return lhs.empty() || 0 == std::memcmp( lhs.data(), rhs.data(), lhs.size() * sizeof(T) );
+    }
+    else
+    {
+        DISPATCH( equal, lhs.data(), rhs.data(), lhs.size() );
+    }
+}
+
+template<typename T>
+void
+scaleOffset( utils::Span<T> values,
+             T scale,
+             T offset )
+{
+    DISPATCH( scaleOffset, values.data(), values.size(), scale, offset );
+}
+
+template<typename T>
+void
+clamp( utils::Span<T> values,
+       T low,
+       T high )
+{
+    SEQ_ASSERT_ARGUMENT( !( high < low ), "Invalid range: " << +low << " > " << +high );
+    DISPATCH( clamp, values.data(), values.size(), low, high );
+}
+
+template<typename T>
+std::vector<uint64_t>
+compare( utils::Span<const T> values,
+         Compare op,
+         T threshold )
+{
+    std::vector<uint64_t> ret( ( values.size() + BITS_PER_WORD - 1 ) / BITS_PER_WORD, 0 );
+    switch ( op )
+    {
+    case Compare::Less:
+        compareKernel<Compare::Less>( values.data(), values.size(), threshold, ret.data() );
+        break;
+    case Compare::LessEqual:
+        compareKernel<Compare::LessEqual>( values.data(), values.size(), threshold, ret.data() );
+        break;
+    case Compare::Greater:
+        compareKernel<Compare::Greater>( values.data(), values.size(), threshold, ret.data() );
+        break;
+    case Compare::GreaterEqual:
+        compareKernel<Compare::GreaterEqual>( values.data(), values.size(), threshold, ret.data() );
+        break;
+    case Compare::Equal:
+        compareKernel<Compare::Equal>( values.data(), values.size(), threshold, ret.data() );
+        break;
+    case Compare::NotEqual:
+        compareKernel<Compare::NotEqual>( values.data(), values.size(), threshold, ret.data() );
+        break;
+    }
+    return ret;
+}
+
+#undef DISPATCH
+
+#define INSTANTIATE_KERNELS( T )                                                                \
+    template SumType<T> sum<T>( utils::Span<const T> );                                        \
+    template double mean<T>( utils::Span<const T> );                                           \
+    template std::pair<T, T> minMax<T>( utils::Span<const T> );                                \
+    template SumType<T> dot<T>( utils::Span<const T>, utils::Span<const T> );                  \
+    template bool equal<T>( utils::Span<const T>, utils::Span<const T> );                      \
+    template void scaleOffset<T>( utils::Span<T>, T, T );                                      \
+    template void clamp<T>( utils::Span<T>, T, T );                                            \
+    template std::vector<uint64_t> compare<T>( utils::Span<const T>, Compare, T );
+
+INSTANTIATE_KERNELS( uint8_t )
+INSTANTIATE_KERNELS( uint16_t )
+INSTANTIATE_KERNELS( uint32_t )
+INSTANTIATE_KERNELS( uint64_t )
+INSTANTIATE_KERNELS( int8_t )
+INSTANTIATE_KERNELS( int16_t )
+INSTANTIATE_KERNELS( int32_t )
+INSTANTIATE_KERNELS( int64_t )
+INSTANTIATE_KERNELS( float )
+INSTANTIATE_KERNELS( double )
+
+#undef INSTANTIATE_KERNELS
+
+/*****************************************************************************/
+Variant
+sum( const VectorDataType& vector )
+{
+    return visitNumeric( vector, [&]( auto* tag ) {
+        using T = std::remove_pointer_t<decltype(tag)>;
+        return Variant( sum<T>( vector.getSpan<T>() ) );
+    } );
+}
+
+double
+mean( const VectorDataType& vector )
+{
+    return visitNumeric( vector, [&]( auto* tag ) {
+        using T = std::remove_pointer_t<decltype(tag)>;
+        return mean<T>( vector.getSpan<T>() );
+    } );
+}
+
+std::pair<Variant, Variant>
+minMax( const VectorDataType& vector )
+{
+    return visitNumeric( vector, [&]( auto* tag ) {
+        using T = std::remove_pointer_t<decltype(tag)>;
+        const auto ret = minMax<T>( vector.getSpan<T>() );
+        return std::pair<Variant, Variant>( Variant( ret.first ), Variant( ret.second ) );
+    } );
+}
+
+Variant
+dot( const VectorDataType& lhs,
+     const VectorDataType& rhs )
+{
+    return visitNumeric( lhs, [&]( auto* tag ) {
+        using T = std::remove_pointer_t<decltype(tag)>;
+        return Variant( dot<T>( lhs.getSpan<T>(), rhs.getSpan<T>() ) );
+    } );
+}
+
+void
+scaleOffset( VectorDataType& vector,
+             const Variant& scale,
+             const Variant& offset )
+{
+    visitNumeric( vector, [&]( auto* tag ) {
+        using T = std::remove_pointer_t<decltype(tag)>;
+        scaleOffset<T>( vector.getSpan<T>(), scale.get<T>(), offset.get<T>() );
+    } );
+}
+
+void
+clamp( VectorDataType& vector,
+       const Variant& low,
+       const Variant& high )
+{
+    visitNumeric( vector, [&]( auto* tag ) {
+        using T = std::remove_pointer_t<decltype(tag)>;
+        clamp<T>( vector.getSpan<T>(), low.get<T>(), high.get<T>() );
+    } );
+}
+
+std::vector<uint64_t>
+compare( const VectorDataType& vector,
+         Compare op,
+         const Variant& threshold )
+{
+    return visitNumeric( vector, [&]( auto* tag ) {
+        using T = std::remove_pointer_t<decltype(tag)>;
+        return compare<T>( vector.getSpan<T>(), op, threshold.get<T>() );
+    } );
+}
+
+} // end namespace workflow::type::math
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <workflow/utils/Error.hpp>
+
+#include <workflow/type/IDataStream.hpp>
+
+namespace workflow::type::internal {
+
+/**
+ * Data stream backend writing to and reading from memory
+ */
+class BufferStream : public IDataStream
+{
+public:
+    BufferStream() = default;
+
+    virtual void
+    write( const size_t length,
+           const void* data ) override;
+
+    virtual void
+    read( const size_t length,
+          void* data ) override;
+
+    virtual bool
+    tryRead( const size_t length,
+             void* data ) override;
+
+    virtual bool
+    trySkip( const size_t length ) override;
+
+    virtual size_t
+    available() const override;
+
+    virtual void
+    writeGather( utils::Span<const utils::Span<const uint8_t>> buffers ) override;
+
+    /**
+     * Get the data written so far
+     */
+    const std::vector<uint8_t>&
+    getData() const noexcept;
+
+private:
+    std::vector<uint8_t>    mData;
+    size_t                  mReadPos = 0;
+};
+
+/******************************************************************************
+ * Inlined implementations
+ *****************************************************************************/
+inline void
+BufferStream::write( const size_t length,
+                     const void* data )
+{
+    const auto* bytes = static_cast<const uint8_t*>( data );
+    mData.insert( mData.end(), bytes, bytes + length );
+}
+
+inline void
+BufferStream::read( const size_t length,
+                    void* data )
+{
+    SEQ_ASSERT_INVARIANT( tryRead( length, data ), "End of stream" );
+}
+
+inline bool
+BufferStream::tryRead( const size_t length,
+                       void* data )
+{
+    if ( length > available() )
+    {
+        return false;
+    }
+    if ( length )
+    {
+        std::memcpy( data, mData.data() + mReadPos, length );
+        mReadPos += length;
+    }
+    return true;
+}
+
+inline bool
+BufferStream::trySkip( const size_t length )
+{
+    if ( length > available() )
+    {
+        return false;
+    }
+    mReadPos += length;
+    return true;
+}
+
+inline size_t
+BufferStream::available() const
+{
+    return mData.size() - mReadPos;
+}
+
+inline void
+BufferStream::writeGather( utils::Span<const utils::Span<const uint8_t>> buffers )
+{
+    size_t size = mData.size();
+    for ( const auto& buffer: buffers )
+    {
+        size += buffer.size();
+    }
+    mData.reserve( size );
+    for ( const auto& buffer: buffers )
+    {
+        mData.insert( mData.end(), buffer.begin(), buffer.end() );
+    }
+}
+
+inline const std::vector<uint8_t>&
+BufferStream::getData() const noexcept
+{
+    return mData;
+}
+
+} // end namespace workflow::type::internal
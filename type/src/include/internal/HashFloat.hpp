@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace workflow::type::internal {
+
+/**
+ * Get the value hashed in place of a floating point value, so values
+ * comparing equal hash equally: -0.0 is hashed as 0.0. NaN compares unequal
+ * to everything including itself, all NaN are hashed as the same quiet NaN
+ * so the hash does not depend on the payload or the sign.
+ *
+ * @param [in]  value       The value
+ *
+ * @return The canonical value
+ */
+template<typename T>
+inline T
+canonicalFloat( T value ) noexcept
+{
+    static_assert( std::is_floating_point_v<T>, "Floating point type expected" );
+    if ( std::isnan( value ) )
+    {
+        return std::numeric_limits<T>::quiet_NaN();
+    }
+    return T(0) == value ? T(0) : value;
+}
+
+} // end namespace workflow::type::internal
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <workflow/utils/Error.hpp>
+#include <workflow/utils/Hash.hpp>
+
+#include <workflow/type/IDataStream.hpp>
+
+namespace workflow::type::internal {
+
+/**
+ * Write only data stream feeding all data into a hasher. Used to hash values
+ * that are only accessible through their serialization.
+ */
+class HashStream : public IDataStream
+{
+public:
+    HashStream( utils::Hasher& hasher );
+
+    virtual void
+    write( const size_t length,
+           const void* data ) override;
+
+    virtual void
+    read( const size_t length,
+          void* data ) override;
+
+    virtual bool
+    tryRead( const size_t length,
+             void* data ) override;
+
+    virtual size_t
+    available() const override;
+
+private:
+    utils::Hasher& mHasher;
+};
+
+/******************************************************************************
+ * Inlined implementations
+ *****************************************************************************/
+inline
+HashStream::HashStream( utils::Hasher& hasher )
+    : mHasher( hasher )
+{
+}
+
+inline void
+HashStream::write( const size_t length,
+                   const void* data )
+{
+    mHasher.update( data, length );
+}
+
+inline void
+HashStream::read( const size_t,
+                  void* )
+{
+    SEQ_ASSERT_INVARIANT( false, "HashStream is write only" );
+}
+
+inline bool
+HashStream::tryRead( const size_t,
+                     void* )
+{
+    return false;
+}
+
+inline size_t
+HashStream::available() const
+{
+    return 0;
+}
+
+} // end namespace workflow::type::internal
@@ -0,0 +1,34 @@
+#pragma once
+
+namespace workflow::type::internal {
+
+/**
+ * Test if a character ends a run of plain characters in a JSON string: a
+ * quote, a backslash or a control character
+ *
+ * @param [in]  c           The character
+ *
+ * @return True if the character needs attention
+ */
+inline bool
+isJsonSpecial( char c ) noexcept
+{
+    const auto value = static_cast<unsigned char>( c );
+    return value < 0x20 || '"' == value || '\\' == value;
+}
+
+/**
+ * Find the first special character of a JSON string. The characters are
+ * tested a register at a time with the instruction set selected by
+ * math::setSimdLevel(), or eight at a time in a 64 bit word without one.
+ *
+ * @param [in]  begin       The first character
+ * @param [in]  end         Behind the last character
+ *
+ * @return The first special character or end
+ */
+const char*
+findJsonSpecial( const char* begin,
+                 const char* end ) noexcept;
+
+} // end namespace workflow::type::internal
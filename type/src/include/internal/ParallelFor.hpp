@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace workflow::type::internal {
+
+/**
+ * Run tasks on the calling thread and helper threads. Tasks are started in
+ * order and no task is started after one failed. Every started task runs to
+ * its end, so the first failed task does not depend on the timing of the
+ * threads. The first exception thrown by a task is rethrown.
+ *
+ * @param [in]  threads     Maximum number of threads, the calling one included
+ * @param [in]  count       Number of tasks
+ * @param [in]  task        Called with the task index, returns false on failure
+ */
+void
+parallelFor( size_t threads,
+             size_t count,
+             const std::function<bool( size_t )>& task );
+
+} // end namespace workflow::type::internal
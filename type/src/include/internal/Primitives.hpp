@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <typeindex>
+
+namespace workflow::type::internal {
+
+/**
+ * Tag of a type, passes the type to generic lambdas
+ */
+template<typename T>
+struct Tag
+{
+    using type = T;
+};
+
+/**
+ * List of types
+ */
+template<typename... T>
+struct TypeList
+{
+    static constexpr size_t SIZE = sizeof...(T);
+};
+
+/// The numeric built in types. They are stored contiguously by vectors and
+/// have an encoding of fixed size.
+using Numbers = TypeList<uint8_t, uint16_t, uint32_t, uint64_t,
+                         int8_t, int16_t, int32_t, int64_t,
+                         float, double>;
+
+/// All built in types
+using Primitives = TypeList<bool,
+                            uint8_t, uint16_t, uint32_t, uint64_t,
+                            int8_t, int16_t, int32_t, int64_t,
+                            float, double,
+                            std::string>;
+
+/**
+ * Call a function with the tag of each type of a list in order, until it
+ * returns true
+ *
+ * @param [in]  function    Callable taking a Tag and returning a bool
+ *
+ * @return True if the function returned true for a type
+ */
+template<typename List, typename F>
+bool
+anyOf( F&& function );
+
+/**
+ * Call a function with the tag of a built in type
+ *
+ * @param [in]  type        The type
+ * @param [in]  function    Callable taking a Tag
+ *
+ * @return False if the type is not built in
+ */
+template<typename F>
+bool
+dispatchPrimitive( std::type_index type,
+                   F&& function );
+
+/******************************************************************************
+ * Inlined implementations
+ *****************************************************************************/
+template<typename... T, typename F>
+inline bool
+anyOfImpl( TypeList<T...>,
+           F& function )
+{
+    return ( function( Tag<T>() ) || ... );
+}
+
+template<typename List, typename F>
+inline bool
+anyOf( F&& function )
+{
+    return anyOfImpl( List(), function );
+}
+
+template<typename F>
+inline bool
+dispatchPrimitive( std::type_index type,
+                   F&& function )
+{
+    return anyOf<Primitives>( [&]( auto tag )
+    {
+        if ( type != typeid(typename decltype(tag)::type) )
+        {
+            return false;
+        }
+        function( tag );
+        return true;
+    } );
+}
+
+} // end namespace workflow::type::internal
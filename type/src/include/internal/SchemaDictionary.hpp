@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <workflow/type/DecodeError.hpp>
+#include <workflow/type/StructSchema.hpp>
+
+namespace workflow::type {
+
+class DataStream;
+
+namespace internal {
+
+/**
+ * Schemas already transferred over a data stream. A schema is referenced by a
+ * uint32 id, ids are assigned in the order of first use. The first reference
+ * to a schema is followed by its definition: the struct name, the attribute
+ * count and for each attribute the name, the data type id and
+ *  - the variant type hash of a variant,
+ *  - the element type hash of a vector,
+ *  - the schema reference of a struct.
+ * Writing and reading keep separate tables, so a stream may be used for both.
+ */
+class SchemaDictionary
+{
+public:
+    /**
+     * Write a reference to a schema, with its definition on first use
+     *
+     * @param [in]  stream      The stream
+     * @param [in]  schema      The schema
+     */
+    void
+    write( DataStream& stream,
+           const StructSchemaSharedPtr& schema );
+
+    /**
+     * Read a schema reference written by write()
+     *
+     * @param [in]  stream      The stream
+     * @param [out] schema      The schema
+     *
+     * @return DecodeError::None on success, else the reason of the failure
+     */
+    DecodeError
+    read( DataStream& stream,
+          StructSchemaSharedPtr& schema );
+
+private:
+    DecodeError
+    readDefinition( DataStream& stream,
+                    StructSchemaSharedPtr& schema );
+
+    // The written schemas are kept alive, so their addresses stay unique
+    std::unordered_map<const StructSchema*, uint32_t>   mWriteIds;
+    std::vector<StructSchemaSharedPtr>                  mWritten;
+    std::vector<StructSchemaSharedPtr>                  mRead;
+};
+
+} // end namespace internal
+} // end namespace workflow::type
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+#include <workflow/type/DecodeError.hpp>
+#include <workflow/type/IDataType.hpp>
+
+namespace workflow::type {
+
+class DataStream;
+class IVariantMethods;
+
+namespace internal {
+
+/// Encoded size of values that are neither of fixed size nor strings
+constexpr size_t UNKNOWN_ENCODING = 0;
+
+/// Encoded size of strings, they are prefixed by their length
+constexpr size_t STRING_ENCODING = std::numeric_limits<size_t>::max();
+
+/**
+ * Get the encoded size of the values of a variant type. It is known for the
+ * default variant methods, so their values can be skipped without decoding.
+ *
+ * @param [in]  hash        The variant type hash
+ *
+ * @return The size in bytes, STRING_ENCODING or UNKNOWN_ENCODING
+ */
+size_t
+getEncodedSize( uint64_t hash );
+
+/**
+ * Read a variant type hash and look up its methods
+ *
+ * @param [in]  stream      The stream
+ * @param [out] methods     The methods
+ * @param [out] hash        The hash
+ *
+ * @return DecodeError::None on success, else the reason of the failure
+ */
+DecodeError
+readMethods( DataStream& stream,
+             const IVariantMethods*& methods,
+             uint64_t& hash );
+
+/**
+ * Skip a string
+ *
+ * @param [in]  stream      The stream
+ *
+ * @return DecodeError::None on success, else the reason of the failure
+ */
+DecodeError
+skipString( DataStream& stream );
+
+/**
+ * Skip a variant value
+ *
+ * @param [in]  stream      The stream
+ * @param [in]  methods     The methods of the variant type
+ * @param [in]  encodedSize The encoded size, see getEncodedSize()
+ *
+ * @return DecodeError::None on success, else the reason of the failure
+ */
+DecodeError
+skipValue( DataStream& stream,
+           const IVariantMethods& methods,
+           size_t encodedSize );
+
+/**
+ * Skip the body of a data type
+ *
+ * @param [in]  stream      The stream
+ * @param [in]  type        The data type id read before
+ *
+ * @return DecodeError::None on success, else the reason of the failure
+ */
+DecodeError
+skipBody( DataStream& stream,
+          uint32_t type );
+
+/**
+ * Skip a data type written by IDataType::serialize(). Counts as nesting
+ * level.
+ *
+ * @param [in]  stream      The stream
+ *
+ * @return DecodeError::None on success, else the reason of the failure
+ */
+DecodeError
+skipDataType( DataStream& stream );
+
+} // end namespace internal
+} // end namespace workflow::type
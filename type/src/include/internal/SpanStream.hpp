@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include <workflow/utils/Error.hpp>
+#include <workflow/utils/Span.hpp>
+
+#include <workflow/type/IDataStream.hpp>
+
+namespace workflow::type::internal {
+
+/**
+ * Read only data stream backend over memory owned by someone else
+ */
+class SpanStream : public IDataStream
+{
+public:
+    explicit
+    SpanStream( utils::Span<const uint8_t> data ) noexcept;
+
+    /**
+     * Get the read position
+     */
+    size_t
+    getPosition() const noexcept;
+
+    /**
+     * Get the data at the read position
+     */
+    const uint8_t*
+    current() const noexcept;
+
+    virtual void
+    write( const size_t length,
+           const void* data ) override;
+
+    virtual void
+    read( const size_t length,
+          void* data ) override;
+
+    virtual bool
+    tryRead( const size_t length,
+             void* data ) override;
+
+    virtual bool
+    trySkip( const size_t length ) override;
+
+    virtual size_t
+    available() const override;
+
+private:
+    utils::Span<const uint8_t>  mData;
+    size_t                      mReadPos = 0;
+};
+
+/******************************************************************************
+ * Inlined implementations
+ *****************************************************************************/
+inline
+SpanStream::SpanStream( utils::Span<const uint8_t> data ) noexcept
+    : mData( data )
+{
+}
+
+inline size_t
+SpanStream::getPosition() const noexcept
+{
+    return mReadPos;
+}
+
+inline const uint8_t*
+SpanStream::current() const noexcept
+{
+    return mData.data() + mReadPos;
+}
+
+inline bool
+SpanStream::trySkip( const size_t length )
+{
+    if ( length > mData.size() - mReadPos )
+    {
+        return false;
+    }
+    mReadPos += length;
+    return true;
+}
+
+inline void
+SpanStream::write( const size_t,
+                   const void* )
+{
+    SEQ_ASSERT_INVARIANT( false, "Read only stream" );
+}
+
+inline void
+SpanStream::read( const size_t length,
+                  void* data )
+{
+    SEQ_ASSERT_INVARIANT( tryRead( length, data ), "End of stream" );
+}
+
+inline bool
+SpanStream::tryRead( const size_t length,
+                     void* data )
+{
+    if ( length > available() )
+    {
+        return false;
+    }
+    if ( length )
+    {
+        std::memcpy( data, current(), length );
+        mReadPos += length;
+    }
+    return true;
+}
+
+inline size_t
+SpanStream::available() const
+{
+    return mData.size() - mReadPos;
+}
+
+} // end namespace workflow::type::internal
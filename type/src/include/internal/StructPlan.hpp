@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <workflow/type/DecodeError.hpp>
+#include <workflow/type/Projection.hpp>
+#include <workflow/type/StructDataType.hpp>
+
+namespace workflow::type {
+
+class DataStream;
+class IVariantMethods;
+class TreeEngine;
+
+namespace internal {
+
+/**
+ * Serialization of a struct schema compiled into a flat list of operations.
+ * Everything that only depends on the schema, like the names, the type ids and
+ * the variant hashes, is encoded once into literal byte runs. The remaining
+ * operations handle the values. The variant methods are looked up by their
+ * hash on every call, they may be removed from the VariantMethodsManager and
+ * inserted again while the schema and its plan live on.
+ */
+class StructPlan
+{
+public:
+    /**
+     * Compile plan
+     *
+     * @param [in]  schema      The schema
+     */
+    explicit
+    StructPlan( const StructSchema& schema );
+
+    /**
+     * Write the struct body, the same bytes StructDataType::serialize() writes
+     *
+     * @param [in]  stream      The stream
+     * @param [in]  values      The values, matching the schema
+     */
+    void
+    encode( DataStream& stream,
+            const StructDataType::Values& values ) const;
+
+    /**
+     * Read a struct body that is expected to match the schema
+     *
+     * @param [in]  stream      The stream
+     * @param [out] values      The values
+     *
+     * @return DecodeError::None on success, DecodeError::TypeMismatch if the
+     *         data does not match the schema, else the reason of the failure
+     */
+    DecodeError
+    decode( DataStream& stream,
+            StructDataType::Values& values ) const;
+
+    /**
+     * Write only the values, without names and type headers. Used once the
+     * schema is known to the reader, see DataStream::setSchemaDictionary().
+     *
+     * @param [in]  stream      The stream
+     * @param [in]  values      The values, matching the schema
+     */
+    void
+    encodeValues( DataStream& stream,
+                  const StructDataType::Values& values ) const;
+
+    /**
+     * Read values written by encodeValues()
+     *
+     * @param [in]  stream      The stream
+     * @param [out] values      The values
+     *
+     * @return DecodeError::None on success, else the reason of the failure
+     */
+    DecodeError
+    decodeValues( DataStream& stream,
+                  StructDataType::Values& values ) const;
+
+    /**
+     * Read the projected values written by encodeValues(), skipping all other
+     * values
+     *
+     * @param [in]  stream      The stream
+     * @param [in]  projection  The attributes to decode
+     * @param [out] attributes  The decoded attributes, ordered by name
+     * @param [out] values      The decoded values
+     *
+     * @return DecodeError::None on success, else the reason of the failure
+     */
+    DecodeError
+    decodeValues( DataStream& stream,
+                  const Projection& projection,
+                  StructSchema::Attributes& attributes,
+                  StructDataType::Values& values ) const;
+
+    /**
+     * Skip values written by encodeValues()
+     *
+     * @param [in]  stream      The stream
+     *
+     * @return DecodeError::None on success, else the reason of the failure
+     */
+    DecodeError
+    skipValues( DataStream& stream ) const;
+
+private:
+    friend class workflow::type::TreeEngine;
+
+    enum class OpCode : uint8_t
+    {
+        Literal,    ///< Write, or read and compare, mLiterals[offset, offset + size)
+        Variant,    ///< Variant value of the methods with the hash
+        Struct,     ///< Struct body with resolved plan
+        Vector,     ///< Vector body
+    };
+
+    struct Op
+    {
+        OpCode                              code;
+        uint32_t                            index;
+        uint32_t                            offset;
+        uint32_t                            size;
+        size_t                              encodedSize;    ///< Of a variant, see getEncodedSize()
+        uint64_t                            hash;           ///< Of the variant methods
+        const StructSchema::Attribute*      attribute;
+    };
+
+    /**
+     * Read a literal and compare it to the expected bytes
+     */
+    DecodeError
+    expectLiteral( DataStream& stream,
+                   const Op& op ) const;
+
+    /**
+     * Read the value of a variant, struct or vector operation
+     */
+    DecodeError
+    decodeValue( DataStream& stream,
+                 const Op& op,
+                 IDataTypeSharedPtr& result,
+                 bool valuesOnly ) const;
+
+    DecodeError
+    skipValue( DataStream& stream,
+               const Op& op ) const;
+
+    /**
+     * Find the methods of a variant operation. Does not throw.
+     *
+     * @return The methods or nullptr if they are not registered
+     */
+    static const IVariantMethods*
+    findMethods( const Op& op ) noexcept;
+
+    std::vector<Op>         mOps;
+    std::vector<uint8_t>    mLiterals;
+    size_t                  mNumValues;
+};
+
+} // end namespace internal
+} // end namespace workflow::type
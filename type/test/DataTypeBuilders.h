@@ -0,0 +1,82 @@
+#pragma once
+
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <workflow/type/DataStream.hpp>
+#include <workflow/type/VariantDataType.hpp>
+#include <workflow/type/VectorDataType.hpp>
+
+#include "VectorDataStream.h"
+
+/**
+ * Read the bytes left in a stream
+ */
+inline std::vector<uint8_t>
+toBuffer( workflow::type::DataStream& stream )
+{
+    std::vector<uint8_t> buffer( stream.available() );
+    stream.read( buffer.size(), buffer.data() );
+    return buffer;
+}
+
+/**
+ * Serialize a data type with its type header
+ */
+inline std::vector<uint8_t>
+toBuffer( const workflow::type::IDataType& type )
+{
+    workflow::type::DataStream stream( std::make_unique<VectorStream>() );
+    workflow::type::IDataType::serialize( stream, type );
+    return toBuffer( stream );
+}
+
+/**
+ * Create a variant data type holding a value
+ */
+template<typename T>
+std::shared_ptr<workflow::type::VariantDataType>
+makeVariant( const T& value )
+{
+    return std::make_shared<workflow::type::VariantDataType>( workflow::type::Variant( value ) );
+}
+
+/**
+ * Create a vector holding the given elements
+ */
+template<typename T>
+std::shared_ptr<workflow::type::VectorDataType>
+makeVector( std::initializer_list<T> values )
+{
+    auto ret = std::make_shared<workflow::type::VectorDataType>( workflow::type::Variant( T() ) );
+    for ( const auto& value: values )
+    {
+        ret->push_back( value );
+    }
+    return ret;
+}
+
+/**
+ * Create a vector holding the elements 0 to count - 1, as text for strings
+ */
+template<typename T>
+std::shared_ptr<workflow::type::VectorDataType>
+makeVector( size_t count )
+{
+    auto ret = std::make_shared<workflow::type::VectorDataType>( workflow::type::Variant( T() ) );
+    for ( size_t i = 0; i < count; ++i )
+    {
+        if constexpr ( std::is_same_v<T, std::string> )
+        {
+            ret->push_back( std::to_string( i ) );
+        }
+        else
+        {
+            ret->push_back( static_cast<T>( i ) );
+        }
+    }
+    return ret;
+}
@@ -38,7 +38,29 @@ public:
                    reinterpret_cast<uint8_t*>( data ) );
         mReadPos += length;
     }
+
+    virtual bool
+    tryRead( const size_t length,
+             void* data ) override
+    {
+        if ( !length || !data || mReadPos + length > mData.size() )
+        {
+            return false;
+        }
+
+        std::copy( mData.begin() + mReadPos,
+                   mData.begin() + mReadPos + length,
+                   reinterpret_cast<uint8_t*>( data ) );
+        mReadPos += length;
+        return true;
+    }
+    virtual size_t
+    available() const override
+    {
+        return mData.size() - mReadPos;
+    }
+
 private:
-    size_t               mReadPos;
+    size_t               mReadPos = 0;
     std::vector<uint8_t> mData;
 };
\ No newline at end of file
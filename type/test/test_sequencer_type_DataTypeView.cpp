@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <workflow/type/DataTypeView.hpp>
+#include <workflow/type/VariantDataType.hpp>
+#include <workflow/type/VectorDataType.hpp>
+#include <workflow/type/StructDataType.hpp>
+#include <workflow/type/DataStream.hpp>
+
+#include "DataTypeBuilders.h"
+
+using namespace workflow::type;
+
+namespace {
+
+StructDataType
+makeRecord()
+{
+    return StructDataType( "Record",
+    {
+        { "name", makeVariant( std::string("first") ) },
+        { "value", makeVariant( 1.5 ) },
+        { "numbers", makeVector<int32_t>( { 1, 2 } ) },
+        { "strings", makeVector<std::string>( { "a", "bc" } ) },
+        { "nested", std::make_shared<StructDataType>( "Nested", StructDataType::NamedTypes
+            {
+                { "flag", makeVariant( true ) }
+            }) }
+    });
+}
+
+}// end namespace
+
+TEST( test_sequencer_type_DataTypeView, Struct )
+{
+    const auto record = makeRecord();
+    const auto buffer = toBuffer( record );
+    DataTypeView view( DataTypeView::Data( buffer.data(), buffer.size() ) );
+
+    ASSERT_EQ( IDataType::Type::Struct, view.getType() );
+    ASSERT_EQ( "Record", view.getName() );
+    ASSERT_EQ( 5u, view.size() );
+    for ( size_t i = 0; i < view.size(); ++i )
+    {
+        ASSERT_EQ( record.getAttributes()[i], view.getAttributeName( i ) );
+    }
+    ASSERT_TRUE( view.has( "value" ) );
+    ASSERT_FALSE( view.has( "other" ) );
+    ASSERT_THROW( view.get( "other" ), workflow::utils::Error );
+    ASSERT_THROW( view.getValue(), workflow::utils::Error );
+
+    auto value = view.get( "value" );
+    ASSERT_EQ( IDataType::Type::Variant, value.getType() );
+    ASSERT_EQ( std::type_index(typeid(double)), value.getValueType() );
+    ASSERT_EQ( Variant(1.5), value.getValue() );
+    ASSERT_EQ( Variant(std::string("first")), view.get( "name" ).getValue() );
+    ASSERT_EQ( Variant(true), view.get( "nested" ).get( "flag" ).getValue() );
+
+    auto materialized = view.materialize();
+    ASSERT_EQ( record, *materialized );
+    ASSERT_EQ( record.get( "nested" ), *view.get( "nested" ).materialize() );
+}
+
+TEST( test_sequencer_type_DataTypeView, Vector )
+{
+    const auto record = makeRecord();
+    const auto buffer = toBuffer( record );
+    DataTypeView view( DataTypeView::Data( buffer.data(), buffer.size() ) );
+
+    auto numbers = view.get( "numbers" );
+    ASSERT_EQ( record.get( "numbers" ).getName(), numbers.getName() );
+    ASSERT_EQ( 2u, numbers.size() );
+    ASSERT_EQ( Variant(int32_t(2)), numbers.getElement( 1 ) );
+    ASSERT_THROW( numbers.getElement( 2 ), workflow::utils::Error );
+
+    auto strings = view.get( "strings" );
+    ASSERT_EQ( std::type_index(typeid(std::string)), strings.getValueType() );
+    ASSERT_EQ( 2u, strings.size() );
+    ASSERT_EQ( Variant(std::string("bc")), strings.getElement( 1 ) );
+    ASSERT_EQ( Variant(std::string("a")), strings.getElement( 0 ) );
+}
+
+TEST( test_sequencer_type_DataTypeView, Malformed )
+{
+    const auto buffer = toBuffer( makeRecord() );
+
+    // Truncated data is detected when the offset table is built
+    DataTypeView truncated( DataTypeView::Data( buffer.data(), buffer.size() - 1 ) );
+    ASSERT_THROW( truncated.size(), workflow::utils::Error );
+    ASSERT_THROW( truncated.materialize(), workflow::utils::Error );
+
+    DecodeLimits limits;
+    limits.maxDepth = 1;
+    DataTypeView limited( DataTypeView::Data( buffer.data(), buffer.size() ), limits );
+    ASSERT_THROW( limited.size(), workflow::utils::Error );
+}
+
+TEST( test_sequencer_type_DataTypeView, Children )
+{
+    auto chain = std::make_shared<StructDataType>( "B", StructDataType::NamedTypes
+    {
+        { "v", std::make_shared<VariantDataType>(Variant(int32_t(1))) }
+    } );
+    chain = std::make_shared<StructDataType>( "A", StructDataType::NamedTypes{ { "b", chain } } );
+    const StructDataType root( "Root", StructDataType::NamedTypes{ { "a", chain } } );
+    const auto buffer = toBuffer( root );
+    const DataTypeView::Data data( buffer.data(), buffer.size() );
+
+    // The depth needed to decode the root is enough for every attribute view
+    DecodeLimits limits;
+    limits.maxDepth = 3;
+    ASSERT_THROW( DataTypeView( data, limits ).size(), workflow::utils::Error );
+    limits.maxDepth = 4;
+    auto b = DataTypeView( data, limits ).get( "a" ).get( 0 );
+    ASSERT_EQ( "B", b.getName() );
+    ASSERT_EQ( Variant(int32_t(1)), b.get( "v" ).getValue() );
+    ASSERT_EQ( chain->get( "b" ), *b.materialize() );
+
+    // Attribute views of a struct stay valid without it and share its offset tables
+    DataTypeView view( data );
+    ASSERT_EQ( view.get( "a" ).get( "b" ).getData().data(), view.get( 0 ).get( 0 ).getData().data() );
+    ASSERT_EQ( Variant(int32_t(1)), view.get( "a" ).get( "b" ).get( "v" ).getValue() );
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <future>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+#include <workflow/utils/Demangle.hpp>
+
+#include <workflow/type/Variant.hpp>
+
+using namespace workflow::type;
+using workflow::utils::demangle;
+using workflow::utils::typeName;
+
+namespace {
+
+template<int N>
+struct Fresh
+{
+};
+
+/**
+ * Demangle the names of Fresh<0> to Fresh<N - 1>
+ */
+template<int... N>
+std::vector<const std::string*>
+demangleFresh( std::integer_sequence<int, N...> )
+{
+    return { &demangle( std::type_index( typeid(Fresh<N>) ) )... };
+}
+
+}// end namespace
+
+TEST( test_sequencer_type_Demangle, Cached )
+{
+    const auto& name = demangle( std::type_index( typeid(Variant) ) );
+    ASSERT_EQ( "workflow::type::Variant", name );
+    ASSERT_EQ( &name, &demangle( std::type_index( typeid(Variant) ) ) );
+    ASSERT_EQ( &name, &typeName<Variant>() );
+    ASSERT_EQ( &name, &typeName<Variant>() );
+    ASSERT_EQ( "workflow::type::Variant", demangle( std::string( typeid(Variant).name() ) ) );
+}
+
+TEST( test_sequencer_type_Demangle, ConcurrentFirstUse )
+{
+    // All threads start at once to demangle types not used before
+    constexpr size_t THREADS = 8;
+    std::promise<void> start;
+    std::shared_future<void> started( start.get_future() );
+    std::vector<std::future<std::vector<const std::string*>>> results;
+    for ( size_t i = 0; i < THREADS; ++i )
+    {
+        results.push_back( std::async( std::launch::async, [started]
+        {
+            started.wait();
+            return demangleFresh( std::make_integer_sequence<int, 64>() );
+        } ) );
+    }
+    start.set_value();
+
+    const auto expected = demangleFresh( std::make_integer_sequence<int, 64>() );
+    ASSERT_EQ( "(anonymous namespace)::Fresh<63>", *expected.back() );
+    for ( auto& result: results )
+    {
+        ASSERT_EQ( expected, result.get() );
+    }
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include <typeindex>
+
+#include <workflow/utils/Error.hpp>
+
+using workflow::utils::Error;
+
+namespace {
+
+void
+fail()
+{
+    SEQ_ASSERT_ARGUMENT( false, "Failed " << 42 );
+}
+
+/**
+ * Restores the stack trace setting of the test run
+ */
+class StackTraceSetting
+{
+public:
+    StackTraceSetting()
+        : mEnabled( Error::isStackTraceEnabled() )
+    {
+    }
+
+    ~StackTraceSetting()
+    {
+        Error::setStackTraceEnabled( mEnabled );
+    }
+
+private:
+    bool mEnabled;
+};
+
+/**
+ * Get the error thrown by fail()
+ */
+Error
+catchError()
+{
+    try
+    {
+        fail();
+    }
+    catch ( const Error& error )
+    {
+        return error;
+    }
+    ADD_FAILURE() << "No error thrown";
+    return Error( __FILE__, __LINE__, __PRETTY_FUNCTION__, "Not thrown" );
+}
+
+}// end namespace
+
+TEST( test_sequencer_type_Error, StackTrace )
+{
+    StackTraceSetting setting;
+    ASSERT_TRUE( Error::isStackTraceEnabled() );
+
+    const auto traced = catchError();
+    ASSERT_EQ( "Failed 42", traced.getMessage() );
+    ASSERT_EQ( ::workflow::utils::CommonError::InvalidArgument, traced.getErrorCode().getCode() );
+    ASSERT_EQ( std::type_index( typeid(::workflow::utils::CommonError) ), traced.getErrorCode().getTypeIndex() );
+    const auto trace = traced.getStackTrace();
+    ASSERT_FALSE( trace.empty() );
+    ASSERT_EQ( trace, traced.getStackTrace() );
+
+    // Errors created while disabled keep no trace, existing ones keep theirs
+    Error::setStackTraceEnabled( false );
+    ASSERT_FALSE( Error::isStackTraceEnabled() );
+    const auto untraced = catchError();
+    ASSERT_EQ( "Failed 42", untraced.getMessage() );
+    ASSERT_EQ( traced.getLine(), untraced.getLine() );
+    ASSERT_TRUE( untraced.getStackTrace().empty() );
+    ASSERT_EQ( trace, traced.getStackTrace() );
+
+    Error::setStackTraceEnabled( true );
+    ASSERT_FALSE( catchError().getStackTrace().empty() );
+}
@@ -0,0 +1,250 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include <workflow/utils/Error.hpp>
+#include <workflow/utils/InternedString.hpp>
+
+#include <workflow/type/JsonReader.hpp>
+#include <workflow/type/JsonWriter.hpp>
+#include <workflow/type/VariantDataType.hpp>
+#include <workflow/type/VectorMath.hpp>
+#include <workflow/type/VectorDataType.hpp>
+#include <workflow/type/StructDataType.hpp>
+
+#include "DataTypeBuilders.h"
+
+using namespace workflow::type;
+
+namespace {
+
+StructDataType
+makeRecord()
+{
+    return StructDataType( "Record", StructDataType::NamedTypes
+    {
+        { "label", makeVariant( std::string("a\"b\n\x01 \xc3\xa9") ) },
+        { "value", makeVariant( 0.1 ) },
+        { "big", makeVariant( std::numeric_limits<uint64_t>::max() ) },
+        { "numbers", makeVector<int32_t>( { 1, -2 } ) },
+        { "reals", makeVector<float>( { 0.1f, -1e30f } ) },
+        { "empty", makeVector<std::string>( {} ) },
+        { "nested", std::make_shared<StructDataType>( "Nested", StructDataType::NamedTypes
+            {
+                { "flag", makeVariant( true ) },
+                { "small", makeVariant( int8_t(-100) ) }
+            }) }
+    } );
+}
+
+template<typename T>
+T
+getValue( const IDataType& dataType,
+          const std::string& name )
+{
+    const auto& value = static_cast<const StructDataType&>( dataType ).get( name );
+    EXPECT_EQ( IDataType::Type::Variant, value.getType() );
+    return static_cast<const VariantDataType&>( value ).get().get<T>();
+}
+
+}// end namespace
+
+TEST( test_sequencer_type_JsonReader, Schema )
+{
+    const auto record = makeRecord();
+    JsonWriter writer;
+    JsonReader reader;
+    ASSERT_EQ( record, *reader.parse( writer.write( record ), record.getSchema() ) );
+
+    // Attributes in any order, white space and escapes
+    const auto text = " {\n\t\"value\" : 0.1, \"reals\": [ 0.1 , -1e30 ], \"nested\": {\"small\": -100, \"flag\": true},"
+                      "\"numbers\":[1,-2], \"label\": \"a\\\"b\\n\\u0001\\u0020\\u00e9\", \"empty\": [ ],"
+                      "\"big\": 18446744073709551615 }\r\n";
+    ASSERT_EQ( record, *reader.parse( text, record.getSchema() ) );
+
+    // null reads as NaN
+    const StructDataType real( "Real", StructDataType::NamedTypes
+    {
+        { "value", std::make_shared<VariantDataType>(Variant(0.0)) }
+    } );
+    auto result = reader.parse( "{\"value\":null}", real.getSchema() );
+    ASSERT_TRUE( std::isnan( getValue<double>( *result, "value" ) ) );
+}
+
+TEST( test_sequencer_type_JsonReader, Infer )
+{
+    JsonReader reader;
+    const auto result = reader.parse( "{\"b\":false,\"i\":-3,\"u\":18446744073709551615,\"r\":2.5e0,"
+                                      "\"s\":\"\\ud83d\\ude00\",\"v\":[1,2.5,3],\"w\":[],\"x\":[\"a\"],"
+                                      "\"n\":{\"k\":[true]}}" );
+    ASSERT_EQ( JsonReader::OBJECT_NAME, static_cast<const StructDataType&>( *result ).getSchema()->getName() );
+    ASSERT_EQ( false, getValue<bool>( *result, "b" ) );
+    ASSERT_EQ( -3, getValue<int64_t>( *result, "i" ) );
+    ASSERT_EQ( std::numeric_limits<uint64_t>::max(), getValue<uint64_t>( *result, "u" ) );
+    ASSERT_EQ( 2.5, getValue<double>( *result, "r" ) );
+    ASSERT_EQ( "\xf0\x9f\x98\x80", getValue<std::string>( *result, "s" ) );
+
+    const auto& structure = static_cast<const StructDataType&>( *result );
+    const auto& v = static_cast<const VectorDataType&>( structure.get( "v" ) );
+    ASSERT_EQ( std::vector<double>( { 1.0, 2.5, 3.0 } ), std::vector<double>( v.begin<double>(), v.end<double>() ) );
+    ASSERT_EQ( std::type_index( typeid(double) ), static_cast<const VectorDataType&>( structure.get( "w" ) ).getElementType() );
+    ASSERT_EQ( std::type_index( typeid(std::string) ), static_cast<const VectorDataType&>( structure.get( "x" ) ).getElementType() );
+
+    const auto& nested = static_cast<const StructDataType&>( structure.get( "n" ) );
+    ASSERT_EQ( std::type_index( typeid(bool) ), static_cast<const VectorDataType&>( nested.get( "k" ) ).getElementType() );
+
+    // Values other than objects
+    auto integers = reader.parse( " [1, 2] " );
+    ASSERT_EQ( std::type_index( typeid(int64_t) ), static_cast<const VectorDataType&>( *integers ).getElementType() );
+    auto text = reader.parse( "\"text\"" );
+    ASSERT_EQ( "text", static_cast<const VariantDataType&>( *text ).get().get<std::string>() );
+
+    // Nesting does not recurse
+    std::string deep;
+    for ( size_t i = 0; i < 10000; ++i )
+    {
+        deep += "{\"a\":";
+    }
+    deep += "1" + std::string( 10000, '}' );
+    JsonWriter writer;
+    ASSERT_EQ( deep, writer.write( *reader.parse( deep ) ) );
+}
+
+TEST( test_sequencer_type_JsonReader, Malformed )
+{
+    const auto record = makeRecord();
+    const StructDataType number( "Number", StructDataType::NamedTypes
+    {
+        { "value", std::make_shared<VariantDataType>(Variant(uint8_t(0))) }
+    } );
+
+    struct Case
+    {
+        std::string             text;
+        StructSchemaSharedPtr   schema;
+        DecodeError             error;
+        size_t                  offset;
+    };
+
+    const std::vector<Case> cases
+    {
+        { "", nullptr, DecodeError::EndOfStream, 0 },
+        { "{\"a\":1", nullptr, DecodeError::EndOfStream, 6 },
+        { "{\"a\":1,}", nullptr, DecodeError::SyntaxError, 7 },
+        { "{\"a\" 1}", nullptr, DecodeError::SyntaxError, 5 },
+        { "[1,]", nullptr, DecodeError::SyntaxError, 3 },
+        { "[1 2]", nullptr, DecodeError::SyntaxError, 3 },
+        { "01", nullptr, DecodeError::SyntaxError, 1 },
+        { "1.", nullptr, DecodeError::EndOfStream, 2 },
+        { "+1", nullptr, DecodeError::SyntaxError, 0 },
+        { "tru", nullptr, DecodeError::EndOfStream, 3 },
+        { "trux", nullptr, DecodeError::SyntaxError, 0 },
+        { "\"a\x01\"", nullptr, DecodeError::SyntaxError, 2 },
+        { "\"\\x\"", nullptr, DecodeError::SyntaxError, 2 },
+        { "\"\\udc00\"", nullptr, DecodeError::InvalidValue, 7 },
+        { "null", nullptr, DecodeError::TypeMismatch, 0 },
+        { "{}", nullptr, DecodeError::MissingAttribute, 2 },
+        { "{\"\":1}", nullptr, DecodeError::InvalidName, 3 },
+        { "{\"a\":1,\"a\":2}", nullptr, DecodeError::DuplicateAttribute, 13 },
+        { "[1,\"a\"]", nullptr, DecodeError::TypeMismatch, 3 },
+        { "[[1]]", nullptr, DecodeError::TypeMismatch, 1 },
+        { "1 2", nullptr, DecodeError::SyntaxError, 2 },
+        { "[1]", number.getSchema(), DecodeError::TypeMismatch, 0 },
+        { "{\"value\":256}", number.getSchema(), DecodeError::InvalidValue, 12 },
+        { "{\"value\":-1}", number.getSchema(), DecodeError::InvalidValue, 11 },
+        { "{\"value\":1.5}", number.getSchema(), DecodeError::InvalidValue, 12 },
+        { "{\"value\":\"1\"}", number.getSchema(), DecodeError::TypeMismatch, 9 },
+        { "{\"value\":{}}", number.getSchema(), DecodeError::TypeMismatch, 9 },
+        { "{\"other\":1}", number.getSchema(), DecodeError::UnknownAttribute, 8 },
+        { "{\"value\":1,\"value\":1}", number.getSchema(), DecodeError::DuplicateAttribute, 18 },
+        { "{}", number.getSchema(), DecodeError::MissingAttribute, 2 },
+        { "{\"nested\":1}", record.getSchema(), DecodeError::TypeMismatch, 10 },
+        { "{\"numbers\":[1,2.5]}", record.getSchema(), DecodeError::InvalidValue, 17 },
+    };
+
+    JsonReader reader;
+    for ( const auto& item: cases )
+    {
+        auto result = reader.tryParse( item.text, item.schema );
+        ASSERT_FALSE( result ) << item.text;
+        ASSERT_EQ( item.error, result.error() ) << item.text;
+        ASSERT_EQ( item.offset, reader.getErrorOffset() ) << item.text;
+    }
+    ASSERT_THROW( reader.parse( "[" ), workflow::utils::Error );
+}
+
+TEST( test_sequencer_type_JsonReader, DistinctKeys )
+{
+    // Keys of objects no longer used do not accumulate in the intern table
+    JsonReader reader;
+    for ( size_t i = 0; i < 200; ++i )
+    {
+        std::string text = "{";
+        for ( size_t j = 0; j < 100; ++j )
+        {
+            text += ( j ? ",\"key" : "\"key" ) + std::to_string( i ) + "_" + std::to_string( j ) + "\":1";
+        }
+        ASSERT_TRUE( reader.tryParse( text + "}" ) );
+    }
+    ASSERT_LT( workflow::utils::InternedString::getTableSize(), 4096u );
+
+    // Keys of rejected objects are not interned at all
+    const auto size = workflow::utils::InternedString::getTableSize();
+    ASSERT_FALSE( reader.tryParse( "{\"rejected\":1,\"other\":" ) );
+    ASSERT_EQ( size, workflow::utils::InternedString::getTableSize() );
+}
+
+TEST( test_sequencer_type_JsonReader, Limits )
+{
+    JsonReader reader;
+    const std::string text = "{\"a\":{\"b\":[1,2,3]},\"c\":\"text\\n\"}";
+    ASSERT_TRUE( reader.tryParse( text ) );
+
+    DecodeLimits limits;
+    limits.maxDepth = 3;
+    ASSERT_TRUE( reader.tryParse( text, nullptr, limits ) );
+    limits.maxDepth = 2;
+    ASSERT_EQ( DecodeError::NestingTooDeep, reader.tryParse( text, nullptr, limits ).error() );
+
+    limits = DecodeLimits();
+    limits.maxElementCount = 2;
+    ASSERT_EQ( DecodeError::TooManyElements, reader.tryParse( text, nullptr, limits ).error() );
+
+    limits = DecodeLimits();
+    limits.maxStringLength = 4;
+    ASSERT_EQ( DecodeError::StringTooLong, reader.tryParse( text, nullptr, limits ).error() );
+
+    limits = DecodeLimits();
+    limits.maxTotalBytes = text.size() - 1;
+    ASSERT_EQ( DecodeError::TotalSizeExceeded, reader.tryParse( text, nullptr, limits ).error() );
+}
+
+TEST( test_sequencer_type_JsonReader, Scan )
+{
+    // Special characters at every position of short and register sized runs
+    const std::pair<char, std::string> specials[] = { { '"', "\\\"" }, { '\\', "\\\\" }, { '\x1f', "\\u001f" } };
+    JsonWriter writer;
+    JsonReader reader;
+    for ( auto level: { math::SimdLevel::Scalar, math::SimdLevel::Avx2, math::SimdLevel::Avx512 } )
+    {
+        math::setSimdLevel( level );
+        for ( size_t size = 1; size < 140; ++size )
+        {
+            for ( size_t position = 0; position < size; ++position )
+            {
+                for ( const auto& [special, escape]: specials )
+                {
+                    std::string value( size, size % 2 ? '\x7f' : '\xc3' );
+                    value[position] = special;
+                    const auto expected = "\"" + value.substr( 0, position ) + escape
+                                        + value.substr( position + 1 ) + "\"";
+                    ASSERT_EQ( expected, writer.write( VariantDataType( Variant(value) ) ) );
+
+                    auto result = reader.parse( expected );
+                    ASSERT_EQ( value, static_cast<const VariantDataType&>( *result ).get().get<std::string>() );
+                }
+            }
+        }
+    }
+    math::setSimdLevel( math::getSupportedSimdLevel() );
+}
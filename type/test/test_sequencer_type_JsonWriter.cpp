@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include <limits>
+
+#include <workflow/type/JsonWriter.hpp>
+#include <workflow/type/VariantDataType.hpp>
+#include <workflow/type/VectorDataType.hpp>
+#include <workflow/type/StructDataType.hpp>
+
+using namespace workflow::type;
+
+TEST( test_sequencer_type_JsonWriter, Write )
+{
+    auto numbers = std::make_shared<VectorDataType>( Variant(int32_t(0)) );
+    numbers->push_back( int32_t(1) );
+    numbers->push_back( int32_t(-2) );
+
+    const StructDataType record( "Record", StructDataType::NamedTypes
+    {
+        { "label", std::make_shared<VariantDataType>(Variant(std::string("a\"b\n\x01/"))) },
+        { "value", std::make_shared<VariantDataType>(Variant(0.1)) },
+        { "numbers", numbers },
+        { "empty", std::make_shared<VectorDataType>( Variant(std::string()) ) },
+        { "nested", std::make_shared<StructDataType>( "Nested", StructDataType::NamedTypes
+            {
+                { "flag", std::make_shared<VariantDataType>(Variant(true)) },
+                { "small", std::make_shared<VariantDataType>(Variant(uint8_t(200))) }
+            }) }
+    } );
+
+    JsonWriter writer;
+    ASSERT_EQ( "{\"empty\":[],\"label\":\"a\\\"b\\n\\u0001/\",\"nested\":{\"flag\":true,\"small\":200},"
+               "\"numbers\":[1,-2],\"value\":0.1}", writer.write( record ) );
+
+    // Non finite numbers have no JSON representation
+    auto reals = std::make_shared<VectorDataType>( Variant(0.0f) );
+    reals->push_back( 1.5f );
+    reals->push_back( std::numeric_limits<float>::infinity() );
+    reals->push_back( std::numeric_limits<float>::quiet_NaN() );
+    ASSERT_EQ( "[1.5,null,null]", writer.write( *reals ) );
+
+    writer.clear();
+    writer.append( VariantDataType( Variant(std::numeric_limits<int64_t>::min()) ) );
+    writer.append( VariantDataType( Variant(std::string("long text without escapes")) ) );
+    ASSERT_EQ( "-9223372036854775808\"long text without escapes\"", writer.view() );
+}
+
+TEST( test_sequencer_type_JsonWriter, DeepNesting )
+{
+    auto chain = std::make_shared<StructDataType>( "Leaf", StructDataType::NamedTypes
+    {
+        { "v", std::make_shared<VariantDataType>(Variant(int32_t(1))) }
+    } );
+    for ( size_t i = 0; i < 10000; ++i )
+    {
+        chain = std::make_shared<StructDataType>( "Node" + std::to_string( i ),
+                                                  StructDataType::NamedTypes{ { "next", chain } } );
+    }
+
+    JsonWriter writer;
+    const auto text = writer.write( *chain );
+    ASSERT_EQ( 10000 * std::string( "{\"next\":}" ).size() + std::string( "{\"v\":1}" ).size(), text.size() );
+    ASSERT_EQ( "{\"next\":{\"next\":", text.substr( 0, 16 ) );
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <workflow/type/ParallelDecoder.hpp>
+#include <workflow/type/VariantDataType.hpp>
+#include <workflow/type/VectorDataType.hpp>
+#include <workflow/type/StructDataType.hpp>
+#include <workflow/type/DataStream.hpp>
+
+#include "DataTypeBuilders.h"
+
+using namespace workflow::type;
+
+namespace {
+
+StructDataType
+makeSnapshot()
+{
+    StructDataType::NamedTypes channels;
+    for ( size_t i = 0; i < 20; ++i )
+    {
+        channels.emplace( "channel" + std::to_string( i ), std::make_shared<StructDataType>( "Channel", StructDataType::NamedTypes
+        {
+            { "gain", makeVariant( double(i) ) },
+            { "samples", makeVector<float>( 50 + i ) }
+        } ) );
+    }
+
+    return StructDataType( "Snapshot", StructDataType::NamedTypes
+    {
+        { "id", makeVariant( uint64_t(42) ) },
+        { "names", makeVector<std::string>( 100 ) },
+        { "flags", makeVector<bool>( 300 ) },
+        { "counts", makeVector<int32_t>( 1000 ) },
+        { "times", makeVector<double>( 777 ) },
+        { "channels", std::make_shared<StructDataType>( "Channels", channels ) }
+    } );
+}
+
+}// end namespace
+
+TEST( test_sequencer_type_ParallelDecoder, Deserialize )
+{
+    const auto snapshot = makeSnapshot();
+    const auto buffer = toBuffer( snapshot );
+    const ParallelDecoder::Data data( buffer.data(), buffer.size() );
+
+    ASSERT_EQ( 1u, ParallelDecoder( 1 ).getThreads() );
+    ASSERT_LE( 1u, ParallelDecoder().getThreads() );
+    ASSERT_EQ( ParallelDecoder::DEFAULT_GRAIN_SIZE, ParallelDecoder().getGrainSize() );
+
+    // Small grain sizes split down to single attributes and few elements
+    for ( size_t threads: { 1, 2, 4, 7 } )
+    {
+        for ( size_t grainSize: { 1, 64, 1000, 100000 } )
+        {
+            ParallelDecoder decoder( threads, grainSize );
+            auto result = decoder.tryDeserialize( data );
+            ASSERT_TRUE( result );
+            ASSERT_EQ( snapshot, **result );
+            ASSERT_EQ( snapshot.getContentHash(), (*result)->getContentHash() );
+        }
+    }
+
+    const auto vector = makeVector<uint16_t>( 10000 );
+    const auto vectorBuffer = toBuffer( *vector );
+    auto result = ParallelDecoder( 4, 100 ).deserialize( ParallelDecoder::Data( vectorBuffer.data(),
+                                                                                vectorBuffer.size() ) );
+    ASSERT_EQ( *vector, *result );
+}
+
+TEST( test_sequencer_type_ParallelDecoder, Malformed )
+{
+    const auto buffer = toBuffer( makeSnapshot() );
+    ParallelDecoder decoder( 4, 64 );
+
+    // Every truncation fails like the sequential decoder
+    for ( size_t size: { size_t(0), size_t(3), buffer.size() / 2, buffer.size() - 1 } )
+    {
+        auto result = decoder.tryDeserialize( ParallelDecoder::Data( buffer.data(), size ) );
+        ASSERT_FALSE( result );
+        ASSERT_EQ( DecodeError::EndOfStream, result.error() );
+    }
+    ASSERT_THROW( decoder.deserialize( ParallelDecoder::Data( buffer.data(), buffer.size() / 2 ) ),
+                  workflow::utils::Error );
+
+    const ParallelDecoder::Data data( buffer.data(), buffer.size() );
+    DecodeLimits limits;
+    limits.maxDepth = 3;
+    auto result = decoder.tryDeserialize( data, limits );
+    ASSERT_FALSE( result );
+    ASSERT_EQ( DecodeError::NestingTooDeep, result.error() );
+    limits.maxDepth = 4;
+    ASSERT_TRUE( decoder.tryDeserialize( data, limits ) );
+
+    limits = DecodeLimits();
+    limits.maxTotalBytes = buffer.size() - 1;
+    result = decoder.tryDeserialize( data, limits );
+    ASSERT_FALSE( result );
+    ASSERT_EQ( DecodeError::TotalSizeExceeded, result.error() );
+
+    limits = DecodeLimits();
+    limits.maxElementCount = 999;
+    result = decoder.tryDeserialize( data, limits );
+    ASSERT_FALSE( result );
+    ASSERT_EQ( DecodeError::TooManyElements, result.error() );
+}
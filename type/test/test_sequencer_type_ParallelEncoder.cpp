@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <workflow/type/ParallelEncoder.hpp>
+#include <workflow/type/ParallelDecoder.hpp>
+#include <workflow/type/VariantDataType.hpp>
+#include <workflow/type/VectorDataType.hpp>
+#include <workflow/type/StructDataType.hpp>
+#include <workflow/type/DataStream.hpp>
+
+#include "DataTypeBuilders.h"
+
+using namespace workflow::type;
+
+namespace {
+
+StructDataType
+makeState()
+{
+    StructDataType::NamedTypes axes;
+    for ( size_t i = 0; i < 16; ++i )
+    {
+        axes.emplace( "axis" + std::to_string( i ), std::make_shared<StructDataType>( "Axis", StructDataType::NamedTypes
+        {
+            { "enabled", makeVariant( i % 2 == 0 ) },
+            { "position", makeVector<double>( 40 + i ) }
+        } ) );
+    }
+
+    return StructDataType( "State", StructDataType::NamedTypes
+    {
+        { "cycle", makeVariant( uint64_t(7) ) },
+        { "names", makeVector<std::string>( 100 ) },
+        { "flags", makeVector<bool>( 200 ) },
+        { "counters", makeVector<int16_t>( 1500 ) },
+        { "axes", std::make_shared<StructDataType>( "Axes", axes ) }
+    } );
+}
+
+}// end namespace
+
+TEST( test_sequencer_type_ParallelEncoder, Serialize )
+{
+    const auto state = makeState();
+    DataStream expected( std::make_unique<VectorStream>() );
+    IDataType::serialize( expected, state );
+    const auto bytes = toBuffer( expected );
+
+    ASSERT_EQ( 1u, ParallelEncoder( 1 ).getThreads() );
+    ASSERT_LE( 1u, ParallelEncoder().getThreads() );
+    ASSERT_EQ( ParallelEncoder::DEFAULT_GRAIN_SIZE, ParallelEncoder().getGrainSize() );
+
+    // Small grain sizes split down to single attributes and few elements
+    for ( size_t threads: { 1, 2, 4, 7 } )
+    {
+        for ( size_t grainSize: { 1, 64, 1000, 100000 } )
+        {
+            DataStream stream( std::make_unique<VectorStream>() );
+            ParallelEncoder( threads, grainSize ).serialize( stream, state );
+            ASSERT_EQ( bytes, toBuffer( stream ) );
+        }
+    }
+
+    // Round trip through the parallel decoder
+    DataStream stream( std::make_unique<VectorStream>() );
+    ParallelEncoder( 4, 128 ).serialize( stream, state );
+    const auto buffer = toBuffer( stream );
+    auto decoded = ParallelDecoder( 4, 128 ).deserialize( ParallelDecoder::Data( buffer.data(),
+                                                                                 buffer.size() ) );
+    ASSERT_EQ( state, *decoded );
+}
+
+TEST( test_sequencer_type_ParallelEncoder, SchemaDictionary )
+{
+    const auto state = makeState();
+    DataStream expected( std::make_unique<VectorStream>() );
+    expected.setSchemaDictionary( true );
+    IDataType::serialize( expected, state );
+    IDataType::serialize( expected, state );
+
+    DataStream stream( std::make_unique<VectorStream>() );
+    stream.setSchemaDictionary( true );
+    ParallelEncoder encoder( 4, 64 );
+    encoder.serialize( stream, state );
+    encoder.serialize( stream, state );
+    ASSERT_EQ( toBuffer( expected ), toBuffer( stream ) );
+}
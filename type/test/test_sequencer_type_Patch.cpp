@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <workflow/type/Patch.hpp>
+#include <workflow/type/VariantDataType.hpp>
+#include <workflow/type/VectorDataType.hpp>
+#include <workflow/type/StructDataType.hpp>
+#include <workflow/type/DataStream.hpp>
+
+#include "DataTypeBuilders.h"
+
+using namespace workflow::type;
+
+namespace {
+
+std::shared_ptr<StructDataType>
+makeInput()
+{
+    return std::make_shared<StructDataType>( "Input", StructDataType::NamedTypes
+    {
+        { "value", std::make_shared<VariantDataType>(Variant(1.0)) }
+    } );
+}
+
+}// end namespace
+
+TEST( test_sequencer_type_Patch, CreateAndApply )
+{
+    auto input = makeInput();
+    std::shared_ptr<const IDataType> from = std::make_shared<StructDataType>( "State", StructDataType::NamedTypes
+    {
+        { "step", std::make_shared<VariantDataType>(Variant(int32_t(0))) },
+        { "input", input },
+        { "samples", makeVector<int32_t>( { 1, 2, 3, 4, 5 } ) },
+        { "mode", std::make_shared<VariantDataType>(Variant(std::string("idle"))) },
+        { "output", std::make_shared<StructDataType>( "Output", StructDataType::NamedTypes
+            {
+                { "value", std::make_shared<VariantDataType>(Variant(2.0)) },
+                { "valid", std::make_shared<VariantDataType>(Variant(false)) }
+            }) }
+    } );
+    std::shared_ptr<const IDataType> to = std::make_shared<StructDataType>( "State", StructDataType::NamedTypes
+    {
+        { "step", std::make_shared<VariantDataType>(Variant(int32_t(1))) },
+        { "input", makeInput() },
+        { "samples", makeVector<int32_t>( { 1, 2, 7, 8, 9, 4, 5 } ) },
+        { "mode", std::make_shared<VariantDataType>(Variant(int32_t(3))) },
+        { "output", std::make_shared<StructDataType>( "Output", StructDataType::NamedTypes
+            {
+                { "value", std::make_shared<VariantDataType>(Variant(2.0)) },
+                { "error", std::make_shared<VariantDataType>(Variant(std::string("none"))) }
+            }) }
+    } );
+
+    auto patch = Patch::create( from, to );
+    ASSERT_EQ( 5u, patch.getChanges().size() );
+    ASSERT_TRUE( Patch::create( from, from ).empty() );
+
+    // Changes are ordered by attribute name
+    const auto& splice = patch.getChanges()[3];
+    ASSERT_EQ( Patch::Operation::Splice, splice.operation );
+    ASSERT_EQ( std::vector<std::string>{ "samples" }, splice.path );
+    ASSERT_EQ( 2u, splice.offset );
+    ASSERT_EQ( 1u, splice.removed );
+    ASSERT_EQ( *makeVector<int32_t>( { 7, 8, 9 } ), *splice.value );
+
+    DataStream stream( std::make_unique<VectorStream>() );
+    patch.serialize( stream );
+    auto decoded = Patch::tryDeserialize( stream );
+    ASSERT_TRUE( decoded );
+    ASSERT_EQ( 0u, stream.available() );
+
+    for ( const auto* current: { &patch, &( *decoded ) } )
+    {
+        auto result = current->apply( from );
+        ASSERT_EQ( *to, *result );
+
+        // Unchanged subtrees are shared with the original tree
+        const auto& state = static_cast<const StructDataType&>( *result );
+        ASSERT_EQ( input.get(), &state.get( "input" ) );
+    }
+    ASSERT_NE( *to, *from );
+
+    ASSERT_THROW( patch.apply( to ), workflow::utils::Error );
+}
+
+TEST( test_sequencer_type_Patch, SharedAttribute )
+{
+    auto value = std::make_shared<VariantDataType>( Variant(1.0) );
+    auto create = []( IDataTypeSharedPtr value )
+    {
+        return std::make_shared<StructDataType>( "State", StructDataType::NamedTypes
+        {
+            { "input", std::make_shared<StructDataType>( "Input", StructDataType::NamedTypes
+                {
+                    { "value", value }
+                }) }
+        } );
+    };
+    std::shared_ptr<const IDataType> from = create( value );
+    std::shared_ptr<const IDataType> to = create( std::make_shared<VariantDataType>( Variant(2.0) ) );
+    ASSERT_NE( from->getContentHash(), to->getContentHash() );
+
+    // The cached hash of from is stale after the shared attribute changed
+    value->set( Variant(2.0) );
+    const auto patch = Patch::create( from, to );
+    ASSERT_EQ( *to, *patch.apply( from ) );
+}
+
+TEST( test_sequencer_type_Patch, Malformed )
+{
+    DataStream stream( std::make_unique<VectorStream>() );
+    stream.write( uint64_t(1) );
+    stream.write( uint64_t(2) );
+    stream.write( uint32_t(1) );
+    stream.write( uint32_t(4) );
+    stream.write( uint32_t(0) );
+
+    auto patch = Patch::tryDeserialize( stream );
+    ASSERT_FALSE( patch );
+    ASSERT_EQ( DecodeError::InvalidValue, patch.error() );
+}
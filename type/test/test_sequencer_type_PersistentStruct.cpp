@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <workflow/type/PersistentStruct.hpp>
+#include <workflow/type/VariantDataType.hpp>
+#include <workflow/type/VectorDataType.hpp>
+
+using namespace workflow::type;
+
+namespace {
+
+std::shared_ptr<StructDataType>
+makeState()
+{
+    return std::make_shared<StructDataType>( "State", StructDataType::NamedTypes
+    {
+        { "step", std::make_shared<VariantDataType>(Variant(int32_t(0))) },
+        { "input", std::make_shared<StructDataType>( "Input", StructDataType::NamedTypes
+            {
+                { "value", std::make_shared<VariantDataType>(Variant(1.0)) }
+            }) },
+        { "output", std::make_shared<StructDataType>( "Output", StructDataType::NamedTypes
+            {
+                { "value", std::make_shared<VariantDataType>(Variant(2.0)) },
+                { "valid", std::make_shared<VariantDataType>(Variant(false)) }
+            }) }
+    } );
+}
+
+}// end namespace
+
+TEST( test_sequencer_type_PersistentStruct, Get )
+{
+    PersistentStruct state( makeState() );
+    ASSERT_EQ( *makeState(), state.get() );
+    ASSERT_EQ( Variant(2.0), static_cast<const VariantDataType&>( state.get( "output.value" ) ).get() );
+    ASSERT_EQ( IDataType::Type::Struct, state.get( "input" ).getType() );
+    ASSERT_THROW( state.get( "output.unknown" ), workflow::utils::Error );
+    ASSERT_THROW( state.get( "step.value" ), workflow::utils::Error );
+    ASSERT_THROW( state.get( "output..value" ), workflow::utils::Error );
+}
+
+TEST( test_sequencer_type_PersistentStruct, Snapshot )
+{
+    PersistentStruct state( makeState() );
+    auto snapshot = state.snapshot();
+    ASSERT_EQ( &state.get(), &snapshot.get() );
+
+    state.set( "output.valid", Variant(true) );
+    state.set( "step", Variant(int32_t(1)) );
+
+    // The snapshot is unchanged
+    ASSERT_EQ( *makeState(), snapshot.get() );
+    ASSERT_EQ( Variant(true), static_cast<const VariantDataType&>( state.get( "output.valid" ) ).get() );
+
+    // Only the path to the changed attribute was copied
+    ASSERT_NE( &state.get(), &snapshot.get() );
+    ASSERT_NE( &state.get( "output" ), &snapshot.get( "output" ) );
+    ASSERT_EQ( &state.get( "input" ), &snapshot.get( "input" ) );
+    ASSERT_EQ( &state.get( "output.value" ), &snapshot.get( "output.value" ) );
+
+    // Exclusively owned nodes are changed in place
+    const auto* output = &state.get( "output" );
+    state.set( "output.valid", Variant(false) );
+    ASSERT_EQ( output, &state.get( "output" ) );
+}
+
+TEST( test_sequencer_type_PersistentStruct, SetInvalid )
+{
+    PersistentStruct state( makeState() );
+    ASSERT_THROW( state.set( "step", Variant(1.0) ), workflow::utils::Error );
+    ASSERT_THROW( state.set( "step.value", Variant(int32_t(1)) ), workflow::utils::Error );
+    ASSERT_THROW( state.set( "unknown", Variant(int32_t(1)) ), workflow::utils::Error );
+    ASSERT_THROW( state.set( "step", IDataTypeSharedPtr() ), workflow::utils::Error );
+
+    auto shared = state.share();
+    state.set( "input", std::make_shared<StructDataType>( "Input", StructDataType::NamedTypes
+        {
+            { "value", std::make_shared<VariantDataType>(Variant(3.0)) }
+        }) );
+    ASSERT_EQ( *makeState(), *shared );
+}
+
+TEST( test_sequencer_type_PersistentStruct, ContentHash )
+{
+    PersistentStruct state( makeState() );
+    const auto initial = state.get().getContentHash();
+    const auto input = state.get( "input" ).getContentHash();
+    const auto output = state.get( "output" ).getContentHash();
+    auto snapshot = state.snapshot();
+
+    // The changed path is hashed again, the shared subtrees keep their hashes
+    state.set( "output.valid", Variant(true) );
+    ASSERT_NE( initial, state.get().getContentHash() );
+    ASSERT_NE( output, state.get( "output" ).getContentHash() );
+    ASSERT_EQ( input, state.get( "input" ).getContentHash() );
+    ASSERT_EQ( initial, snapshot.get().getContentHash() );
+
+    state.set( "output.valid", Variant(false) );
+    ASSERT_EQ( initial, state.get().getContentHash() );
+    ASSERT_EQ( snapshot.get(), state.get() );
+}
@@ -245,4 +245,505 @@ TEST( test_sequencer_type_StructDataType, Output )
                "    attr_A=Variant<int>(10)\n"
                "    attr_B=Variant<double>(1)\n"
                ")", ss.str() );
-}
\ No newline at end of file
+}
+
+TEST( test_sequencer_type_StructDataType, TryDeserialize )
+{
+    DataStream stream( std::make_unique<VectorStream>() );
+
+    StructDataType input( "Name",
+    {
+        { "attr_A", std::make_shared<VariantDataType>(Variant(10)) },
+        { "attr_B", std::make_shared<VariantDataType>(Variant(1.0)) }
+    });
+    IDataType::serialize( stream, input );
+
+    auto output = IDataType::tryDeserialize( stream );
+    ASSERT_TRUE( output );
+    ASSERT_EQ( input, **output );
+}
+
+TEST( test_sequencer_type_StructDataType, TryDeserializeMalformed )
+{
+    DataStream stream( std::make_unique<VectorStream>() );
+    stream.write( std::string("Name") );
+    stream.write( uint32_t(2) );
+    stream.write( std::string("attr_A") );
+    IDataType::serialize( stream, VariantDataType(Variant(10)) );
+    stream.write( std::string("attr_A") );
+    IDataType::serialize( stream, VariantDataType(Variant(10)) );
+
+    auto output = StructDataType::tryDeserialize( stream );
+    ASSERT_FALSE( output );
+    ASSERT_EQ( DecodeError::DuplicateAttribute, output.error() );
+
+    auto truncated = StructDataType::tryDeserialize( stream );
+    ASSERT_FALSE( truncated );
+    ASSERT_EQ( DecodeError::EndOfStream, truncated.error() );
+}
+
+TEST( test_sequencer_type_StructDataType, DecodeLimits )
+{
+    StructDataType outer( "Outer",
+    {
+        { "inner", std::make_shared<StructDataType>( "Inner", StructDataType::NamedTypes
+            {
+                { "attr_A", std::make_shared<VariantDataType>(Variant(10)) }
+            }) }
+    });
+
+    DataStream stream( std::make_unique<VectorStream>() );
+    IDataType::serialize( stream, outer );
+    DecodeLimits limits;
+    limits.maxDepth = 2;
+    stream.setLimits( limits );
+
+    auto output = IDataType::tryDeserialize( stream );
+    ASSERT_FALSE( output );
+    ASSERT_EQ( DecodeError::NestingTooDeep, output.error() );
+
+    DataStream tooLong( std::make_unique<VectorStream>() );
+    tooLong.write( std::string("too long") );
+    limits = DecodeLimits();
+    limits.maxStringLength = 4;
+    tooLong.setLimits( limits );
+
+    std::string value;
+    ASSERT_EQ( DecodeError::StringTooLong, tooLong.tryRead( value ) );
+
+    // The claimed length must not be allocated
+    DataStream truncated( std::make_unique<VectorStream>() );
+    truncated.write( std::numeric_limits<uint32_t>::max() );
+    ASSERT_EQ( DecodeError::EndOfStream, truncated.tryRead( value ) );
+    ASSERT_GT( 1024u, value.capacity() );
+
+    // The tag is checked before the value is consumed
+    DataStream mismatch( std::make_unique<VectorStream>() );
+    mismatch.write( uint8_t(7) );
+    uint64_t number = 0;
+    ASSERT_EQ( DecodeError::TypeMismatch, mismatch.tryRead( number ) );
+    ASSERT_EQ( 1u, mismatch.available() );
+    // Lowering the total limit below the bytes read stops reading
+    DataStream lowered( std::make_unique<VectorStream>() );
+    lowered.write( uint64_t(1) );
+    lowered.write( uint64_t(2) );
+    ASSERT_EQ( DecodeError::None, lowered.tryRead( number ) );
+    limits = DecodeLimits();
+    limits.maxTotalBytes = 1;
+    lowered.setLimits( limits );
+    ASSERT_NE( DecodeError::None, lowered.tryRead( number ) );
+    ASSERT_EQ( 1u, number );
+    ASSERT_THROW( lowered.read( number ), workflow::utils::Error );
+}
+
+TEST( test_sequencer_type_StructDataType, Schema )
+{
+    StructDataType first( "Name",
+    {
+        { "attr_B", std::make_shared<VariantDataType>(Variant(1.0)) },
+        { "attr_A", std::make_shared<VariantDataType>(Variant(10)) }
+    });
+    StructDataType second( "Name",
+    {
+        { "attr_A", std::make_shared<VariantDataType>(Variant(20)) },
+        { "attr_B", std::make_shared<VariantDataType>(Variant(2.0)) }
+    });
+
+    // Instances of the same layout share the schema, attributes are ordered by name
+    const auto& schema = first.getSchema();
+    ASSERT_EQ( schema, second.getSchema() );
+    ASSERT_EQ( 2u, schema->size() );
+    ASSERT_EQ( 0u, schema->find( "attr_A" ) );
+    ASSERT_EQ( 1u, schema->find( "attr_B" ) );
+    ASSERT_EQ( StructSchema::npos, schema->find( "attr_C" ) );
+    ASSERT_EQ( VariantDataType(Variant(10)), first.get( size_t(0) ) );
+
+    DataStream stream( std::make_unique<VectorStream>() );
+    first.serialize( stream );
+    ASSERT_EQ( schema, StructDataType( stream ).getSchema() );
+
+    StructDataType fromSchema( schema, {
+        std::make_shared<VariantDataType>(Variant(10)),
+        std::make_shared<VariantDataType>(Variant(1.0))
+    });
+    ASSERT_EQ( first, fromSchema );
+
+    ASSERT_THROW( StructDataType( schema, { std::make_shared<VariantDataType>(Variant(10)) } ),
+                  workflow::utils::Error );
+    ASSERT_THROW( StructDataType( schema, {
+                      std::make_shared<VariantDataType>(Variant(10)),
+                      std::make_shared<VectorDataType>(Variant(1.0))
+                  }), workflow::utils::Error );
+    ASSERT_THROW( first.get( size_t(2) ), workflow::utils::Error );
+}
+
+TEST( test_sequencer_type_StructDataType, DeserializeUnordered )
+{
+    DataStream stream( std::make_unique<VectorStream>() );
+    stream.write( std::string("Name") );
+    stream.write( uint32_t(2) );
+    stream.write( std::string("attr_B") );
+    IDataType::serialize( stream, VariantDataType(Variant(1.0)) );
+    stream.write( std::string("attr_A") );
+    IDataType::serialize( stream, VariantDataType(Variant(10)) );
+
+    StructDataType output( stream );
+    ASSERT_EQ( (std::vector<std::string>{ "attr_A", "attr_B" }), output.getAttributes() );
+    ASSERT_EQ( VariantDataType(Variant(10)), output.get( "attr_A" ) );
+    ASSERT_EQ( VariantDataType(Variant(1.0)), output.get( "attr_B" ) );
+}
+
+TEST( test_sequencer_type_StructDataType, Handle )
+{
+    StructDataType first( "Name",
+    {
+        { "attr_A", std::make_shared<VariantDataType>(Variant(10)) },
+        { "attr_B", std::make_shared<VariantDataType>(Variant(1.0)) }
+    });
+    StructDataType second( "Name",
+    {
+        { "attr_A", std::make_shared<VariantDataType>(Variant(20)) },
+        { "attr_B", std::make_shared<VariantDataType>(Variant(2.0)) }
+    });
+    StructDataType other( "Other",
+    {
+        { "attr_B", std::make_shared<VariantDataType>(Variant(3.0)) }
+    });
+
+    auto handle = StructDataType::resolve( first.getSchema(), "attr_B" );
+    ASSERT_TRUE( handle );
+    ASSERT_EQ( 1u, handle.getIndex() );
+    ASSERT_FALSE( first.resolve( "attr_C" ) );
+    ASSERT_FALSE( StructDataType::Handle() );
+
+    // Valid for all instances of the same layout
+    ASSERT_TRUE( second.matches( handle ) );
+    ASSERT_EQ( VariantDataType(Variant(1.0)), first.get( handle ) );
+    ASSERT_EQ( VariantDataType(Variant(2.0)), second.getUnchecked( handle ) );
+
+    ASSERT_FALSE( other.matches( handle ) );
+    ASSERT_THROW( other.get( handle ), workflow::utils::Error );
+    ASSERT_THROW( first.get( first.resolve( "attr_C" ) ), workflow::utils::Error );
+}
+
+TEST( test_sequencer_type_StructDataType, InternedNames )
+{
+    StructDataType input( "Name",
+    {
+        { "attr_A", std::make_shared<VariantDataType>(Variant(10)) },
+        { "attr_B", std::make_shared<VariantDataType>(Variant(1.0)) }
+    });
+
+    DataStream stream( std::make_unique<VectorStream>() );
+    input.serialize( stream );
+    input.serialize( stream );
+    StructDataType first( stream );
+    StructDataType second( stream );
+
+    // Decoded names refer to the same interned strings
+    ASSERT_EQ( workflow::utils::InternedString( "Name" ), first.getInternedName() );
+    ASSERT_EQ( &first.getInternedName().str(), &second.getInternedName().str() );
+    ASSERT_EQ( &first.getAttributeNames(), &second.getAttributeNames() );
+    ASSERT_EQ( 2u, first.getAttributeNames().size() );
+    ASSERT_EQ( "attr_B", first.getAttributeNames()[1].str() );
+    ASSERT_EQ( workflow::utils::InternedString(), workflow::utils::InternedString( "" ) );
+}
+
+TEST( test_sequencer_type_StructDataType, DecodedNamesReleased )
+{
+    // Names of structs no longer used do not accumulate in the intern table
+    DataStream stream( std::make_unique<VectorStream>() );
+    for ( size_t i = 0; i < 20000; ++i )
+    {
+        const auto name = std::to_string( i );
+        StructDataType( "Name" + name,
+        {
+            { "attr_" + name, std::make_shared<VariantDataType>(Variant(1.0)) }
+        }).serialize( stream );
+        StructDataType decoded( stream );
+        ASSERT_EQ( "Name" + name, decoded.getName() );
+    }
+    ASSERT_LT( workflow::utils::InternedString::getTableSize(), 4096u );
+}
+
+TEST( test_sequencer_type_StructDataType, DeserializeKnownSchema )
+{
+    auto vector = std::make_shared<VectorDataType>( Variant(1.0) );
+    vector->push_back( 2.0 );
+    StructDataType input( "Outer",
+    {
+        { "attr_A", std::make_shared<VariantDataType>(Variant(10)) },
+        { "inner", std::make_shared<StructDataType>( "Inner", StructDataType::NamedTypes
+            {
+                { "attr_B", std::make_shared<VariantDataType>(Variant(std::string("b"))) }
+            }) },
+        { "vector", vector }
+    });
+
+    DataStream stream( std::make_unique<VectorStream>() );
+    input.serialize( stream );
+    input.serialize( stream );
+
+    auto output = StructDataType::tryDeserialize( stream, input.getSchema() );
+    ASSERT_TRUE( output );
+    ASSERT_EQ( input, **output );
+    ASSERT_EQ( input.getSchema(), (*output)->getSchema() );
+
+    // Same layout but different variant type
+    StructDataType other( "Outer",
+    {
+        { "attr_A", std::make_shared<VariantDataType>(Variant(10.0)) },
+        { "inner", std::make_shared<StructDataType>( "Inner", StructDataType::NamedTypes
+            {
+                { "attr_B", std::make_shared<VariantDataType>(Variant(std::string("b"))) }
+            }) },
+        { "vector", vector }
+    });
+    ASSERT_NE( input.getSchema(), other.getSchema() );
+
+    auto mismatch = StructDataType::tryDeserialize( stream, other.getSchema() );
+    ASSERT_FALSE( mismatch );
+    ASSERT_EQ( DecodeError::TypeMismatch, mismatch.error() );
+}
+
+TEST( test_sequencer_type_StructDataType, SchemaDictionary )
+{
+    auto makeRecord = []( int32_t id )
+    {
+        return StructDataType( "Record",
+        {
+            { "identifier", std::make_shared<VariantDataType>(Variant(id)) },
+            { "position", std::make_shared<StructDataType>( "Position", StructDataType::NamedTypes
+                {
+                    { "x", std::make_shared<VariantDataType>(Variant(1.0 * id)) },
+                    { "y", std::make_shared<VariantDataType>(Variant(2.0 * id)) }
+                }) }
+        });
+    };
+
+    constexpr int32_t COUNT = 100;
+    DataStream plain( std::make_unique<VectorStream>() );
+    DataStream compact( std::make_unique<VectorStream>() );
+    compact.setSchemaDictionary( true );
+    ASSERT_TRUE( compact.hasSchemaDictionary() );
+    for ( int32_t i = 0; i < COUNT; ++i )
+    {
+        IDataType::serialize( plain, makeRecord( i ) );
+        IDataType::serialize( compact, makeRecord( i ) );
+    }
+    ASSERT_LT( 3 * compact.available(), plain.available() );
+
+    for ( int32_t i = 0; i < COUNT; ++i )
+    {
+        auto record = IDataType::tryDeserialize( compact );
+        ASSERT_TRUE( record );
+        ASSERT_EQ( makeRecord( i ), **record );
+    }
+    ASSERT_EQ( 0u, compact.available() );
+
+    // Known schema, the id must match
+    auto expected = makeRecord( 7 );
+    expected.serialize( compact );
+    auto known = StructDataType::tryDeserialize( compact, expected.getSchema() );
+    ASSERT_TRUE( known );
+    ASSERT_EQ( expected, **known );
+
+    expected.serialize( compact );
+    auto other = StructDataType::tryDeserialize( compact,
+        static_cast<const StructDataType&>( expected.get( "position" ) ).getSchema() );
+    ASSERT_FALSE( other );
+    ASSERT_EQ( DecodeError::TypeMismatch, other.error() );
+
+    // Reference to a schema that was never defined
+    DataStream invalid( std::make_unique<VectorStream>() );
+    invalid.setSchemaDictionary( true );
+    invalid.write( static_cast<uint32_t>( IDataType::Type::Struct ) );
+    invalid.write( uint32_t(5) );
+    auto undefined = IDataType::tryDeserialize( invalid );
+    ASSERT_FALSE( undefined );
+    ASSERT_EQ( DecodeError::InvalidValue, undefined.error() );
+}
+
+TEST( test_sequencer_type_StructDataType, DeserializeProjection )
+{
+    auto vector = std::make_shared<VectorDataType>( Variant(std::string()) );
+    vector->push_back( std::string("skipped") );
+    StructDataType input( "Record",
+    {
+        { "id", std::make_shared<VariantDataType>(Variant(int64_t(42))) },
+        { "label", std::make_shared<VariantDataType>(Variant(std::string("label"))) },
+        { "tags", vector },
+        { "position", std::make_shared<StructDataType>( "Position", StructDataType::NamedTypes
+            {
+                { "x", std::make_shared<VariantDataType>(Variant(1.0)) },
+                { "y", std::make_shared<VariantDataType>(Variant(2.0)) }
+            }) }
+    });
+    StructDataType expected( "Record",
+    {
+        { "id", std::make_shared<VariantDataType>(Variant(int64_t(42))) },
+        { "position", std::make_shared<StructDataType>( "Position", StructDataType::NamedTypes
+            {
+                { "y", std::make_shared<VariantDataType>(Variant(2.0)) }
+            }) }
+    });
+
+    Projection projection{ "id", "position.y", "label.length", "unknown" };
+    ASSERT_THROW( Projection{ "position..y" }, workflow::utils::Error );
+
+    for ( bool dictionary: { false, true } )
+    {
+        DataStream stream( std::make_unique<VectorStream>() );
+        stream.setSchemaDictionary( dictionary );
+        input.serialize( stream );
+        input.serialize( stream );
+        stream.write( uint32_t(7) );
+
+        for ( int i = 0; i < 2; ++i )
+        {
+            auto output = StructDataType::tryDeserialize( stream, projection );
+            ASSERT_TRUE( output );
+            ASSERT_EQ( expected, **output );
+        }
+
+        // The skipped bytes are consumed exactly
+        uint32_t trailer = 0;
+        stream.read( trailer );
+        ASSERT_EQ( 7u, trailer );
+    }
+}
+
+TEST( test_sequencer_type_StructDataType, ContentHash )
+{
+    auto create = []( double y )
+    {
+        return std::make_unique<StructDataType>( "Record", StructDataType::NamedTypes
+        {
+            { "id", std::make_shared<VariantDataType>(Variant(int64_t(42))) },
+            { "tags", std::make_shared<VectorDataType>(Variant(std::string())) },
+            { "position", std::make_shared<StructDataType>( "Position", StructDataType::NamedTypes
+                {
+                    { "x", std::make_shared<VariantDataType>(Variant(1.0)) },
+                    { "y", std::make_shared<VariantDataType>(Variant(y)) }
+                }) }
+        });
+    };
+    auto lhs = create( 2.0 );
+    auto rhs = create( 2.0 );
+    auto other = create( 3.0 );
+
+    ASSERT_EQ( lhs->getContentHash(), rhs->getContentHash() );
+    ASSERT_NE( lhs->getContentHash(), other->getContentHash() );
+    ASSERT_NE( *lhs, *other );
+
+    // Mutable access discards the cached hash up to the modified attribute
+    auto& position = static_cast<StructDataType&>( rhs->get( "position" ) );
+    static_cast<VariantDataType&>( position.get( "y" ) ).set( Variant(3.0) );
+    ASSERT_EQ( other->getContentHash(), rhs->getContentHash() );
+    ASSERT_EQ( *other, *rhs );
+
+    static_cast<VectorDataType&>( rhs->get( "tags" ) ).push_back( Variant(std::string("a")) );
+    ASSERT_NE( other->getContentHash(), rhs->getContentHash() );
+    ASSERT_NE( *other, *rhs );
+}
+
+TEST( test_sequencer_type_StructDataType, ContentHashSignedZero )
+{
+    // 0.0 and -0.0 compare equal, so they must hash equally
+    const VariantDataType positive( Variant(0.0) );
+    const VariantDataType negative( Variant(-0.0) );
+    ASSERT_EQ( positive, negative );
+    ASSERT_EQ( positive.getContentHash(), negative.getContentHash() );
+    ASSERT_EQ( VariantDataType( Variant(0.0f) ).getContentHash(), VariantDataType( Variant(-0.0f) ).getContentHash() );
+
+    // Longer than a chunk of the vector hash
+    VectorDataType positives( Variant(0.0) );
+    VectorDataType negatives( Variant(0.0) );
+    for ( size_t i = 0; i < 300; ++i )
+    {
+        positives.push_back( 1.0 * i );
+        negatives.push_back( i ? 1.0 * i : -0.0 );
+    }
+    ASSERT_EQ( positives, negatives );
+    ASSERT_EQ( positives.getContentHash(), negatives.getContentHash() );
+
+    auto create = []( double value )
+    {
+        auto values = std::make_shared<VectorDataType>( Variant(0.0f) );
+        values->push_back( static_cast<float>( value ) );
+        return StructDataType( "Zero", StructDataType::NamedTypes
+        {
+            { "value", std::make_shared<VariantDataType>(Variant(value)) },
+            { "values", values }
+        });
+    };
+    const auto lhs = create( 0.0 );
+    const auto rhs = create( -0.0 );
+    ASSERT_EQ( lhs, rhs );
+    ASSERT_EQ( lhs.getContentHash(), rhs.getContentHash() );
+    ASSERT_NE( lhs.getContentHash(), create( 1.0 ).getContentHash() );
+}
+
+TEST( test_sequencer_type_StructDataType, SharedAttribute )
+{
+    // Changing a shared attribute is noticed by the cached hashes of its structs
+    auto shared = std::make_shared<VariantDataType>( Variant(1.0) );
+    auto create = []( IDataTypeSharedPtr value )
+    {
+        return StructDataType( "Outer", StructDataType::NamedTypes
+        {
+            { "inner", std::make_shared<StructDataType>( "Inner", StructDataType::NamedTypes
+                {
+                    { "value", value }
+                }) }
+        });
+    };
+    const auto lhs = create( shared );
+    const auto rhs = create( std::make_shared<VariantDataType>( Variant(2.0) ) );
+    ASSERT_NE( lhs.getContentHash(), rhs.getContentHash() );
+    ASSERT_NE( lhs.get( "inner" ).getContentHash(), rhs.get( "inner" ).getContentHash() );
+
+    shared->set( Variant(2.0) );
+    ASSERT_EQ( lhs, rhs );
+    ASSERT_EQ( lhs.get( "inner" ), rhs.get( "inner" ) );
+    ASSERT_EQ( lhs.getContentHash(), rhs.getContentHash() );
+    ASSERT_EQ( lhs.get( "inner" ).getContentHash(), rhs.get( "inner" ).getContentHash() );
+}
+
+TEST( test_sequencer_type_StructDataType, SharedChild )
+{
+    // A struct shared by two parents is changed through one of them
+    auto create = []
+    {
+        return std::make_shared<StructDataType>( "Inner", StructDataType::NamedTypes
+        {
+            { "value", std::make_shared<VariantDataType>( Variant(1.0) ) },
+            { "values", std::make_shared<VectorDataType>( Variant(0.0) ) }
+        });
+    };
+    auto inner = create();
+    StructDataType lhs( "Outer", StructDataType::NamedTypes{ { "inner", inner } } );
+    StructDataType rhs( "Outer", StructDataType::NamedTypes{ { "inner", inner } } );
+    const StructDataType copy( "Outer", StructDataType::NamedTypes{ { "inner", create() } } );
+    ASSERT_EQ( lhs.getContentHash(), copy.getContentHash() );
+    ASSERT_EQ( rhs.getContentHash(), copy.getContentHash() );
+
+    auto& shared = static_cast<StructDataType&>( lhs.get( "inner" ) );
+    static_cast<VariantDataType&>( shared.get( "value" ) ).set( Variant(2.0) );
+    ASSERT_NE( rhs, copy );
+    ASSERT_NE( rhs.getContentHash(), copy.getContentHash() );
+    ASSERT_EQ( lhs.getContentHash(), rhs.getContentHash() );
+
+    // Through references retained from before the hashes were computed
+    auto& value = static_cast<StructDataType&>( rhs.get( "inner" ) ).get( "value" );
+    auto& values = static_cast<VectorDataType&>( inner->get( "values" ) );
+    const auto hash = lhs.getContentHash();
+    static_cast<VariantDataType&>( value ).set( Variant(1.0) );
+    ASSERT_EQ( lhs, copy );
+    ASSERT_EQ( lhs.getContentHash(), copy.getContentHash() );
+    values.push_back( 1.0 );
+    ASSERT_NE( lhs, copy );
+    ASSERT_NE( lhs.getContentHash(), copy.getContentHash() );
+    ASSERT_NE( lhs.getContentHash(), hash );
+    ASSERT_EQ( lhs.getContentHash(), rhs.getContentHash() );
+}
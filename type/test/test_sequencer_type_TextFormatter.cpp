@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <workflow/type/TextFormatter.hpp>
+#include <workflow/type/VariantDataType.hpp>
+#include <workflow/type/VectorDataType.hpp>
+#include <workflow/type/StructDataType.hpp>
+
+#include "DataTypeBuilders.h"
+
+using namespace workflow::type;
+
+namespace {
+
+StructDataType
+makeRecord()
+{
+    return StructDataType( "Record", StructDataType::NamedTypes
+    {
+        { "label", makeVariant( std::string("a\"b\n") ) },
+        { "value", makeVariant( 0.1 ) },
+        { "numbers", makeVector<int32_t>( { 1, -2 } ) },
+        { "empty", makeVector<std::string>( {} ) },
+        { "nested", std::make_shared<StructDataType>( "Nested", StructDataType::NamedTypes
+            {
+                { "flag", makeVariant( true ) },
+                { "small", makeVariant( uint8_t(200) ) }
+            }) }
+    } );
+}
+
+}// end namespace
+
+TEST( test_sequencer_type_TextFormatter, Compact )
+{
+    TextFormatter formatter;
+    ASSERT_EQ( TextFormatter::Style::Compact, formatter.getStyle() );
+    ASSERT_EQ( "Record{empty=[],label=\"a\\\"b\\n\",nested=Nested{flag=true,small=200},"
+               "numbers=[1,-2],value=0.1}", formatter.format( makeRecord() ) );
+
+    ASSERT_EQ( "1.5", formatter.format( Variant(1.5f) ) );
+    ASSERT_EQ( "-9223372036854775808", formatter.format( Variant(std::numeric_limits<int64_t>::min()) ) );
+    ASSERT_EQ( "\"\\x01\"", formatter.format( Variant(std::string("\x01")) ) );
+    ASSERT_EQ( "void", formatter.format( Variant() ) );
+
+    formatter.clear();
+    formatter.append( Variant(int16_t(3)) );
+    formatter.append( Variant(false) );
+    ASSERT_EQ( "3false", formatter.view() );
+
+    // Nesting does not recurse
+    auto chain = std::make_shared<StructDataType>( "Leaf", StructDataType::NamedTypes
+    {
+        { "v", std::make_shared<VariantDataType>(Variant(int32_t(1))) }
+    } );
+    for ( size_t i = 0; i < 10000; ++i )
+    {
+        chain = std::make_shared<StructDataType>( "Node" + std::to_string( i ),
+                                                  StructDataType::NamedTypes{ { "next", chain } } );
+    }
+    const auto text = formatter.format( *chain );
+    ASSERT_EQ( "Node9999{next=Node9998{next=", text.substr( 0, 28 ) );
+    ASSERT_EQ( "Leaf{v=1}", text.substr( text.size() - 10000 - 9, 9 ) );
+}
+
+TEST( test_sequencer_type_TextFormatter, Pretty )
+{
+    TextFormatter formatter( TextFormatter::Style::Pretty );
+    ASSERT_EQ( "Record{\n"
+               "    empty=[],\n"
+               "    label=\"a\\\"b\\n\",\n"
+               "    nested=Nested{\n"
+               "        flag=true,\n"
+               "        small=200\n"
+               "    },\n"
+               "    numbers=[1, -2],\n"
+               "    value=0.1\n"
+               "}", formatter.format( makeRecord() ) );
+
+    auto names = std::make_shared<VectorDataType>( Variant(std::string()) );
+    names->push_back( std::string( "x" ) );
+    names->push_back( std::string( "y" ) );
+    const StructDataType single( "Single", StructDataType::NamedTypes{ { "names", names } } );
+    ASSERT_EQ( "Single{\n    names=[\"x\", \"y\"]\n}", formatter.format( single ) );
+}
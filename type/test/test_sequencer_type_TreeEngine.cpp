@@ -0,0 +1,241 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include <workflow/type/TreeEngine.hpp>
+#include <workflow/type/IVariantMethods.hpp>
+#include <workflow/type/VariantMethodsManager.hpp>
+#include <workflow/type/VariantDataType.hpp>
+#include <workflow/type/VectorDataType.hpp>
+#include <workflow/type/StructDataType.hpp>
+#include <workflow/type/DataStream.hpp>
+
+#include "VectorDataStream.h"
+
+using namespace workflow::type;
+
+namespace {
+
+/**
+ * Create a chain of structs, each holding a value and the next struct. The
+ * levels share their name, their layouts differ by the schema of the next.
+ */
+std::shared_ptr<StructDataType>
+makeChain( size_t depth,
+           double leaf )
+{
+    auto ret = std::make_shared<StructDataType>( "Node", StructDataType::NamedTypes
+    {
+        { "value", std::make_shared<VariantDataType>(Variant(leaf)) }
+    } );
+    for ( size_t i = 1; i < depth; ++i )
+    {
+        ret = std::make_shared<StructDataType>( "Node", StructDataType::NamedTypes
+        {
+            { "next", ret },
+            { "value", std::make_shared<VariantDataType>(Variant(double(i))) }
+        } );
+    }
+    return ret;
+}
+
+/**
+ * Variant holding a data type, decoding it with the engine of the thread
+ */
+struct Boxed
+{
+    IDataTypeSharedPtr value;
+
+    friend bool
+    operator==( const Boxed& lhs,
+                const Boxed& rhs )
+    {
+        return lhs.value == rhs.value || ( lhs.value && rhs.value && *lhs.value == *rhs.value );
+    }
+};
+
+class BoxedMethods : public IVariantMethods
+{
+public:
+    virtual std::string
+    getName() const override
+    {
+        return "Boxed";
+    }
+
+    virtual Variant
+    create() const override
+    {
+        return Variant(Boxed());
+    }
+
+    virtual std::string
+    toString( const Variant& ) const override
+    {
+        return "Boxed";
+    }
+
+    virtual Variant
+    fromString( const std::string& ) const override
+    {
+        return create();
+    }
+
+    virtual void
+    serialize( DataStream& stream,
+               const Variant& value ) const override
+    {
+        IDataType::serialize( stream, *value.get<Boxed>().value );
+    }
+
+    virtual void
+    deserialize( DataStream& stream,
+                 Variant& value ) const override
+    {
+        value = Variant( Boxed{ IDataType::deserialize( stream ) } );
+    }
+
+    virtual DecodeError
+    tryDeserialize( DataStream& stream,
+                    Variant& value ) const override
+    {
+        auto result = IDataType::tryDeserialize( stream );
+        if ( !result )
+        {
+            return result.error();
+        }
+        value = Variant( Boxed{ std::move(result).value() } );
+        return DecodeError::None;
+    }
+};
+
+}// end namespace
+
+TEST( test_sequencer_type_TreeEngine, DeepNesting )
+{
+    constexpr size_t DEPTH = 10000;
+    auto chain = makeChain( DEPTH, 0.0 );
+
+    for ( bool dictionary: { false, true } )
+    {
+        DataStream stream( std::make_unique<VectorStream>() );
+        stream.setSchemaDictionary( dictionary );
+        IDataType::serialize( stream, *chain );
+
+        auto result = IDataType::tryDeserialize( stream );
+        ASSERT_TRUE( result );
+        ASSERT_EQ( *chain, **result );
+        ASSERT_EQ( 0u, stream.available() );
+    }
+
+    ASSERT_NE( *chain, *makeChain( DEPTH, 1.0 ) );
+
+    std::stringstream ss;
+    ss << *chain;
+    const auto output = ss.str();
+    size_t count = 0;
+    for ( auto pos = output.find( "Struct[" ); std::string::npos != pos; pos = output.find( "Struct[", pos + 1 ) )
+    {
+        ++count;
+    }
+    ASSERT_EQ( DEPTH, count );
+}
+
+TEST( test_sequencer_type_TreeEngine, DepthLimit )
+{
+    auto chain = makeChain( 10, 0.0 );
+    TreeEngine engine( 10, 4 );
+    TreeEngine shallow( 9 );
+    ASSERT_EQ( 10u, engine.getMaxDepth() );
+
+    // The engine writes the same bytes as the data types
+    DataStream expected( std::make_unique<VectorStream>() );
+    IDataType::serialize( expected, *chain );
+    DataStream stream( std::make_unique<VectorStream>() );
+    engine.serialize( stream, *chain );
+    ASSERT_EQ( expected.available(), stream.available() );
+    ASSERT_THROW( shallow.serialize( stream, *chain ), workflow::utils::Error );
+
+    auto result = engine.tryDeserialize( stream );
+    ASSERT_TRUE( result );
+    ASSERT_TRUE( engine.equals( *chain, **result ) );
+    ASSERT_THROW( shallow.equals( *chain, **result ), workflow::utils::Error );
+
+    std::stringstream lhs;
+    std::stringstream rhs;
+    engine.output( lhs, *chain );
+    rhs << *chain;
+    ASSERT_EQ( rhs.str(), lhs.str() );
+
+    IDataType::serialize( stream, *chain );
+    result = shallow.tryDeserialize( stream );
+    ASSERT_FALSE( result );
+    ASSERT_EQ( DecodeError::NestingTooDeep, result.error() );
+
+    // The nesting levels of the stream are balanced after a failure
+    DecodeLimits limits;
+    limits.maxDepth = 20;
+    stream.setLimits( limits );
+    IDataType::serialize( stream, *chain );
+    ASSERT_TRUE( engine.tryDeserialize( stream ) );
+}
+
+TEST( test_sequencer_type_TreeEngine, NestedCalls )
+{
+    auto& manager = VariantMethodsManager::instance();
+    manager.insert( std::make_unique<BoxedMethods>() );
+
+    // The boxed chain needs more frames than preallocated by the decoding call
+    const StructDataType outer( "Outer", StructDataType::NamedTypes
+    {
+        { "boxed", std::make_shared<VariantDataType>(Variant(Boxed{ makeChain( 4 * TreeEngine::DEFAULT_RESERVE, 0.0 ) })) },
+        { "value", std::make_shared<VariantDataType>(Variant(1.0)) }
+    } );
+    for ( bool dictionary: { false, true } )
+    {
+        DataStream stream( std::make_unique<VectorStream>() );
+        stream.setSchemaDictionary( dictionary );
+        IDataType::serialize( stream, outer );
+
+        auto result = IDataType::tryDeserialize( stream );
+        ASSERT_TRUE( result );
+        ASSERT_EQ( outer, **result );
+        ASSERT_EQ( 0u, stream.available() );
+    }
+    manager.remove<Boxed>();
+}
+
+TEST( test_sequencer_type_TreeEngine, ReinsertedMethods )
+{
+    auto& manager = VariantMethodsManager::instance();
+    manager.insert( std::make_unique<BoxedMethods>() );
+
+    const StructDataType outer( "Reloaded", StructDataType::NamedTypes
+    {
+        { "boxed", std::make_shared<VariantDataType>(Variant(Boxed{ makeChain( 2, 0.0 ) })) }
+    } );
+    DataStream first( std::make_unique<VectorStream>() );
+    IDataType::serialize( first, outer );
+
+    // The plan of the schema outlives the methods it was built with
+    manager.remove<Boxed>();
+    manager.insert( std::make_unique<BoxedMethods>() );
+    for ( bool dictionary: { false, true } )
+    {
+        DataStream stream( std::make_unique<VectorStream>() );
+        stream.setSchemaDictionary( dictionary );
+        IDataType::serialize( stream, outer );
+        IDataType::serialize( stream, outer );
+
+        auto result = IDataType::tryDeserialize( stream );
+        ASSERT_TRUE( result );
+        ASSERT_EQ( outer, **result );
+
+        manager.remove<Boxed>();
+        result = IDataType::tryDeserialize( stream );
+        ASSERT_FALSE( result );
+        ASSERT_EQ( DecodeError::UnknownVariantType, result.error() );
+        manager.insert( std::make_unique<BoxedMethods>() );
+    }
+    manager.remove<Boxed>();
+}
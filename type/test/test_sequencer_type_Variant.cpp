@@ -138,6 +138,8 @@ TEST( test_sequencer_type_Variant, GetTypeName )
 
     ASSERT_EQ( "void", variantA.getTypeName() );
     ASSERT_EQ( "int", variantB.getTypeName() );
+    ASSERT_EQ( "int", variantB.getCachedTypeName() );
+    ASSERT_EQ( &variantB.getCachedTypeName(), &workflow::type::Variant( 2 ).getCachedTypeName() );
 }
 
 TEST( test_sequencer_type_Variant, OutputEmpty )
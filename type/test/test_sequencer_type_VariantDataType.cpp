@@ -57,6 +57,17 @@ TEST( test_sequencer_type_VariantDataType, Construct )
                variant.getName() );
 }
 
+TEST( test_sequencer_type_VariantDataType, Get )
+{
+    VariantDataType variant( (Variant(10)) );
+    ASSERT_EQ( Variant(10), variant.get() );
+    ASSERT_EQ( Variant(10), variant.getRef() );
+    ASSERT_EQ( &variant.getRef(), &variant.getRef() );
+
+    variant.set( Variant(20) );
+    ASSERT_EQ( Variant(20), variant.getRef() );
+}
+
 TEST( test_sequencer_type_VariantDataType, Visitor )
 {
     VisitorMock visitor;
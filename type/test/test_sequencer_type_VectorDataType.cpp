@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <workflow/type/VariantDataType.hpp>
+#include <workflow/type/VectorDataType.hpp>
+#include <workflow/type/StructDataType.hpp>
+#include <workflow/type/IDataTypeVisitor.hpp>
+#include <workflow/type/DataStream.hpp>
+#include <workflow/type/VariantMethodsManager.hpp>
+
+#include "VectorDataStream.h"
+
+using namespace workflow::type;
+
+namespace {
+
+template<typename T>
+void
+writeVector( DataStream& stream,
+             const std::vector<T>& values )
+{
+    const auto& manager = VariantMethodsManager::instance();
+    stream.write( manager.calculateHash<T>().value );
+    stream.write( static_cast<uint32_t>(values.size()) );
+    for ( const auto& value: values )
+    {
+        stream.write( value );
+    }
+}
+
+}// end namespace
+
+TEST( test_sequencer_type_VectorDataType, Construct )
+{
+    VectorDataType vector( (Variant(1.0)) );
+
+    ASSERT_EQ( VectorDataType::Type::Vector, vector.getType() );
+    ASSERT_EQ( "Vector<double>", vector.getName() );
+    ASSERT_EQ( std::type_index(typeid(double)), vector.getElementType() );
+    ASSERT_EQ( 0u, vector.size() );
+}
+
+TEST( test_sequencer_type_VectorDataType, Span )
+{
+    DataStream stream( std::make_unique<VectorStream>() );
+    writeVector<double>( stream, { 1.0, 2.5, -3.0 } );
+
+    VectorDataType vector( stream );
+    auto span = vector.getSpan<double>();
+    ASSERT_EQ( 3u, span.size() );
+    ASSERT_EQ( (std::vector<double>{ 1.0, 2.5, -3.0 }),
+               std::vector<double>( span.begin(), span.end() ) );
+
+    ASSERT_THROW( vector.getSpan<float>(), workflow::utils::Error );
+}
+
+TEST( test_sequencer_type_VectorDataType, Streaming )
+{
+    DataStream stream( std::make_unique<VectorStream>() );
+    writeVector<int32_t>( stream, { 1, 2, 3 } );
+    writeVector<std::string>( stream, { "a", "b" } );
+
+    VectorDataType ints( stream );
+    VectorDataType strings( stream );
+
+    DataStream output( std::make_unique<VectorStream>() );
+    ints.serialize( output );
+    strings.serialize( output );
+
+    ASSERT_EQ( ints, VectorDataType( output ) );
+    ASSERT_EQ( strings, VectorDataType( output ) );
+    ASSERT_NE( ints, strings );
+}
+
+TEST( test_sequencer_type_VectorDataType, Output )
+{
+    DataStream stream( std::make_unique<VectorStream>() );
+    writeVector<int32_t>( stream, { 1, 2 } );
+
+    VectorDataType vector( stream );
+    std::stringstream ss;
+    ss << vector;
+
+    ASSERT_EQ( "Vector[2](<int>(1), <int>(2))", ss.str() );
+}
+
+TEST( test_sequencer_type_VectorDataType, ElementAccess )
+{
+    VectorDataType vector( (Variant(int32_t(0))) );
+    vector.reserve( 4 );
+    vector.push_back( int32_t(1) );
+    vector.push_back( Variant(int32_t(2)) );
+    vector.emplace_back<int32_t>( 3 );
+
+    ASSERT_FALSE( vector.empty() );
+    ASSERT_EQ( 3u, vector.size() );
+    ASSERT_EQ( Variant(int32_t(2)), vector[1] );
+    ASSERT_EQ( 3, vector.get<int32_t>( 2 ) );
+
+    vector.set( 0, int32_t(10) );
+    vector.set( 1, Variant(int32_t(20)) );
+    ASSERT_EQ( (std::vector<int32_t>{ 10, 20, 3 }),
+               std::vector<int32_t>( vector.begin<int32_t>(), vector.end<int32_t>() ) );
+
+    std::vector<Variant> boxed( vector.begin(), vector.end() );
+    ASSERT_EQ( 3u, boxed.size() );
+    ASSERT_EQ( Variant(int32_t(10)), boxed[0] );
+
+    // The element type is fixed on construction
+    ASSERT_THROW( vector.push_back( 1.0 ), workflow::utils::Error );
+    ASSERT_THROW( vector.push_back( Variant(int64_t(1)) ), workflow::utils::Error );
+    ASSERT_THROW( vector.set( 0, Variant(std::string("a")) ), workflow::utils::Error );
+    ASSERT_THROW( vector.begin<int64_t>(), workflow::utils::Error );
+    ASSERT_THROW( vector.at( 3 ), workflow::utils::Error );
+
+    vector.clear();
+    ASSERT_TRUE( vector.empty() );
+}
+
+TEST( test_sequencer_type_VectorDataType, Equality )
+{
+    // Empty vectors of different element types differ
+    ASSERT_NE( VectorDataType( (Variant(1.0)) ), VectorDataType( (Variant(1.0f)) ) );
+    ASSERT_EQ( VectorDataType( (Variant(1.0)) ), VectorDataType( (Variant(2.0)) ) );
+
+    VectorDataType lhs( (Variant(1.0)) );
+    VectorDataType rhs( (Variant(1.0)) );
+    for ( int i = 0; i < 1000; ++i )
+    {
+        lhs.push_back( i * 0.5 );
+        rhs.push_back( i * 0.5 );
+    }
+    ASSERT_EQ( lhs, rhs );
+    ASSERT_EQ( lhs.getContentHash(), rhs.getContentHash() );
+
+    rhs.set( 999, -1.0 );
+    ASSERT_NE( lhs, rhs );
+    ASSERT_NE( lhs.getContentHash(), rhs.getContentHash() );
+
+    rhs.set( 999, lhs.get<double>( 999 ) );
+    rhs.push_back( 0.0 );
+    ASSERT_NE( lhs, rhs );
+}
+
+TEST( test_sequencer_type_VectorDataType, ContentHash )
+{
+    VectorDataType ints( (Variant(int32_t(0))) );
+    VectorDataType uints( (Variant(uint32_t(0))) );
+    VectorDataType strings( (Variant(std::string())) );
+    VectorDataType otherStrings( (Variant(std::string())) );
+    ASSERT_NE( ints.getContentHash(), uints.getContentHash() );
+
+    ints.push_back( int32_t(1) );
+    uints.push_back( uint32_t(1) );
+    ASSERT_NE( ints.getContentHash(), uints.getContentHash() );
+
+    // The string boundaries are part of the hash
+    strings.push_back( std::string("ab") );
+    strings.push_back( std::string("c") );
+    otherStrings.push_back( std::string("a") );
+    otherStrings.push_back( std::string("bc") );
+    ASSERT_NE( strings.getContentHash(), otherStrings.getContentHash() );
+
+    // The hash is independent of how the vector was created
+    DataStream stream( std::make_unique<VectorStream>() );
+    strings.serialize( stream );
+    ASSERT_EQ( strings.getContentHash(), VectorDataType( stream ).getContentHash() );
+}
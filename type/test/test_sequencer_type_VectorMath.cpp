@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <workflow/type/VectorDataType.hpp>
+#include <workflow/type/VectorMath.hpp>
+
+using namespace workflow::type;
+
+namespace {
+
+const math::SimdLevel LEVELS[] = { math::SimdLevel::Scalar, math::SimdLevel::Avx2, math::SimdLevel::Avx512 };
+
+template<typename T>
+std::vector<T>
+makeValues( size_t size )
+{
+    std::vector<T> ret;
+    for ( size_t i = 0; i < size; ++i )
+    {
+        ret.push_back( static_cast<T>( ( i * 37 ) % 101 ) - static_cast<T>( 50 ) );
+    }
+    return ret;
+}
+
+template<typename T>
+void
+testKernels()
+{
+    // Sizes below, at and above the register widths, with tails
+    for ( size_t size: { 1u, 7u, 64u, 131u } )
+    {
+        const auto values = makeValues<T>( size );
+        workflow::utils::Span<const T> span( values.data(), values.size() );
+
+        math::SumType<T> expectedSum = 0;
+        math::SumType<T> expectedDot = 0;
+        T expectedMin = values[0];
+        T expectedMax = values[0];
+        for ( auto value: values )
+        {
+            expectedSum += value;
+            expectedDot += static_cast<math::SumType<T>>( value ) * value;
+            expectedMin = std::min( expectedMin, value );
+            expectedMax = std::max( expectedMax, value );
+        }
+
+        for ( auto level: LEVELS )
+        {
+            math::setSimdLevel( level );
+            ASSERT_EQ( expectedSum, math::sum<T>( span ) );
+            ASSERT_EQ( expectedDot, math::dot<T>( span, span ) );
+            ASSERT_EQ( std::make_pair( expectedMin, expectedMax ), math::minMax<T>( span ) );
+
+            auto other = values;
+            ASSERT_TRUE( math::equal<T>( span, { other.data(), other.size() } ) );
+            other.back() = T(99);
+            ASSERT_FALSE( math::equal<T>( span, { other.data(), other.size() } ) );
+
+            auto scaled = values;
+            math::scaleOffset<T>( { scaled.data(), scaled.size() }, T(2), T(1) );
+            auto clamped = values;
+            math::clamp<T>( { clamped.data(), clamped.size() }, T(10), T(40) );
+            const auto mask = math::compare<T>( span, math::Compare::Greater, T(5) );
+            ASSERT_EQ( ( size + 63 ) / 64, mask.size() );
+            for ( size_t i = 0; i < size; ++i )
+            {
+                ASSERT_EQ( static_cast<T>( values[i] * T(2) + T(1) ), scaled[i] );
+                ASSERT_EQ( std::clamp( values[i], T(10), T(40) ), clamped[i] );
+                ASSERT_EQ( values[i] > T(5), 0 != ( mask[i / 64] & ( uint64_t(1) << ( i % 64 ) ) ) );
+            }
+        }
+    }
+    math::setSimdLevel( math::getSupportedSimdLevel() );
+}
+
+}// end namespace
+
+TEST( test_sequencer_type_VectorMath, Kernels )
+{
+    testKernels<int8_t>();
+    testKernels<uint16_t>();
+    testKernels<int32_t>();
+    testKernels<uint64_t>();
+    testKernels<float>();
+    testKernels<double>();
+}
+
+TEST( test_sequencer_type_VectorMath, SimdLevel )
+{
+    math::setSimdLevel( math::SimdLevel::Avx512 );
+    ASSERT_EQ( math::getSupportedSimdLevel(), math::getSimdLevel() );
+    math::setSimdLevel( math::SimdLevel::Scalar );
+    ASSERT_EQ( math::SimdLevel::Scalar, math::getSimdLevel() );
+    math::setSimdLevel( math::getSupportedSimdLevel() );
+}
+
+TEST( test_sequencer_type_VectorMath, VectorDataType )
+{
+    VectorDataType vector( (Variant(int16_t(0))) );
+    for ( int16_t value: { 3, -1, 4, 1, -5 } )
+    {
+        vector.push_back( value );
+    }
+
+    ASSERT_EQ( Variant(int64_t(2)), math::sum( vector ) );
+    ASSERT_DOUBLE_EQ( 0.4, math::mean( vector ) );
+    ASSERT_EQ( std::make_pair( Variant(int16_t(-5)), Variant(int16_t(4)) ), math::minMax( vector ) );
+    ASSERT_EQ( Variant(int64_t(52)), math::dot( vector, vector ) );
+    ASSERT_EQ( std::vector<uint64_t>{ 0b00101 }, math::compare( vector, math::Compare::Greater, Variant(int16_t(2)) ) );
+
+    math::clamp( vector, Variant(int16_t(-2)), Variant(int16_t(2)) );
+    math::scaleOffset( vector, Variant(int16_t(10)), Variant(int16_t(1)) );
+    ASSERT_EQ( (std::vector<int16_t>{ 21, -9, 21, 11, -19 }),
+               std::vector<int16_t>( vector.begin<int16_t>(), vector.end<int16_t>() ) );
+
+    // The arguments must be of the element type
+    ASSERT_THROW( math::clamp( vector, Variant(0), Variant(1) ), workflow::utils::Error );
+    ASSERT_THROW( math::mean( VectorDataType( (Variant(1.0)) ) ), workflow::utils::Error );
+    ASSERT_THROW( math::sum( VectorDataType( (Variant(std::string())) ) ), workflow::utils::Error );
+}
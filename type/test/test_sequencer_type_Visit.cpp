@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include <workflow/type/Visit.hpp>
+
+#include "DataTypeBuilders.h"
+
+using namespace workflow::type;
+using workflow::utils::Overloaded;
+
+namespace {
+
+StructDataType
+makeRecord()
+{
+    return StructDataType( "Record", StructDataType::NamedTypes
+    {
+        { "id", makeVariant( int64_t(42) ) },
+        { "numbers", makeVector<int32_t>( { 1, 2 } ) },
+        { "position", std::make_shared<StructDataType>( "Position", StructDataType::NamedTypes
+            {
+                { "x", makeVariant( 1.0 ) },
+                { "y", makeVariant( 2.0 ) }
+            }) }
+    } );
+}
+
+}// end namespace
+
+TEST( test_sequencer_type_Visit, Visit )
+{
+    auto record = makeRecord();
+    const IDataType& node = record;
+
+    auto size = []( const IDataType& type )
+    {
+        return visit( type, Overloaded{
+            []( const StructDataType& type ){ return type.getAttributeNames().size(); },
+            []( const VectorDataType& type ){ return type.size(); },
+            []( const VariantDataType& ){ return size_t(1); } } );
+    };
+    ASSERT_EQ( 3u, size( node ) );
+    ASSERT_EQ( 2u, size( record.get( "numbers" ) ) );
+    ASSERT_EQ( 1u, size( record.get( "id" ) ) );
+
+    // Mutable data types are passed as mutable references
+    visit( record.get( "id" ), Overloaded{
+        []( VariantDataType& type ){ type.set( Variant(int64_t(7)) ); },
+        []( auto& ){ FAIL(); } } );
+    ASSERT_EQ( Variant(int64_t(7)), static_cast<const VariantDataType&>( record.get( "id" ) ).get() );
+}
+
+TEST( test_sequencer_type_Visit, Walk )
+{
+    const auto record = makeRecord();
+
+    std::vector<std::string> names;
+    walk( static_cast<const IDataType&>( record ), [&names]( const auto& type )
+    {
+        names.push_back( type.getName() );
+    } );
+    ASSERT_EQ( 6u, names.size() );
+    ASSERT_EQ( "Record", names[0] );
+    ASSERT_EQ( "Position", names[3] );
+
+    // Returning false skips the attributes
+    size_t count = 0;
+    walk( static_cast<const IDataType&>( record ), Overloaded{
+        [&count]( const StructDataType& type ){ ++count; return type.getName() != "Position"; },
+        [&count]( const auto& ){ ++count; return true; } } );
+    ASSERT_EQ( 4u, count );
+}
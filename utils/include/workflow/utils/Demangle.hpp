@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <typeindex>
 
 namespace workflow::utils {
 
@@ -14,4 +15,31 @@ namespace workflow::utils {
 std::string
 demangle( const std::string& name );
 
-} // end namespace workflow::utils
\ No newline at end of file
+/**
+ * Demangle the name of a type. The result is cached, so each type is only
+ * demangled once. Thread safe.
+ *
+ * @param [in]  type        The type
+ *
+ * @return Reference to the cached demangled name. Valid until the program ends.
+ */
+const std::string&
+demangle( const std::type_index& type );
+
+/**
+ * Get the demangled name of T. Resolved once per type, afterwards no lookup
+ * is required.
+ *
+ * @tparam T    The type
+ *
+ * @return Reference to the demangled name
+ */
+template<typename T>
+const std::string&
+typeName()
+{
+    static const std::string& name = demangle( std::type_index(typeid(T)) );
+    return name;
+}
+
+} // end namespace workflow::utils
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <string>
 #include <sstream>
 #include <stdexcept>
@@ -93,11 +94,30 @@ public:
     getErrorCode() const;
 
     /**
-     * Get stack trace
+     * Get stack trace. Only the raw frame addresses are captured on
+     * construction, symbol resolution is done here on each call.
+     *
+     * @return The formatted stack trace, empty if capturing was disabled
      */
     std::string
     getStackTrace() const;
 
+    /**
+     * Enable or disable stack trace capturing for all errors created from now
+     * on. Disabling it makes throwing cheap on high rate rejection paths.
+     * Enabled by default.
+     *
+     * @param [in]  enabled     True to capture stack traces, else false
+     */
+    static void
+    setStackTraceEnabled( bool enabled ) noexcept;
+
+    /**
+     * Test if stack traces are captured on construction
+     */
+    static bool
+    isStackTraceEnabled() noexcept;
+
     /**
      * Write error to output stream
      *
@@ -111,12 +131,16 @@ public:
                 const Error& error );
 
 private:
+    // Maximum number of captured frames, plus one for the terminating null frame
+    static constexpr std::size_t MAX_FRAMES = 20 + 1;
+
     std::string mFile;
     int         mLine;
     std::string mFunction;
     std::string mMessage;
     ErrorCode   mErrorCode;
-    std::string mStackTrace;
+    std::array<const void*, MAX_FRAMES> mFrames;
+    std::size_t mNumFrames;
 };
 
 } // end namespace workflow::utils
\ No newline at end of file
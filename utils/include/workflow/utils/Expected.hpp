@@ -0,0 +1,154 @@
+#pragma once
+
+#include <utility>
+#include <variant>
+
+#include <workflow/utils/Error.hpp>
+
+namespace workflow::utils {
+
+/**
+ * Wrapper to explicitly construct an Expected holding an error
+ *
+ * @tparam E        The error type
+ */
+template<typename E>
+struct Unexpected
+{
+    E value;
+};
+
+/**
+ * Create an Unexpected from an error value
+ *
+ * @tparam E            The error type
+ * @param [in]  error   The error
+ *
+ * @return The wrapped error
+ */
+template<typename E>
+Unexpected<E>
+makeUnexpected( E error )
+{
+    return Unexpected<E>{ std::move(error) };
+}
+
+/**
+ * Holds either a value or an error. Used by APIs that must report failures
+ * without throwing, e.g. when processing untrusted input at a high rate.
+ *
+ * @tparam T        The value type
+ * @tparam E        The error type
+ */
+template<typename T, typename E>
+class Expected
+{
+public:
+    /**
+     * Create from value
+     *
+     * @param [in]  value       The value
+     */
+    Expected( T value )
+        : mStorage( std::in_place_index<0>, std::move(value) )
+    {
+    }
+
+    /**
+     * Create from error
+     *
+     * @param [in]  error       The error
+     */
+    template<typename U>
+    Expected( Unexpected<U> error )
+        : mStorage( std::in_place_index<1>, std::move(error.value) )
+    {
+    }
+
+    /**
+     * Test if a value is available
+     */
+    bool
+    hasValue() const noexcept
+    {
+        return 0 == mStorage.index();
+    }
+
+    /**
+     * Test if a value is available
+     */
+    explicit
+    operator bool() const noexcept
+    {
+        return hasValue();
+    }
+
+    /**
+     * Get the value. Must not be called if an error is stored.
+     */
+    T&
+    value() &
+    {
+        SEQ_ASSERT_INVARIANT( hasValue(), "Expected does not hold a value" );
+        return *std::get_if<0>( &mStorage );
+    }
+
+    /**
+     * Get the value. Must not be called if an error is stored.
+     */
+    const T&
+    value() const &
+    {
+        SEQ_ASSERT_INVARIANT( hasValue(), "Expected does not hold a value" );
+        return *std::get_if<0>( &mStorage );
+    }
+
+    /**
+     * Take the value. Must not be called if an error is stored.
+     */
+    T&&
+    value() &&
+    {
+        SEQ_ASSERT_INVARIANT( hasValue(), "Expected does not hold a value" );
+        return std::move( *std::get_if<0>( &mStorage ) );
+    }
+
+    /**
+     * Get the error. Must not be called if a value is stored.
+     */
+    const E&
+    error() const
+    {
+        SEQ_ASSERT_INVARIANT( !hasValue(), "Expected does not hold an error" );
+        return *std::get_if<1>( &mStorage );
+    }
+
+    T&
+    operator*() &
+    {
+        return value();
+    }
+
+    const T&
+    operator*() const &
+    {
+        return value();
+    }
+
+    T*
+    operator->()
+    {
+        return &value();
+    }
+
+    const T*
+    operator->() const
+    {
+        return &value();
+    }
+
+private:
+    std::variant<T, E> mStorage;
+};
+
+} // end namespace workflow::utils
@@ -0,0 +1,252 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace workflow::utils {
+
+/**
+ * Streaming 64 bit hash of byte sequences (XXH64). Fast, but not
+ * cryptographic. Feeding data in one or in several pieces gives the same
+ * result. Results are stable across runs on hosts of the same byte order.
+ */
+class Hasher
+{
+public:
+    /**
+     * Create hasher
+     *
+     * @param [in]  seed        The seed
+     */
+    explicit
+    Hasher( uint64_t seed = 0 ) noexcept;
+
+    /**
+     * Feed bytes
+     *
+     * @param [in]  data        The data
+     * @param [in]  len         Number of bytes
+     */
+    void
+    update( const void* data,
+            size_t len ) noexcept;
+
+    /**
+     * Feed the object representation of a trivially copyable value
+     *
+     * @param [in]  value       The value
+     */
+    template<typename T>
+    void
+    update( const T& value ) noexcept;
+
+    /**
+     * Get the hash of all bytes fed so far. Does not modify the state, so
+     * feeding can continue afterwards.
+     */
+    uint64_t
+    digest() const noexcept;
+
+private:
+    static constexpr size_t STRIPE_SIZE = 32;
+
+    std::array<uint64_t, 4>             mAcc;
+    std::array<uint8_t, STRIPE_SIZE>    mBuffer;
+    size_t                              mBufferSize = 0;
+    uint64_t                            mTotalSize = 0;
+    uint64_t                            mSeed;
+};
+
+/**
+ * Hash a byte sequence
+ *
+ * @param [in]  data        The data
+ * @param [in]  len         Number of bytes
+ * @param [in]  seed        The seed
+ */
+uint64_t
+hashBytes( const void* data,
+           size_t len,
+           uint64_t seed = 0 ) noexcept;
+
+/**
+ * A lazily computed hash, cached until reset. Thread safe, concurrent first
+ * calls may compute the hash more than once. The value 0 marks the hash as
+ * not computed, a computed 0 is stored as 1.
+ */
+class HashCache
+{
+public:
+    HashCache() noexcept = default;
+
+    /**
+     * Get the hash, computing it on first use
+     *
+     * @param [in]  compute     Callable returning the hash
+     */
+    template<typename F>
+    uint64_t
+    get( F&& compute ) const;
+
+    /**
+     * Get the hash if already computed
+     *
+     * @return The hash or 0 if not computed
+     */
+    uint64_t
+    peek() const noexcept;
+
+    /**
+     * Discard the hash, e.g. after the hashed data changed. Discarding a
+     * computed hash invalidates all derived hashes.
+     */
+    void
+    reset() noexcept;
+
+    /**
+     * Get the generation of the hashes, it changes whenever a computed hash
+     * is discarded
+     */
+    static uint64_t
+    getGeneration() noexcept;
+
+private:
+    friend class DerivedHashCache;
+
+    /**
+     * Start a new generation. Out of line to keep reset small.
+     */
+    static void
+    nextGeneration() noexcept;
+
+    static std::atomic<uint64_t> sGeneration;
+
+    mutable std::atomic<uint64_t> mValue{ 0 };
+};
+
+/**
+ * A lazily computed hash derived from other cached hashes, e.g. the hash of a
+ * tree node combining the hashes of its children. It is valid as long as no
+ * computed hash was discarded since, so a change below a shared child is
+ * noticed by every parent. Thread safe like HashCache.
+ */
+class DerivedHashCache
+{
+public:
+    DerivedHashCache() noexcept = default;
+
+    /**
+     * Get the hash, computing it on first use or if it may be stale
+     *
+     * @param [in]  compute     Callable returning the hash
+     */
+    template<typename F>
+    uint64_t
+    get( F&& compute ) const;
+
+    /**
+     * Get the hash if computed and still valid
+     *
+     * @return The hash or 0 if not computed or possibly stale
+     */
+    uint64_t
+    peek() const noexcept;
+
+    /**
+     * Discard the hash, e.g. after the hashed data changed. Discarding a
+     * computed hash invalidates all derived hashes.
+     */
+    void
+    reset() noexcept;
+
+private:
+    mutable std::atomic<uint64_t> mValue{ 0 };
+    mutable std::atomic<uint64_t> mGeneration{ 0 };
+};
+
+/******************************************************************************
+ * Inlined implementations
+ *****************************************************************************/
+template<typename T>
+inline void
+Hasher::update( const T& value ) noexcept
+{
+    static_assert( std::is_trivially_copyable_v<T>, "Only trivially copyable types can be fed" );
+    update( &value, sizeof(T) );
+}
+
+template<typename F>
+inline uint64_t
+HashCache::get( F&& compute ) const
+{
+    uint64_t value = mValue.load( std::memory_order_relaxed );
+    if ( !value )
+    {
+        value = compute();
+        value = value ? value : 1;
+        mValue.store( value, std::memory_order_relaxed );
+    }
+    return value;
+}
+
+inline uint64_t
+HashCache::peek() const noexcept
+{
+    return mValue.load( std::memory_order_relaxed );
+}
+
+inline void
+HashCache::reset() noexcept
+{
+    // Only a computed hash can have been derived from
+    if ( mValue.load( std::memory_order_relaxed ) )
+    {
+        mValue.store( 0, std::memory_order_relaxed );
+        nextGeneration();
+    }
+}
+
+inline uint64_t
+HashCache::getGeneration() noexcept
+{
+    return sGeneration.load( std::memory_order_acquire );
+}
+
+template<typename F>
+inline uint64_t
+DerivedHashCache::get( F&& compute ) const
+{
+    uint64_t value = peek();
+    if ( !value )
+    {
+        // Read before computing, a change meanwhile makes the result stale
+        const auto generation = HashCache::getGeneration();
+        value = compute();
+        value = value ? value : 1;
+        mValue.store( value, std::memory_order_relaxed );
+        mGeneration.store( generation, std::memory_order_release );
+    }
+    return value;
+}
+
+inline uint64_t
+DerivedHashCache::peek() const noexcept
+{
+    const uint64_t value = mValue.load( std::memory_order_relaxed );
+    return mGeneration.load( std::memory_order_acquire ) == HashCache::getGeneration() ? value : 0;
+}
+
+inline void
+DerivedHashCache::reset() noexcept
+{
+    if ( mValue.load( std::memory_order_relaxed ) )
+    {
+        mValue.store( 0, std::memory_order_relaxed );
+        HashCache::nextGeneration();
+    }
+}
+
+} // end namespace workflow::utils
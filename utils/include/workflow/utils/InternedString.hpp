@@ -0,0 +1,239 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace workflow::utils {
+
+/**
+ * Handle to a string stored once in a global, thread safe table. Interned
+ * strings are compared by pointer and copied without allocation. The stored
+ * strings are reference counted, the ones no longer referenced are swept from
+ * the table whenever it doubled in size. Strings decoded from untrusted input
+ * therefore do not accumulate.
+ */
+class InternedString
+{
+public:
+    /**
+     * Create the empty string. Does not access the table.
+     */
+    InternedString() noexcept;
+
+    /**
+     * Intern a string. Allocates only the first time a string is seen.
+     *
+     * @param [in]  value       The string
+     */
+    explicit
+    InternedString( std::string_view value );
+
+    InternedString( const InternedString& other ) noexcept;
+
+    InternedString( InternedString&& other ) noexcept;
+
+    ~InternedString();
+
+    InternedString&
+    operator=( const InternedString& other ) noexcept;
+
+    InternedString&
+    operator=( InternedString&& other ) noexcept;
+
+    /**
+     * Get the number of strings in the table, including the ones not yet
+     * swept. For diagnostics.
+     */
+    static size_t
+    getTableSize();
+
+    /**
+     * Get the string
+     */
+    const std::string&
+    str() const noexcept;
+
+    /**
+     * Get the string as view
+     */
+    std::string_view
+    view() const noexcept;
+
+    /**
+     * Test if the string is empty
+     */
+    bool
+    empty() const noexcept;
+
+    /**
+     * Compare by identity, which is equal to comparing the content
+     */
+    friend bool
+    operator==( const InternedString& lhs,
+                const InternedString& rhs ) noexcept;
+
+    friend bool
+    operator!=( const InternedString& lhs,
+                const InternedString& rhs ) noexcept;
+
+    /**
+     * Lexicographical order of the content
+     */
+    friend bool
+    operator<( const InternedString& lhs,
+               const InternedString& rhs ) noexcept;
+
+    friend std::ostream&
+    operator<<( std::ostream& os,
+                const InternedString& value );
+
+private:
+    /**
+     * A stored string and the number of handles to it
+     */
+    struct Entry
+    {
+        std::string             value;
+        std::atomic<size_t>     references{ 0 };
+        bool                    counted = true;
+    };
+
+    friend class InternTable;
+
+    /**
+     * Get the entry of the empty string, which is not counted
+     */
+    static Entry*
+    emptyEntry() noexcept;
+
+    /**
+     * Add a reference
+     */
+    void
+    acquire() const noexcept;
+
+    /**
+     * Drop a reference. The table sweeps unreferenced strings itself.
+     */
+    void
+    release() const noexcept;
+
+    Entry* mEntry;
+};
+
+/******************************************************************************
+ * Inlined implementations
+ *****************************************************************************/
+inline
+InternedString::InternedString( const InternedString& other ) noexcept
+    : mEntry( other.mEntry )
+{
+    acquire();
+}
+
+inline
+InternedString::InternedString( InternedString&& other ) noexcept
+    : mEntry( other.mEntry )
+{
+    other.mEntry = emptyEntry();
+}
+
+inline
+InternedString::~InternedString()
+{
+    release();
+}
+
+inline InternedString&
+InternedString::operator=( const InternedString& other ) noexcept
+{
+    other.acquire();
+    release();
+    mEntry = other.mEntry;
+    return *this;
+}
+
+inline InternedString&
+InternedString::operator=( InternedString&& other ) noexcept
+{
+    // The previous string is released by the other handle
+    std::swap( mEntry, other.mEntry );
+    return *this;
+}
+
+inline void
+InternedString::acquire() const noexcept
+{
+    if ( mEntry->counted )
+    {
+        mEntry->references.fetch_add( 1, std::memory_order_relaxed );
+    }
+}
+
+inline void
+InternedString::release() const noexcept
+{
+    if ( mEntry->counted )
+    {
+        mEntry->references.fetch_sub( 1, std::memory_order_release );
+    }
+}
+
+inline const std::string&
+InternedString::str() const noexcept
+{
+    return mEntry->value;
+}
+
+inline std::string_view
+InternedString::view() const noexcept
+{
+    return mEntry->value;
+}
+
+inline bool
+InternedString::empty() const noexcept
+{
+    return mEntry->value.empty();
+}
+
+inline bool
+operator==( const InternedString& lhs,
+            const InternedString& rhs ) noexcept
+{
+    return lhs.mEntry == rhs.mEntry;
+}
+
+inline bool
+operator!=( const InternedString& lhs,
+            const InternedString& rhs ) noexcept
+{
+    return lhs.mEntry != rhs.mEntry;
+}
+
+inline bool
+operator<( const InternedString& lhs,
+           const InternedString& rhs ) noexcept
+{
+    return lhs.mEntry != rhs.mEntry && lhs.mEntry->value < rhs.mEntry->value;
+}
+
+} // end namespace workflow::utils
+
+namespace std {
+
+template<>
+struct hash<workflow::utils::InternedString>
+{
+    size_t
+    operator()( const workflow::utils::InternedString& value ) const noexcept
+    {
+        return std::hash<const void*>()( &value.str() );
+    }
+};
+
+} // end namespace std
@@ -16,3 +16,15 @@
     using classname ## SharedPtr = std::shared_ptr<classname>; \
     using classname ## UniquePtr = std::unique_ptr<classname>; \
     using classname ## WeakPtr = std::weak_ptr<classname>
+
+/**
+ * Hot paths defined in headers. The static libraries, built and used with
+ * WORKFLOW_STATIC, inline them into callers. The shared libraries define
+ * them out of line in their own source file, so the symbols stay exported
+ * and plugins do not compile the class layouts in.
+ */
+#ifdef WORKFLOW_STATIC
+#define SEQ_HOT_PATH inline
+#else
+#define SEQ_HOT_PATH
+#endif
@@ -0,0 +1,22 @@
+#pragma once
+
+namespace workflow::utils {
+
+/**
+ * Combine callables into a single overload set, e.g. to pass several lambdas
+ * to a visit function:
+ *
+ *     visit( value, Overloaded{ []( int ){ ... }, []( const auto& ){ ... } } );
+ *
+ * @tparam Fs       The callables
+ */
+template<typename... Fs>
+struct Overloaded : Fs...
+{
+    using Fs::operator()...;
+};
+
+template<typename... Fs>
+Overloaded( Fs... ) -> Overloaded<Fs...>;
+
+} // end namespace workflow::utils
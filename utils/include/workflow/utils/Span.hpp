@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+namespace workflow::utils {
+
+/**
+ * Non owning view to a contiguous sequence of objects. A minimal replacement
+ * for std::span until the code base moves to C++20.
+ *
+ * @tparam T        The element type, const qualified for read only views
+ */
+template<typename T>
+class Span
+{
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using size_type = std::size_t;
+    using pointer = T*;
+    using reference = T&;
+    using iterator = T*;
+
+    /**
+     * Create an empty span
+     */
+    constexpr
+    Span() noexcept = default;
+
+    /**
+     * Create span
+     *
+     * @param [in]  data        Pointer to the first element
+     * @param [in]  size        Number of elements
+     */
+    constexpr
+    Span( T* data,
+          size_type size ) noexcept
+        : mData( data )
+        , mSize( size )
+    {
+    }
+
+    /**
+     * Create read only span from a mutable one
+     *
+     * @param [in]  other       The mutable span
+     */
+    template<typename U,
+             typename = std::enable_if_t<std::is_same_v<const U, T>>>
+    constexpr
+    Span( const Span<U>& other ) noexcept
+        : mData( other.data() )
+        , mSize( other.size() )
+    {
+    }
+
+    constexpr pointer
+    data() const noexcept
+    {
+        return mData;
+    }
+
+    constexpr size_type
+    size() const noexcept
+    {
+        return mSize;
+    }
+
+    constexpr bool
+    empty() const noexcept
+    {
+        return 0 == mSize;
+    }
+
+    constexpr reference
+    operator[]( size_type index ) const noexcept
+    {
+        return mData[index];
+    }
+
+    constexpr iterator
+    begin() const noexcept
+    {
+        return mData;
+    }
+
+    constexpr iterator
+    end() const noexcept
+    {
+        return mData + mSize;
+    }
+
+private:
+    T*          mData = nullptr;
+    size_type   mSize = 0;
+};
+
+} // end namespace workflow::utils
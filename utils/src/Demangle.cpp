@@ -1,8 +1,44 @@
 #include <workflow/utils/Demangle.hpp>
 
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
 #include <boost/core/demangle.hpp>
 
 namespace workflow::utils {
+namespace {
+
+/**
+ * Read mostly cache of demangled type names. References to the names stay
+ * valid, as elements of an unordered_map are never moved.
+ */
+class DemangleCache
+{
+public:
+    const std::string&
+    get( const std::type_index& type )
+    {
+        {
+            std::shared_lock<std::shared_mutex> lock( mMutex );
+            auto it = mNames.find( type );
+            if ( mNames.end() != it )
+            {
+                return it->second;
+            }
+        }
+
+        auto name = boost::core::demangle( type.name() );
+        std::unique_lock<std::shared_mutex> lock( mMutex );
+        return mNames.emplace( type, std::move(name) ).first->second;
+    }
+
+private:
+    std::shared_mutex                               mMutex;
+    std::unordered_map<std::type_index, std::string> mNames;
+};
+
+} // end namespace
 
 std::string
 demangle( const std::string& name )
@@ -10,4 +46,11 @@ demangle( const std::string& name )
     return boost::core::demangle( name.c_str() );
 }
 
-} // end namespace workflow::utils
\ No newline at end of file
+const std::string&
+demangle( const std::type_index& type )
+{
+    static DemangleCache cache;
+    return cache.get( type );
+}
+
+} // end namespace workflow::utils
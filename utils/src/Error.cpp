@@ -1,8 +1,15 @@
 #include <workflow/utils/Error.hpp>
 
+#include <atomic>
+
 #include <boost/stacktrace.hpp>
 
 namespace workflow::utils {
+namespace {
+
+std::atomic<bool> gStackTraceEnabled{ true };
+
+} // end namespace
 
 Error::Error( const char* file,
               int line,
@@ -14,13 +21,18 @@ Error::Error( const char* file,
     , mFunction( function )
     , mMessage( message )
     , mErrorCode( errorCode )
+    , mFrames{}
+    , mNumFrames( 0 )
 {
     SEQ_ASSERT_ARGUMENT( !mFile.empty(), "Invalid file" );
 
-    auto stacktrace = boost::stacktrace::stacktrace( 1, 20 );
-    std::stringstream ss;
-    ss << stacktrace;
-    mStackTrace = ss.str();
+    // Only collect the frame addresses here. Resolving symbols is by far the
+    // most expensive part, so it is deferred to getStackTrace()
+    if ( gStackTraceEnabled.load( std::memory_order_relaxed ) )
+    {
+        mNumFrames = boost::stacktrace::safe_dump_to( 1, mFrames.data(),
+                                                      sizeof(mFrames) );
+    }
 }
 
 std::string
@@ -56,7 +68,28 @@ Error::getErrorCode() const
 std::string
 Error::getStackTrace() const
 {
-    return mStackTrace;
+    if ( 0 == mNumFrames )
+    {
+        return std::string();
+    }
+
+    auto stacktrace = boost::stacktrace::stacktrace::from_dump(
+            mFrames.data(), mNumFrames * sizeof(mFrames[0]) );
+    std::stringstream ss;
+    ss << stacktrace;
+    return ss.str();
+}
+
+void
+Error::setStackTraceEnabled( bool enabled ) noexcept
+{
+    gStackTraceEnabled.store( enabled, std::memory_order_relaxed );
+}
+
+bool
+Error::isStackTraceEnabled() noexcept
+{
+    return gStackTraceEnabled.load( std::memory_order_relaxed );
 }
 
 std::ostream&
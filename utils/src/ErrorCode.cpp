@@ -2,7 +2,7 @@
 
 #include <iostream>
 
-#include <boost/core/demangle.hpp>
+#include <workflow/utils/Demangle.hpp>
 
 namespace workflow::utils {
 
@@ -22,7 +22,7 @@ std::ostream&
 operator<<( std::ostream& os,
             const ErrorCode& code )
 {
-    os << boost::core::demangle(code.mTypeIndex.name()) << "(" << code.mValue << ")";
+    os << demangle(code.mTypeIndex) << "(" << code.mValue << ")";
     return os;
 }
 
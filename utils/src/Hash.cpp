@@ -0,0 +1,182 @@
+#include <workflow/utils/Hash.hpp>
+
+#include <cstring>
+
+namespace workflow::utils {
+namespace {
+
+constexpr uint64_t PRIME1 = 11400714785074694791ULL;
+constexpr uint64_t PRIME2 = 14029467366897019727ULL;
+constexpr uint64_t PRIME3 = 1609587929392839161ULL;
+constexpr uint64_t PRIME4 = 9650029242287828579ULL;
+constexpr uint64_t PRIME5 = 2870177450012600261ULL;
+
+inline uint64_t
+rotl( uint64_t value,
+      int bits )
+{
+    return ( value << bits ) | ( value >> ( 64 - bits ) );
+}
+
+inline uint64_t
+read64( const uint8_t* data )
+{
+    uint64_t ret;
+    std::memcpy( &ret, data, sizeof(ret) );
+    return ret;
+}
+
+inline uint32_t
+read32( const uint8_t* data )
+{
+    uint32_t ret;
+    std::memcpy( &ret, data, sizeof(ret) );
+    return ret;
+}
+
+inline uint64_t
+round( uint64_t acc,
+       uint64_t input )
+{
+    acc += input * PRIME2;
+    acc = rotl( acc, 31 );
+    return acc * PRIME1;
+}
+
+inline uint64_t
+mergeRound( uint64_t acc,
+            uint64_t value )
+{
+    acc ^= round( 0, value );
+    return acc * PRIME1 + PRIME4;
+}
+
+inline void
+consumeStripe( std::array<uint64_t, 4>& acc,
+               const uint8_t* data )
+{
+    acc[0] = round( acc[0], read64( data ) );
+    acc[1] = round( acc[1], read64( data + 8 ) );
+    acc[2] = round( acc[2], read64( data + 16 ) );
+    acc[3] = round( acc[3], read64( data + 24 ) );
+}
+
+} // end namespace
+
+/*****************************************************************************/
+Hasher::Hasher( uint64_t seed ) noexcept
+    : mAcc{ seed + PRIME1 + PRIME2, seed + PRIME2, seed, seed - PRIME1 }
+    , mBuffer{}
+    , mSeed( seed )
+{
+}
+
+void
+Hasher::update( const void* data,
+                size_t len ) noexcept
+{
+    const auto* bytes = static_cast<const uint8_t*>( data );
+    mTotalSize += len;
+
+    if ( mBufferSize + len < STRIPE_SIZE )
+    {
+        if ( len )
+        {
+            std::memcpy( mBuffer.data() + mBufferSize, bytes, len );
+        }
+        mBufferSize += len;
+        return;
+    }
+
+    if ( mBufferSize )
+    {
+        const size_t fill = STRIPE_SIZE - mBufferSize;
+        std::memcpy( mBuffer.data() + mBufferSize, bytes, fill );
+        consumeStripe( mAcc, mBuffer.data() );
+        bytes += fill;
+        len -= fill;
+        mBufferSize = 0;
+    }
+
+    // Keep the accumulators in registers for the bulk of the data
+    auto acc = mAcc;
+    for ( ; len >= STRIPE_SIZE; bytes += STRIPE_SIZE, len -= STRIPE_SIZE )
+    {
+        consumeStripe( acc, bytes );
+    }
+    mAcc = acc;
+
+    if ( len )
+    {
+        std::memcpy( mBuffer.data(), bytes, len );
+        mBufferSize = len;
+    }
+}
+
+uint64_t
+Hasher::digest() const noexcept
+{
+    uint64_t hash;
+    if ( mTotalSize >= STRIPE_SIZE )
+    {
+        hash = rotl( mAcc[0], 1 ) + rotl( mAcc[1], 7 ) + rotl( mAcc[2], 12 ) + rotl( mAcc[3], 18 );
+        for ( auto acc: mAcc )
+        {
+            hash = mergeRound( hash, acc );
+        }
+    }
+    else
+    {
+        hash = mSeed + PRIME5;
+    }
+    hash += mTotalSize;
+
+    const uint8_t* data = mBuffer.data();
+    size_t len = mBufferSize;
+    for ( ; len >= 8; data += 8, len -= 8 )
+    {
+        hash ^= round( 0, read64( data ) );
+        hash = rotl( hash, 27 ) * PRIME1 + PRIME4;
+    }
+    if ( len >= 4 )
+    {
+        hash ^= static_cast<uint64_t>( read32( data ) ) * PRIME1;
+        hash = rotl( hash, 23 ) * PRIME2 + PRIME3;
+        data += 4;
+        len -= 4;
+    }
+    for ( ; len > 0; ++data, --len )
+    {
+        hash ^= *data * PRIME5;
+        hash = rotl( hash, 11 ) * PRIME1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= PRIME2;
+    hash ^= hash >> 29;
+    hash *= PRIME3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+/*****************************************************************************/
+uint64_t
+hashBytes( const void* data,
+           size_t len,
+           uint64_t seed ) noexcept
+{
+    Hasher hasher( seed );
+    hasher.update( data, len );
+    return hasher.digest();
+}
+
+/*****************************************************************************/
+std::atomic<uint64_t> HashCache::sGeneration{ 0 };
+
+void
+HashCache::nextGeneration() noexcept
+{
+    sGeneration.fetch_add( 1, std::memory_order_acq_rel );
+}
+
+} // end namespace workflow::utils
@@ -0,0 +1,133 @@
+#include <workflow/utils/InternedString.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace workflow::utils {
+namespace {
+
+// Number of strings in the table above which unreferenced ones are swept
+constexpr size_t MIN_SWEEP_SIZE = 1024;
+
+} // end namespace
+
+/**
+ * Read mostly table of the interned strings. The strings are owned through
+ * pointers, so their addresses and the views used as keys stay valid.
+ * Lookups take a shared lock and reference the string found, so a sweep,
+ * which takes the exclusive lock, never erases a string being handed out.
+ */
+class InternTable
+{
+public:
+    static InternTable&
+    instance()
+    {
+        // Never destroyed, interned strings may be used by static destructors
+        static InternTable* table = new InternTable();
+        return *table;
+    }
+
+    InternedString::Entry*
+    intern( std::string_view value )
+    {
+        {
+            std::shared_lock<std::shared_mutex> lock( mMutex );
+            if ( auto* entry = find( value ) )
+            {
+                return entry;
+            }
+        }
+
+        std::unique_lock<std::shared_mutex> lock( mMutex );
+        if ( auto* entry = find( value ) )
+        {
+            return entry;
+        }
+
+        // Unreferenced strings are swept whenever the table doubled in size
+        if ( mStrings.size() >= mSweepSize )
+        {
+            for ( auto it = mStrings.begin(); it != mStrings.end(); )
+            {
+                const bool unused = !it->second->references.load( std::memory_order_acquire );
+                it = unused ? mStrings.erase( it ) : std::next( it );
+            }
+            mSweepSize = std::max( MIN_SWEEP_SIZE, 2 * mStrings.size() );
+        }
+
+        auto entry = std::make_unique<InternedString::Entry>();
+        entry->value = value;
+        entry->references.store( 1, std::memory_order_relaxed );
+        auto* ret = entry.get();
+        mStrings.emplace( ret->value, std::move(entry) );
+        return ret;
+    }
+
+    size_t
+    size()
+    {
+        std::shared_lock<std::shared_mutex> lock( mMutex );
+        return mStrings.size();
+    }
+
+private:
+    /**
+     * Find a string and reference it. Requires a lock.
+     *
+     * @param [in]  value       The string
+     */
+    InternedString::Entry*
+    find( std::string_view value ) const
+    {
+        auto it = mStrings.find( value );
+        if ( mStrings.end() == it )
+        {
+            return nullptr;
+        }
+        it->second->references.fetch_add( 1, std::memory_order_relaxed );
+        return it->second.get();
+    }
+
+    std::shared_mutex                                                               mMutex;
+    std::unordered_map<std::string_view, std::unique_ptr<InternedString::Entry>>    mStrings;
+    size_t                                                                          mSweepSize = MIN_SWEEP_SIZE;
+};
+
+InternedString::InternedString() noexcept
+    : mEntry( emptyEntry() )
+{
+}
+
+InternedString::InternedString( std::string_view value )
+    : mEntry( value.empty() ? emptyEntry() : InternTable::instance().intern( value ) )
+{
+}
+
+size_t
+InternedString::getTableSize()
+{
+    return InternTable::instance().size();
+}
+
+InternedString::Entry*
+InternedString::emptyEntry() noexcept
+{
+    // Function local to be usable during static initialization
+    static Entry empty{ {}, { 0 }, false };
+    return &empty;
+}
+
+std::ostream&
+operator<<( std::ostream& os,
+            const InternedString& value )
+{
+    return os << value.mEntry->value;
+}
+
+} // end namespace workflow::utils